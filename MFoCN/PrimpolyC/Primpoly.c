@@ -43,6 +43,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 
 #include "Primpoly.h"
 
@@ -136,8 +137,6 @@ bigint
     max_num_poly,                  /* p ^ n, the number of polynomials to
                                       test for primitivity.                 */
 
-    num_poly = 0,                  /* Number of polynomials tested so far.  */
-
     r,                             /* The number (p ^ n - 1)/(p - 1).       */
 
     primes[ MAXNUMPRIMEFACTORS ],  /* The distinct prime factors of r.      */
@@ -153,37 +152,37 @@ int
     f[ MAXDEGPOLY + 1 ],           /* Coefficients of the polynomial f(x)  
                                       which we test for primitivity.        */
 
-    a = 0,                         /* Integer in the order r test.          */
-
     is_primitive_poly = NO,        /* Equal to YES as soon as a primitive 
                                       polynomial is found.                  */
 
-    num_free_of_linear_factors = 0,/* The number of polynomials which have  
-                                      no linear factors.                    */
+    stopTesting = NO,              /* When to stop testing polynomials for primitivity. */
+    weight,                        /* Number of non-zero terms of f(x).     */
+    more_of_this_weight ;          /* NO when all of one weight are tried.  */
 
-    num_const_coeff_prim_root = 0, /* Number of polynomials whose constant  
-                                      is a primitive root of p.             */
+SparseTrialPoly
+    sparse ;                       /* Position in the low weight search.    */
 
-    num_passing_const_coeff_test = 0, /* Number of polynomials whose constant
-                                         term passes a consistency check.   */
-    num_irred_to_power = 0,        /* Number of polynomials which are of the
-                                      form irreducible poly to a power >= 1.*/
-    num_order_m = 0,
-    num_order_r = 0,               /* The number of polynomials which pass
-                                      the order_m and order_r tests.                    */
-    stopTesting = NO,              /* When to stop testing polynomials for primitivity. */
-    testPolynomialForPrimitivity = NO, /* Test a given input polnomial for primitivity? */
-    testPolynomial[ MAXDEGPOLY + 1 ],  /* Coefficients of the test polynomial.          */
-    listAllPrimitivePolynomials  = NO, /* Print ALL primitive polynomials?              */
-    printStatistics              = NO, /* Print statistics?                             */
-    printHelp                    = NO, /* Print help information?                       */
-    selfCheck                    = NO, /* Do a self-check?  Time consuming!             */
+bigint
+    num_skipped_by_swan = 0 ;      /* Trinomials known reducible untested.  */
+
+TRACE_DECLARE( trace_start ) ;     /* When the traced step began.           */
+
+SearchStatistics
+    stats ;                        /* How many polynomials passed each test. */
 
-    /*  x ^ n , ... , x ^ 2n-2 (mod f(x), p) */
-    power_table[ MAXDEGPOLY - 1 ] [ MAXDEGPOLY ] ;
+Checkpoint
+    checkpoint ;                   /* Search state saved to or read from a file. */
 
+PrimpolyOptions
+    options ;                      /* Everything on the command line.       */
+
+time_t
+    last_checkpoint_time = 0 ;     /* When we last saved it.                */
+
+FILE
+    * report = stdout ;            /* Where -s prints, away from a listing  */
+                                   /* meant for other programs.             */
 
-char outputFormat[ _MAX_PATH ] ; /* Formatting for printf's (used only when printing bigints) */
 
 char * legalNotice = 
 {
@@ -220,6 +219,124 @@ char * help =
      "       prints search statistics.\n"
      "   pp -a 2 4\n"
      "       lists ALL primitive polynomials of degree 4 modulo 2.\n"
+     "   pp -j 8 2 40\n"
+     "       searches using 8 threads.  Finds the same polynomial as with one.\n"
+     "   pp -a -j 8 2 20\n"
+     "       lists them using 8 threads.  The output is the same as with one.\n"
+     "       -r, -w and -m search on one thread and can't be used with -j.\n"
+     "   pp -r 2 40\n"
+     "   pp -r 1234 2 40\n"
+     "   pp --seed 1234 2 40\n"
+     "       tries random polynomials instead of going in order, which takes\n"
+     "       about the same time no matter which one is found first.  The seed\n"
+     "       is printed;  run again with it to get the same polynomial.  The\n"
+     "       seed goes just before p and n, or after --seed anywhere.\n"
+     "   pp -w 2 40\n"
+     "       finds a primitive polynomial with as few non-zero terms as\n"
+     "       possible:  trinomials first, then the next weight up.  With -a,\n"
+     "       lists all of the lowest weight.  Good for hardware LFSRs.\n"
+     "   pp -a -m 2 20\n"
+     "       lists them by finding one primitive polynomial and computing the\n"
+     "       minimal polynomials of the powers of its root.  Much faster than\n"
+     "       testing every polynomial.  The output is the same as with -a alone.\n"
+     "   pp -a -m --unsorted 2 30\n"
+     "       prints each one as soon as it's found, without saving them up to\n"
+     "       sort.  They come out in no particular order.\n"
+     "   pp -a -i 2 20\n"
+     "       lists them testing only one polynomial of each reciprocal pair,\n"
+     "       since a polynomial is primitive exactly when its reciprocal is.\n"
+     "       The output and statistics are the same as with -a alone.\n"
+     "   pp -a --checkpoint pp.state 2 40 > list.txt\n"
+     "   pp -a --resume pp.state 2 40 >> list.txt\n"
+     "       saves the state of the search to pp.state every minute, and\n"
+     "       carries on from it after an interruption.  Append to the same\n"
+     "       output file with >> when resuming;  the finished file is the same\n"
+     "       as from an uninterrupted run.\n"
+     "   pp -a --shard 1/3 2 40 > s1\n"
+     "   pp -a --shard 2/3 2 40 > s2\n"
+     "   pp -a --shard 3/3 2 40 > s3\n"
+     "   pp -a --merge s1 --merge s2 --merge s3 2 40\n"
+     "       splits the search into three parts which can run at the same time\n"
+     "       on different machines, then puts them together.  The output of the\n"
+     "       merge is the same as from pp -a 2 40.  Works without -a, too.\n"
+     "   pp -a --format hex 2 8\n"
+     "   pp -a --format dense 3 4\n"
+     "   pp -a --format jsonl 3 4\n"
+     "       lists them for other programs to read, one per line, without the\n"
+     "       legal notice:  as bit masks like 0x11D (p = 2 only), as strings of\n"
+     "       coefficients from x ^ n down, or as JSON objects.  The default is\n"
+     "       --format text.  With -s, the statistics go to standard error.\n"
+     "   pp -a --timing text 2 20\n"
+     "   pp -j 4 --timing json 2 40\n"
+     "       times each test of the trial polynomials, and prints how often it\n"
+     "       ran, the total and mean time, and percentiles of the time, as a\n"
+     "       table or one line of JSON with the histogram of times.  Costs a\n"
+     "       little speed, so it is off otherwise.\n"
+     "   pp --counters 2 40\n"
+     "   pp --bench --counters\n"
+     "       with the timing or benchmark, also reads the processor's counters\n"
+     "       of cycles, instructions, L1 data and last level cache misses, and\n"
+     "       branch mispredictions (Linux perf_event_open).  Where they can't\n"
+     "       be read, as in many virtual machines, there is only the timing.\n"
+     "   pp -a --progress 2 40 > list.txt\n"
+     "       every 10 seconds, prints to standard error how much of the search\n"
+     "       is done, how many trial polynomials a second it tests, how many\n"
+     "       primitive ones it found, and about how long it has left.  Any\n"
+     "       search prints the same, with the counts for each test so far, on\n"
+     "       kill -USR1 <pid>\n"
+     "   pp -a --adaptive 251 4\n"
+     "       times the tests on a sample of the trial polynomials, and does\n"
+     "       them in the order which throws out the most polynomials for the\n"
+     "       time spent.  The answers are the same, but the counts of -s are\n"
+     "       for the usual order, so they don't go with it.\n"
+     "   pp -a --lanes 5 10\n"
+     "       tests 8 trial polynomials at a time, side by side, which the\n"
+     "       compiler can turn into vector instructions.  Meant for p > 2.\n"
+     "       Only for the plain search, without --timing or --adaptive.\n"
+     "   pp -w 2 2281\n"
+     "       for p = 2, degrees past 62 (126 when built with -DPP_INT128) up\n"
+     "       to 16384 go to a separate search, with polynomials and r sized\n"
+     "       at run time.  r = 2^n - 1 has to factor, e.g. for n a Mersenne\n"
+     "       prime exponent.  Only -s, -w, -a with -w, and --factors apply to it.\n"
+     "   pp --factors FactorTable.txt -s 2 1024\n"
+     "       takes the factors of p^n - 1 and p^n + 1 from a table in the\n"
+     "       style of the Cunningham tables, one entry per line, e.g.\n"
+     "           2 128 + 59649589127497217 5704689200685129054721\n"
+     "       Each entry is checked as it is read.  See ppFactorTable.c.\n"
+     "   pp --trace pp.json --trace-sample 100 2 40\n"
+     "       in a build with -DPP_TRACE, records the tests of every 100th trial\n"
+     "       polynomial and writes them to pp.json for chrome://tracing or\n"
+     "       Perfetto.  Only the latest events are kept if there are many.\n"
+     "   pp -a --archive deg20.ppa 2 20\n"
+     "       writes the list to a compact binary file instead, which programs\n"
+     "       can map into memory to pick out the kth polynomial quickly.\n"
+     "   pp -a --read-archive deg20.ppa 2 20\n"
+     "       lists the polynomials in the archive without searching.\n"
+     "   pp --batch queries.txt\n"
+     "   pp -j 8 --batch -\n"
+     "       answers queries, one per line, from a file or standard input:\n"
+     "           find p n             the first primitive polynomial\n"
+     "           test p n 1,0,0,1,1   is it primitive?  (coefficients from x ^ n down)\n"
+     "           count p n            how many there are\n"
+     "           list p n limit       the first limit of them\n"
+     "       printing one line per answer, in order.  Factorizations and\n"
+     "       answers are shared between queries, and -j answers several at once.\n"
+     "   pp -j 4 --serve /tmp/pp.sock &\n"
+     "   echo \"find 2 40\" | pp --client /tmp/pp.sock\n"
+     "       keeps running, answering the same queries as --batch sent to a\n"
+     "       Unix domain socket, with 4 threads.  Stop it with kill or ^C.  What\n"
+     "       it learns is kept for later queries.  The client sends queries\n"
+     "       from standard input and prints the answers.  Each message is a\n"
+     "       4 byte length, most significant byte first, then the text.\n"
+     "   pp --bench --baseline before.txt\n"
+     "   pp --bench --compare before.txt\n"
+     "   pp --bench 2 40\n"
+     "       times square, product, x_to_power, construct_power_table,\n"
+     "       find_nullity and factor, and the whole search, for a set of p\n"
+     "       and n (or just the p and n given).  Prints the ns per call, the\n"
+     "       trial polynomials tested per second, and the fraction each test\n"
+     "       rejects.  Saves them, or compares with saved ones, marking\n"
+     "       anything over 10% slower as a REGRESSION and exiting with 1.\n"
      "\n\n"
 } ;
 
@@ -228,43 +345,242 @@ char * help =
 ------------------------------------------------------------------------------*/
 
 
-/*  Show the legal notice first.  */
-
-printf(  "%s", legalNotice )  ;  
-
-
 /*  
      Read the parameters p and n from the command line.  Return with an error
      message if there are an incorrect number of inputs on the command line,
      or if p and n are out of bounds.
 */
-parse_command_line( argc, 
-                    argv,
-                    &testPolynomialForPrimitivity,
-                    &listAllPrimitivePolynomials,
-                    &printStatistics,
-                    &printHelp,
-                    &selfCheck,
-                    &p,
-                    &n,
-                    testPolynomial ) ;
-
-if (printHelp)
+parse_command_line( argc, argv, &options ) ;
+
+p = options.p ;
+n = options.n ;
+
+/*  Show the legal notice first, except in output meant for other programs. */
+if ((options.listingFormat == TEXTFORMAT || options.listingFormat == ARCHIVEFORMAT) &&
+    options.batchFile == (char *) 0 && options.serveSocket == (char *) 0 &&
+    options.clientSocket == (char *) 0 && !options.bench)
+    printf(  "%s", legalNotice )  ;  
+
+if (options.printHelp)
 {
     printf(  "%s", help )  ;  
 
     exit( 1 ) ;
 }
 
+if (options.numThreads < 1)
+{
+    printf( "ERROR:  The number of threads must be 1 or more.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+/*  Known factorizations to use in place of factoring r, here and in
+    the batch queries. */
+if (options.factorTableFile != (char *) 0)
+    load_factor_table( options.factorTableFile ) ;
+
+/*  Batch queries bring their own p and n, so we're done after them. */
+if (options.batchFile != (char *) 0)
+    return run_batch( options.batchFile, options.numThreads ) ;
+
+if (options.serveSocket != (char *) 0)
+    return run_server( options.serveSocket, options.numThreads ) ;
+
+if (options.clientSocket != (char *) 0)
+    return run_client( options.clientSocket ) ;
+
+/*  Hardware counters go with the timing of the stages or the benchmark.
+    Without them, carry on with the timing alone. */
+if (options.hardwareCounters)
+{
+    if (options.timingFormat == NOTIMING && !options.bench)
+        options.timingFormat = TEXTTIMING ;
+
+    if (!set_hardware_counters( YES ) && options.timingFormat != JSONTIMING)
+        printf( "Hardware performance counters aren't available here;  timing only.\n\n" ) ;
+}
+
+if (options.bench)
+    return run_bench( p, n, options.benchBaseline, options.benchCompare ) ;
+
+#ifndef PP_TRACE
+if (options.traceFile != (char *) 0)
+{
+    printf( "ERROR:  --trace needs pp compiled with -DPP_TRACE.\n\n" ) ;
+    exit( 1 ) ;
+}
+#endif
+
 if (p < 2)
 {
     printf( "ERROR:  p must be 2 or more.\n\n" ) ;
     exit( 1 ) ;
 }
 
+if (options.randomSearch && options.listAllPrimitivePolynomials)
+{
+    printf( "ERROR:  Can't list all primitive polynomials by random sampling.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.randomSearch && options.lowWeightSearch)
+{
+    printf( "ERROR:  Choose either random sampling or low weight search.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.minimalPolySearch && !options.listAllPrimitivePolynomials)
+{
+    printf( "ERROR:  The -m option only applies when listing all with -a.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.unsortedMinimalPolys && !options.minimalPolySearch)
+{
+    printf( "ERROR:  The --unsorted option only applies with -m.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.minimalPolySearch && (options.randomSearch || options.lowWeightSearch))
+{
+    printf( "ERROR:  Can't combine -m with random sampling or low weight search.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+/*  These searches run on one thread only. */
+if (options.numThreads > 1 &&
+    (options.randomSearch || options.lowWeightSearch || options.minimalPolySearch))
+{
+    printf( "ERROR:  Can't combine -j with -r, -w or -m;  they use one thread.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.reciprocalPairs && !options.listAllPrimitivePolynomials)
+{
+    printf( "ERROR:  The -i option only applies when listing all with -a.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.reciprocalPairs &&
+    (options.randomSearch || options.lowWeightSearch || options.minimalPolySearch ||
+     options.numThreads > 1))
+{
+    printf( "ERROR:  Can't combine -i with -r, -w, -m or -j.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.checkpointFile != (char *) 0 &&
+    (options.randomSearch || options.lowWeightSearch || options.minimalPolySearch ||
+     options.reciprocalPairs || options.numThreads > 1))
+{
+    printf( "ERROR:  Checkpoints work only for the plain search, without -r, -w, -m, -i or -j.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+/*  Find out now, not an hour into the search, if we can't save checkpoints. */
+if (options.checkpointFile != (char *) 0 && !check_checkpoint_file( options.checkpointFile ))
+{
+    printf( "ERROR:  Can't write the checkpoint file %s.tmp\n\n", options.checkpointFile ) ;
+    exit( 1 ) ;
+}
+
+if (options.numShards != 0 && (options.shard < 1 || options.shard > options.numShards))
+{
+    printf( "ERROR:  Shard must be k/N with 1 <= k <= N.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if ((options.numShards != 0 || options.numMergeFiles != 0) &&
+    (options.randomSearch || options.lowWeightSearch || options.minimalPolySearch ||
+     options.reciprocalPairs || options.numThreads > 1 ||
+     options.checkpointFile != (char *) 0))
+{
+    printf( "ERROR:  Can't combine --shard or --merge with -r, -w, -m, -i, -j or checkpoints.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+/*  The counts saved in checkpoints and shards are for the usual order. */
+if (options.adaptiveOrder &&
+    (options.printStatistics || options.checkpointFile != (char *) 0 ||
+     options.numShards != 0 || options.numMergeFiles != 0))
+{
+    printf( "ERROR:  Can't combine --adaptive with -s, checkpoints, --shard or --merge.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.useLanes &&
+    (options.randomSearch || options.lowWeightSearch || options.minimalPolySearch ||
+     options.reciprocalPairs || options.numThreads > 1 ||
+     options.checkpointFile != (char *) 0 || options.numShards != 0 ||
+     options.numMergeFiles != 0 || options.readArchiveFile != (char *) 0 ||
+     options.timingFormat != NOTIMING || options.adaptiveOrder))
+{
+    printf( "ERROR:  --lanes works only for the plain search, without -r, -w, -m, -i, -j,\n"
+            "        checkpoints, shards, archives, --timing or --adaptive.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.numShards != 0 && options.numMergeFiles != 0)
+{
+    printf( "ERROR:  Choose either --shard or --merge.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.listingFormat != TEXTFORMAT && !options.listAllPrimitivePolynomials)
+{
+    printf( "ERROR:  The --format option only applies when listing all with -a.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.listingFormat == HEXFORMAT && p != 2)
+{
+    printf( "ERROR:  --format hex needs p = 2.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.readArchiveFile != (char *) 0 &&
+    (!options.listAllPrimitivePolynomials || options.listingFormat == ARCHIVEFORMAT ||
+     options.randomSearch || options.lowWeightSearch || options.minimalPolySearch ||
+     options.reciprocalPairs || options.numThreads > 1 ||
+     options.checkpointFile != (char *) 0 || options.numShards != 0 ||
+     options.numMergeFiles != 0))
+{
+    printf( "ERROR:  --read-archive needs -a, and can't be combined with a search option.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.listingFormat == ARCHIVEFORMAT &&
+    (options.checkpointFile != (char *) 0 || options.numShards != 0))
+{
+    printf( "ERROR:  Can't write an archive with checkpoints or shards;  merge the shards first.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+/*  Past MAXDEGPOLY, p = 2 has a search of its own with polynomials and r
+    sized at run time (ppLarge.c). */
+if (p == 2 && n > MAXDEGPOLY && n <= MAXLARGEDEG)
+{
+    if (options.randomSearch || options.minimalPolySearch || options.reciprocalPairs ||
+        options.numThreads > 1 || options.checkpointFile != (char *) 0 ||
+        options.numShards != 0 || options.numMergeFiles != 0 ||
+        options.listingFormat != TEXTFORMAT || options.readArchiveFile != (char *) 0 ||
+        options.timingFormat != NOTIMING || options.adaptiveOrder || options.useLanes ||
+        options.showProgress || options.traceFile != (char *) 0 || options.selfCheck ||
+        (options.listAllPrimitivePolynomials && !options.lowWeightSearch))
+    {
+        printf( "ERROR:  For p = 2 and n > %d, the only options are -s, -w, -a with -w,\n"
+                "        and --factors.\n\n",
+                MAXDEGPOLY ) ;
+        exit( 1 ) ;
+    }
+
+    return search_large( n, options.lowWeightSearch, options.listAllPrimitivePolynomials,
+                         options.printStatistics ) ;
+}
+
 if (n > MAXDEGPOLY || n < 2)
 {
-    printf( "ERROR: n must be between 2 and %d\n\n", MAXDEGPOLY ) ;
+    printf( "ERROR: n must be between 2 and %d\n\n", (p == 2) ? MAXLARGEDEG : MAXDEGPOLY ) ;
     exit( 1 ) ;
 }
 
@@ -284,7 +600,7 @@ if (!is_almost_surely_prime( p ))
 */
 if (n * log( (double) p ) > log( (double) (sbigint) max_p_to_n ))
 {
-    printf( "ERROR:  p to the nth power must be smaller than %llu\n\n", MAXPTON ) ;
+    printf( "ERROR:  p to the nth power must be smaller than %s\n\n", bigint_string( MAXPTON ) ) ;
     exit( 1 ) ;
 }
 
@@ -300,34 +616,61 @@ max_num_poly = power( p, n ) ;
 
 r = (max_num_poly - 1) / (p - 1) ;
 
+/*  Archives keep r and the ranks in 64 bits, which the 128-bit bigint can
+    outgrow. */
+if ((options.listingFormat == ARCHIVEFORMAT || options.readArchiveFile != (char *) 0) &&
+    max_num_poly - 1 > (bigint) ~0ULL)
+{
+    printf( "ERROR:  p to the nth power is too large for an archive;  it needs p^n <= 2^64.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (options.useLanes && !lanes_fit( n, p ))
+{
+    printf( "ERROR:  p is too large for --lanes;  it needs 2 n p^2 < 2^64.\n\n" ) ;
+    exit( 1 ) ;
+}
+
 
 
 
+/*  Start tracing, if asked. */
+if (options.traceFile != (char *) 0 && !set_trace( options.traceSample ))
+{
+    printf( "ERROR:  Not enough memory for the trace.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+/*  With -s, keep the report out of hex, dense and jsonl listings. */
+if (options.listingFormat != TEXTFORMAT && options.listingFormat != ARCHIVEFORMAT)
+    report = stderr ;
+
 /*  Factor r into distinct primes. */
-if (printStatistics)
+if (options.printStatistics)
 {
-    sprintf( outputFormat, "%s%s%s", "\nFactoring r = ", bigintOutputFormat, " into\n    " ) ;
-    printf( outputFormat, r ) ;
+    fprintf( report, "\nFactoring r = %s into\n    ", bigint_string( r ) ) ;
 }
 
-prime_count = factor( r, primes, count ) ;
+TRACE_BEGIN( trace_start ) ;
+prime_count = factor_from_table( r, primes, count ) ;
+if (prime_count < 0)
+    prime_count = factor( r, primes, count ) ;
+TRACE_END( "factor r", trace_start ) ;
 
-if (printStatistics)
+if (options.printStatistics)
 {
     for (i = 0 ;  i <= prime_count ;  ++i)
     {
         if (count[ i ] == 1)
         {
-            sprintf( outputFormat, "%s ", bigintOutputFormat ) ;
-            printf(  outputFormat, primes[ i ] ) ;
+            fprintf( report, "%s ", bigint_string( primes[ i ] ) ) ;
         }
         else
         {
-            sprintf( outputFormat, "%s%s", bigintOutputFormat, "^%d " ) ;
-            printf(  outputFormat, primes[ i ], count[ i ] ) ;
+            fprintf( report, "%s^%d ", bigint_string( primes[ i ] ), count[ i ] ) ;
         }
     }
-    printf( "\n\n" ) ;
+    fprintf( report, "\n\n" ) ;
 }
 
 
@@ -338,123 +681,256 @@ if (printStatistics)
 */
 initial_trial_poly( f, n ) ;
 
-if (printStatistics || listAllPrimitivePolynomials)
+memset( &stats, 0, sizeof( stats ) ) ;
+
+if (options.printStatistics || options.listAllPrimitivePolynomials)
 {
-    sprintf( outputFormat, "%s%s%s", "Total number of primitive polynomials = ", bigintOutputFormat, ".  Begin testing...\n\n" ) ;
     num_prim_poly = EulerPhi( power( p, n ) - 1 ) / n ;
-    printf( outputFormat, num_prim_poly ) ;
+
+    if ((options.listingFormat == TEXTFORMAT || options.listingFormat == ARCHIVEFORMAT) &&
+        options.readArchiveFile == (char *) 0)
+        printf( "Total number of primitive polynomials = %s.  Begin testing...\n\n",
+                bigint_string( num_prim_poly ) ) ;
 }
 
+if (options.listingFormat == ARCHIVEFORMAT &&
+    !create_archive( options.archiveFile, p, n, r, primes, count, prime_count ))
+{
+    printf( "ERROR:  Can't create the archive file %s\n\n", options.archiveFile ) ;
+    exit( 1 ) ;
+}
+
+set_listing_format( options.listingFormat ) ;
+set_stage_timing( options.timingFormat != NOTIMING ) ;
+set_adaptive_order( options.adaptiveOrder ) ;
+
+/*  Pick up the counts and the trial polynomial where the checkpoint left
+    them, and cut the output back to match.  */
+if (options.resume)
+{
+    if (!read_checkpoint( options.checkpointFile, &checkpoint ))
+    {
+        printf( "ERROR:  Can't read the checkpoint file %s\n\n", options.checkpointFile ) ;
+        exit( 1 ) ;
+    }
+
+    if (checkpoint.p != p || checkpoint.n != n ||
+        checkpoint.list_all != options.listAllPrimitivePolynomials)
+    {
+        printf( "ERROR:  The checkpoint file %s is for a different search.\n\n", options.checkpointFile ) ;
+        exit( 1 ) ;
+    }
+
+    if (!resume_output( checkpoint.output_offset ))
+    {
+        printf( "ERROR:  Output is shorter than at the checkpoint.  Append to it with >>\n\n" ) ;
+        exit( 1 ) ;
+    }
+
+    stats           = checkpoint.stats ;
+    prim_poly_count = checkpoint.prim_poly_count ;
+
+    if (stats.num_poly > 0)
+        unrank_trial_poly( f, n, p, stats.num_poly - 1 ) ;
+}
+
+if (options.checkpointFile != (char *) 0)
+    last_checkpoint_time = time( (time_t *) 0 ) ;
+
 
 
 /*
      Generate and test all possible n th degree, monic, modulo p polynomials
      f(x).  A polynomial is primitive if passes all the tests successfully.
+     The search can be split among several threads.
 */
-do {
-    next_trial_poly( f, n, p ) ;      /* Try another polynomal. */
-    ++num_poly ;
+TRACE_BEGIN( trace_start ) ;
 
-    #ifdef DEBUG_PP_PRIMPOLY
-    printf( "\nNext trial polynomial:  " ) ;
-    write_poly( f, n ) ;
-    printf( "\n" ) ;
-    #endif
+start_progress( options.showProgress, options.listAllPrimitivePolynomials, max_num_poly + 1,
+                stats.num_poly ) ;
 
-    /*                         n         2n-2
-        Precompute the powers x ,  ..., x     (mod f(x), p)
-        for use in all later computations.
+if (options.randomSearch)
+{
+    printf( "Random seed = %llu\n\n", options.randomSeed ) ;
+
+    /*  Draw candidates until one passes.  About one in n is primitive, so
+        this won't take long.  Each draw is independent, so there is no
+        bound on the number of trials, but a primitive polynomial exists. */
+    do {
+        random_trial_poly( f, n, p, &options.randomSeed ) ;
+        ++stats.num_poly ;
+
+        is_primitive_poly = passes_primitivity_tests( f, n, p, r, primes,
+                                                      prime_count, &stats ) ;
+    } while (!is_primitive_poly) ;
+}
+else if (options.lowWeightSearch)
+{
+    /*  Go through the polynomials by number of terms, stopping after the
+        first weight which has any primitive ones.  Binomials are never
+        primitive for n >= 2 since the order of x divides n (p-1).  Modulo 2
+        a polynomial with an even number of terms has the root 1.
     */
-    construct_power_table( power_table, f, n, p ) ;
-
-
-    /* Constant coefficient of f(x) * (-1)^n must be a primitive root of p. */
-    if (const_coeff_is_primitive_root( f, n, p ))
+    for (weight = 3 ;  weight <= n + 1 && !is_primitive_poly ;  ++weight)
     {
-        ++num_const_coeff_prim_root ;
+        if (p == 2 && weight % 2 == 0)
+            continue ;
 
-        #ifdef DEBUG_PP_PRIMPOLY
-        printf( "Coefficient of polynomial is primitive root.\n" ) ;
-        #endif
+        more_of_this_weight = first_sparse_poly( &sparse, f, n, p, weight ) ;
 
-        /* f(x) can't have any linear factors. */
-        if (!linear_factor( f, n, p ))
+        while (more_of_this_weight)
         {
-            ++num_free_of_linear_factors ;
+            if (p == 2 && weight == 3 && swan_says_reducible( n, sparse.exponent[ 1 ] ))
+                ++num_skipped_by_swan ;
+            else
+            {
+                ++stats.num_poly ;
 
-            #ifdef DEBUG_PP_PRIMPOLY
-            printf( "Free of linear factors.\n" ) ;
-            #endif
+                if (passes_primitivity_tests( f, n, p, r, primes, prime_count, &stats ))
+                {
+                    is_primitive_poly = YES ;
 
-            /* f(x) can't have two or more distinct irreducible factors. */
-            if (!has_multi_irred_factors( power_table, n, p ))
-            {
-                ++num_irred_to_power ;
+                    if (options.listAllPrimitivePolynomials)
+                        write_listing_entry( f, n, p, ++prim_poly_count, num_prim_poly ) ;
+                    else
+                        break ;
+                }
+            }
+
+            more_of_this_weight = next_sparse_poly( &sparse, f, n, p ) ;
+        }
+    }
+}
+else if (options.minimalPolySearch)
+{
+    /*  Search in order for the first primitive polynomial, then get all the
+        rest from it without testing.  */
+    do {
+        next_trial_poly( f, n, p ) ;
+        ++stats.num_poly ;
+
+        is_primitive_poly = passes_primitivity_tests( f, n, p, r, primes,
+                                                      prime_count, &stats ) ;
+    } while (!is_primitive_poly && stats.num_poly <= max_num_poly) ;
+
+    if (is_primitive_poly)
+        prim_poly_count = list_all_by_minimal_poly( f, n, p, num_prim_poly,
+                                                    !options.unsortedMinimalPolys ) ;
+}
+else if (options.numShards != 0)
+{
+    /*  Leave the listing and the statistics for --merge.  */
+    search_shard( n, p, r, primes, prime_count, options.shard, options.numShards,
+                  options.listAllPrimitivePolynomials ) ;
+    return 0 ;
+}
+else if (options.readArchiveFile != (char *) 0)
+{
+    prim_poly_count = list_archive( options.readArchiveFile, n, p, num_prim_poly, f ) ;
 
-                #ifdef DEBUG_PP_PRIMPOLY
-                printf( "Has one unique irreducible factor.\n" ) ;
-                #endif
+    is_primitive_poly = (prim_poly_count > 0) ? YES : NO ;
+}
+else if (options.numMergeFiles != 0)
+{
+    prim_poly_count = merge_shards( options.mergeFiles, options.numMergeFiles, n, p,
+                                    options.listAllPrimitivePolynomials, num_prim_poly,
+                                    f, &stats ) ;
 
-                /* x^r (mod f(x), p) = a must be an integer. */
-                if (order_r( power_table, n, p, r, &a ))
-                {
-                    ++num_order_r ;
-
-                     #ifdef DEBUG_PP_PRIMPOLY
-                     printf( "Passes the order r test.\n" ) ;
-                     #endif
-
-                     /*  Const coeff. of f(x)*(-1)^n must equal a mod p. */
-                     if (const_coeff_test( f, n, p, a ))
-                     {
-                         ++num_passing_const_coeff_test ;
-
-                         #ifdef DEBUG_PP_PRIMPOLY
-                         printf( "Passes the constant coefficient test.\n" ) ;
-                         #endif
-
-                         /*  x^m != integer for all m = r / q, q a prime divisor of r. */
-                         if (order_m( power_table, n, p, r, primes, prime_count ))
-                         {
-                             ++num_order_m ;
-                             is_primitive_poly = YES ;
-
-                             #ifdef DEBUG_PP_PRIMPOLY
-                             printf( "Passes the order m tests.\n" ) ;
-                             #endif
-
-                             if (listAllPrimitivePolynomials)
-                             {
-                                 printf( "\n\nPrimitive polynomial " ) ;
-                                 sprintf( outputFormat, "%s of %s ", bigintOutputFormat, bigintOutputFormat ) ;
-                                 printf(  outputFormat, ++prim_poly_count, num_prim_poly ) ;
-                                 printf( "modulo %d of degree %d\n\n", p, n ) ;
-                                 write_poly( f, n ) ;
-                                 printf( "\n\n" ) ;
-                             }
-                         }
-                     } /* end const coeff test */
-                } /* end order r */
-            } /* end can't determine if reducible */
-        } /* end no linear factors */
-    } /* end constant coefficient primitive. */
+    is_primitive_poly = (prim_poly_count > 0) ? YES : NO ;
+}
+else if (options.reciprocalPairs)
+{
+    prim_poly_count = list_all_by_reciprocal_pairs( f, n, p, r, primes, prime_count,
+                                                    num_prim_poly, &stats ) ;
+
+    is_primitive_poly = (prim_poly_count > 0) ? YES : NO ;
+}
+else if (options.useLanes)
+{
+    prim_poly_count = search_lanes( n, p, r, primes, prime_count, num_prim_poly,
+                                    options.listAllPrimitivePolynomials, f, &stats ) ;
+
+    is_primitive_poly = (prim_poly_count > 0) ? YES : NO ;
+}
+else if (options.numThreads > 1)
+{
+    prim_poly_count = search_parallel( n, p, r, primes, prime_count,
+                                       num_prim_poly, options.numThreads,
+                                       options.listAllPrimitivePolynomials, f, &stats ) ;
+
+    is_primitive_poly = (prim_poly_count > 0) ? YES : NO ;
+}
+else do {
+    next_trial_poly( f, n, p ) ;      /* Try another polynomal. */
+    ++stats.num_poly ;
+
+    if (passes_primitivity_tests( f, n, p, r, primes, prime_count, &stats ))
+    {
+        is_primitive_poly = YES ;
+
+        if (options.listAllPrimitivePolynomials)
+            write_listing_entry( f, n, p, ++prim_poly_count, num_prim_poly ) ;
+    }
 
     /* Stop when we've either checked all possible polynomials or 
        we've not been asked to list all and found the first primtive one.  
     */
-    stopTesting = (num_poly > max_num_poly) || 
-                  (!listAllPrimitivePolynomials && is_primitive_poly) ;
+    stopTesting = (stats.num_poly > max_num_poly) || 
+                  (!options.listAllPrimitivePolynomials && is_primitive_poly) ;
+
+    /*  Report how far we've got, when the timer or SIGUSR1 says to. */
+    if (stats.num_poly % NUMPOLYPERCLOCKCHECK == 0 && progress_due())
+        report_progress( &stats, stats.num_poly, prim_poly_count ) ;
+
+    /*  Save the state now and then.  Look at the clock only once in a while,
+        and record the output size after flushing, so it covers every
+        polynomial listed up to here.  */
+    if (options.checkpointFile != (char *) 0 && !stopTesting &&
+        stats.num_poly % NUMPOLYPERCLOCKCHECK == 0 &&
+        time( (time_t *) 0 ) - last_checkpoint_time >= CHECKPOINTSECONDS)
+    {
+        flush_output() ;
+        fflush( stdout ) ;
+
+        checkpoint.p               = p ;
+        checkpoint.n               = n ;
+        checkpoint.list_all        = options.listAllPrimitivePolynomials ;
+        checkpoint.stats           = stats ;
+        checkpoint.prim_poly_count = prim_poly_count ;
+        checkpoint.output_offset   = (long long) ftell( stdout ) ;
+
+        write_checkpoint( options.checkpointFile, &checkpoint ) ;
+
+        last_checkpoint_time = time( (time_t *) 0 ) ;
+    }
 
 } while( !stopTesting ) ;
 
-printf( "\n\n" ) ;
+TRACE_END( "search", trace_start ) ;
+
+stop_progress() ;
+
+flush_output() ;
+
+if (options.listingFormat == ARCHIVEFORMAT && !finish_archive())
+{
+    printf( "ERROR:  Can't write the archive file %s\n\n", options.archiveFile ) ;
+    exit( 1 ) ;
+}
+
+if (options.listingFormat == TEXTFORMAT || options.listingFormat == ARCHIVEFORMAT)
+    printf( "\n\n" ) ;
+
+/*  Done, so there is nothing left to resume. */
+if (options.checkpointFile != (char *) 0)
+    remove( options.checkpointFile ) ;
 
 
 /*
      Report on success or failure.
 */
 
-if (listAllPrimitivePolynomials)
+if (options.listAllPrimitivePolynomials)
     ; /* We're done */
 else if (is_primitive_poly)
 {
@@ -466,32 +942,45 @@ else if (is_primitive_poly)
 else {
 
     printf( "Internal error:  \n"
-            "Tested all possible polynomials (%llu), but failed\n"
+            "Tested all possible polynomials (%s), but failed\n"
             "to find a primitive polynomial.\n"
             "Please let the author know by e-mail.\n",
-            max_num_poly ) ;
+            bigint_string( max_num_poly ) ) ;
     exit( 1 ) ;
 }
 
 
-/*  Print the statistics of the primitivity tests. */
+/*  Print the statistics of the primitivity tests, unless we only read
+    the polynomials from an archive and tested none. */
+
+if (options.printStatistics && options.readArchiveFile == (char *) 0)
+{
+    fprintf( report, "+--------- Statistics -----------------------------------------------------------------\n" ) ;
+    fprintf( report, "|\n" ) ;
+    fprintf( report, "| Total num. degree %3d polynomials mod %3d :    %s\n", n, p, bigint_string( max_num_poly ) ) ;
+    fprintf( report, "| Actually tested :                              %s\n",  bigint_string( stats.num_poly ) ) ;
+    fprintf( report, "| Const. coeff. was primitive root :      %10s\n",  bigint_string( stats.num_const_coeff_prim_root ) ) ;
+    fprintf( report, "| Free of linear factors :                %10s\n",  bigint_string( stats.num_free_of_linear_factors ) ) ;
+    fprintf( report, "| Irreducible or irred. to power :        %10s\n",  bigint_string( stats.num_irred_to_power ) ) ;
+    fprintf( report, "| Had order r (x^r = integer) :           %10s\n",  bigint_string( stats.num_order_r ) ) ;
+    fprintf( report, "| Passed const. coeff. test :             %10s\n",  bigint_string( stats.num_passing_const_coeff_test ) ) ;
+    fprintf( report, "| Had order m (x^m != integer) :          %10s\n",  bigint_string( stats.num_order_m ) ) ;
+    if (options.lowWeightSearch && p == 2)
+        fprintf( report, "| Skipped by Swan's theorem :                    %s\n", bigint_string( num_skipped_by_swan ) ) ;
+    if (options.minimalPolySearch)
+        fprintf( report, "| Minimal polynomials computed :                 %s\n", bigint_string( prim_poly_count ) ) ;
+    fprintf( report, "|\n" ) ;
+    fprintf( report, "+--------------------------------------------------------------------------------------\n" ) ;
+}
+
+/*  Print where the time went. */
+if (options.timingFormat != NOTIMING)
+    print_stage_timing( &stats, p, n, options.timingFormat ) ;
 
-if (printStatistics)
+if (options.traceFile != (char *) 0 && !write_trace( options.traceFile ))
 {
-    printf( "+--------- Statistics -----------------------------------------------------------------\n" ) ;
-    printf( "|\n" ) ;
-    sprintf( outputFormat, "%s%s%s", "| Total num. degree %3d polynomials mod %3d :    ", bigintOutputFormat, "\n" ) ;
-    printf( outputFormat, n, p, max_num_poly ) ;
-    sprintf( outputFormat, "%s%s%s", "| Actually tested :                              ", bigintOutputFormat, "\n" ) ;
-    printf( outputFormat,  num_poly ) ;
-    printf( "| Const. coeff. was primitive root :      %10d\n",  num_const_coeff_prim_root ) ;
-    printf( "| Free of linear factors :                %10d\n",  num_free_of_linear_factors ) ;
-    printf( "| Irreducible or irred. to power :        %10d\n",  num_irred_to_power ) ;
-    printf( "| Had order r (x^r = integer) :           %10d\n",  num_order_r ) ;
-    printf( "| Passed const. coeff. test :             %10d\n",  num_passing_const_coeff_test ) ;
-    printf( "| Had order m (x^m != integer) :          %10d\n",  num_order_m ) ;
-    printf( "|\n" ) ;
-    printf( "+--------------------------------------------------------------------------------------\n" ) ;
+    printf( "ERROR:  Can't write the trace file %s\n\n", options.traceFile ) ;
+    exit( 1 ) ;
 }
 
 
@@ -499,7 +988,7 @@ if (printStatistics)
 /*  Confirm f(x) is primitive using a different, but extremely slow test for 
     primitivity.  Disabled when we list all primitive polynomials.
 */
-if (selfCheck && !listAllPrimitivePolynomials)
+if (options.selfCheck && !options.listAllPrimitivePolynomials)
 {
 
     printf( "\nConfirming polynomial is primitive with an independent check.\n"
@@ -45,9 +45,17 @@
 ==============================================================================*/
 
 /* Extend the range of the program's calculations using a higher precision 
-   integer type, in this case a 64-bit type.
+   integer type, in this case a 64-bit type.  Compile with -DPP_INT128 for
+   gcc or clang's 128-bit type, which allows p^n up to 2^127 - 1, e.g.
+
+       cc -DPP_INT128 -O2 -o pp *.c -lm -pthread
+
+   There is no printf format for it, so print a bigint with bigint_string.
  */
-#if defined( _MSC_VER ) /* Microsoft/Pentium systems with Visual C++ 6.0 */
+#if defined( PP_INT128 )
+    typedef unsigned __int128 bigint ;
+    typedef          __int128 sbigint ;
+#elif defined( _MSC_VER ) /* Microsoft/Pentium systems with Visual C++ 6.0 */
     typedef unsigned __int64 bigint ;  /*  Special type defined in the Microsoft
                                            Visual C++ 6.0 SP3 compiler. */
     typedef          __int64 sbigint ; /*  Signed version. */
@@ -61,6 +69,75 @@
 #define YES 1                      /*  Imitate boolean values. */
 #define NO  0
 
+#define TEXTFORMAT  0              /*  How to print listings (--format).       */
+#define HEXFORMAT   1
+#define DENSEFORMAT 2
+#define JSONFORMAT  3
+#define ARCHIVEFORMAT 4            /*  Binary archive file (--archive).        */
+
+#define NOTIMING    0              /*  Whether and how to print the time      */
+#define TEXTTIMING  1              /*  spent in each stage (--timing).         */
+#define JSONTIMING  2
+
+#define POWERTABLESTAGE 0          /*  Stages of the primitivity tests, in     */
+#define CONSTCOEFFSTAGE 1          /*  the usual order they are done.          */
+#define LINEARSTAGE     2
+#define BERLEKAMPSTAGE  3
+#define ORDERRSTAGE     4
+#define CONSTTESTSTAGE  5
+#define ORDERMSTAGE     6
+#define NUMSTAGES       7
+
+#define NUMTIMEBUCKETS 40          /*  Stage time histogram buckets:  powers
+                                       of 2 nanoseconds up to 18 minutes.  */
+
+#define CYCLESCOUNTER       0      /*  Hardware performance counters       */
+#define INSTRUCTIONSCOUNTER 1      /*  (--counters).                       */
+#define L1MISSCOUNTER       2
+#define LLCMISSCOUNTER      3
+#define BRANCHMISSCOUNTER   4
+#define NUMHWCOUNTERS       5
+
+#define PP_OK        0             /*  Status returned by the library         */
+#define PP_BAD_P     1             /*  functions in ppLibrary.c.              */
+#define PP_BAD_N     2
+#define PP_TOO_BIG   3
+#define PP_BAD_POLY  4
+#define PP_NOT_FOUND 5
+#define PP_STOPPED   6
+
+/*  Tallies of how many trial polynomials passed each stage of the
+    primitivity tests in main, and with --timing how long each stage took.
+    Kept together so the search can be split among threads and the counts
+    summed afterwards.
+*/
+typedef struct
+{
+    bigint num_poly ;                     /* Number of polynomials tested.      */
+    bigint num_const_coeff_prim_root ;    /* Constant is a primitive root of p. */
+    bigint num_free_of_linear_factors ;   /* Have no linear factors.            */
+    bigint num_irred_to_power ;           /* Irreducible poly to a power >= 1.  */
+    bigint num_order_r ;                  /* Pass the order_r test.             */
+    bigint num_passing_const_coeff_test ; /* Constant passes consistency check. */
+    bigint num_order_m ;                  /* Pass the order_m test.             */
+    bigint stage_calls[ NUMSTAGES ] ;     /* Times each stage was timed ...     */
+    bigint stage_nanosec[ NUMSTAGES ] ;   /* ... total time in it ...           */
+    bigint stage_histogram[ NUMSTAGES ][ NUMTIMEBUCKETS ] ; /* ... and spread.  */
+    bigint stage_counters[ NUMSTAGES ][ NUMHWCOUNTERS ] ;   /* With --counters. */
+} SearchStatistics ;
+
+/*  Everything needed to pick up an interrupted search where it left off. */
+typedef struct
+{
+    int              p ;                  /* Modulus.                           */
+    int              n ;                  /* Degree.                            */
+    int              list_all ;           /* YES if listing all (-a).           */
+    SearchStatistics stats ;              /* Counts so far;  num_poly is also   */
+                                          /* the number of trial polys done.    */
+    bigint           prim_poly_count ;    /* Primitive polynomials listed.      */
+    long long        output_offset ;      /* Size of standard output, or -1.    */
+} Checkpoint ;
+
 /* In case it's not defined, put something reasonable. */
 #ifndef _MAX_PATH
 #define _MAX_PATH 100
@@ -87,6 +164,10 @@
 #define NUMBITS 8 * \
         sizeof( bigint )     /*  Number of bits in the high precision integer. */
 
+#ifdef PP_INT128
+#define MAXDEGPOLY 126       /*  As below, for the 128-bit bigint.            */
+#define MAXNUMPRIMEFACTORS 63
+#else
 #define MAXDEGPOLY 62        /*  Maximum possible degree n of f( x ) when p = 2:
                                  | log ( MAXPTON ) |.
                                  --   2           --                          */
@@ -94,10 +175,21 @@
 #define MAXNUMPRIMEFACTORS 31       /*  Maxmimum number of distinct primes =
                                         | log ( MAXPTON ) | + 1.         
                                         --               --                   */
+#endif
 
 #define NUM_PRIME_TEST_TRIALS 25 /*  Number of trials to test if a number is
 								     probably prime. */
 
+#define MAXLARGEDEG 16384    /*  Maximum degree n when p = 2 for the search
+                                 past MAXDEGPOLY (ppLarge.c).                 */
+
+#define MULTIINTLIMBS (MAXLARGEDEG / 16 + 2) /* 32 bit limbs in a MultiInt:
+                                 room for the product of two numbers below
+                                 2^MAXLARGEDEG.                               */
+
+#define MULTIINTDIGITS (10 * MULTIINTLIMBS + 1) /* Room for a MultiInt
+                                                   in decimal.                */
+
 
 /*==============================================================================
 |                            CONTROL PARAMETERS
@@ -109,6 +201,248 @@
 #define NUMTERMSPERLINE 7    /*  How many terms of a polynomial to 
                                  write before starting a new line.            */
 
+#define NUMPOLYPERCHUNK 4096 /*  Trial polynomials handed to a thread at a
+                                 time when searching in parallel (-j).        */
+
+#define NUMCHUNKSPERTHREAD 4 /*  How many chunks each thread may run ahead
+                                 of the oldest unfinished one.  Bounds the
+                                 memory used to put results back in order.   */
+
+#ifndef CHECKPOINTSECONDS
+#define CHECKPOINTSECONDS 60 /*  How often to save the search state when
+                                 checkpointing (--checkpoint).                */
+#endif
+
+#define ADAPTIVESAMPLERATE 1024 /* With --adaptive, time every test on one
+                                   trial polynomial in this many ...          */
+
+#define ADAPTIVEREORDER 32   /*  ... and reorder the tests after timing this
+                                 many.                                        */
+
+#define NUMLANES 8           /*  Trial polynomials tested side by side
+                                 with --lanes ...                             */
+
+#define LANEBLOCK 256        /*  ... out of blocks of this many.              */
+
+#define LANEROOTCACHE 65536  /*  Largest p for which --lanes remembers the
+                                 primitive roots.                             */
+
+#define TRIALDIVISORLIMIT 65536 /* factor tries divisors up to here, then
+                                   splits what's left with Pollard rho.      */
+
+#define RHOBATCH 128         /*  Differences multiplied together between gcds
+                                 in Pollard rho.                              */
+
+#define MULTIPRIMETRIALS 8   /*  Miller-Rabin bases for a MultiInt.  Each
+                                 is slow for a big number, and a composite of
+                                 hundreds of digits almost never passes one.  */
+
+#define LARGETRIALDIVISORS 8388608 /* Trial divisors of r for the large
+                                      degree search ...                      */
+
+#define LARGERHOSTEPS 8388608 /* ... then steps of Pollard rho on what's
+                                 left ...                                     */
+
+#define LARGERHOBITS 256     /*  ... if it has no more bits than this.        */
+
+#define LARGESIEVEDEG 10     /*  The large degree search looks for factors
+                                 of f(x) up to this degree before the full
+                                 irreducibility test.                         */
+
+#define FACTORTABLELINE (2 * MULTIINTDIGITS) /* Longest line of a factor
+                                                table (--factors).           */
+
+#ifndef KARATSUBACUTOFF
+#define KARATSUBACUTOFF 16   /*  product and square multiply polynomials with
+                                 this many coefficients or more by Karatsuba's
+                                 method.                                      */
+#endif
+
+#define SWARMAXDEG 16        /*  Largest n and p for which square, product, */
+#define SWARMAXP    7        /*  times_x and x_to_power pack a polynomial
+                                 into one 64 bit word, 4 bits per
+                                 coefficient (ppSwar.c).                      */
+
+#define PROGRESSSECONDS 10   /*  How often to report on the search with
+                                 --progress.                                  */
+
+#define OUTPUTBUFFERSIZE 65536 /* Bytes of listing output to collect before
+                                   writing them out.                          */
+
+#define NUMBIGINTSTRINGS 8   /*  Results of bigint_string which stay good at
+                                 once, e.g. for one printf.                   */
+
+#define ARCHIVEINDEXSTRIDE 1024 /* Polynomials between index entries in an
+                                   archive (--archive).                       */
+
+#define MAXQUERYLENGTH (16 * MAXDEGPOLY + 64) /* Longest query in a batch
+                                   (--batch) or to a server (--serve).        */
+
+#define MINPOLYWHEEL 262144U /* Largest product of primes to skip multiples
+                                 of with -m.                                  */
+
+#define BATCHQUEUE 1024      /*  Queries a batch reads ahead of the answers
+                                 it has printed.                              */
+
+#define QUERYCACHESIZE 1024  /*  Most p and n whose results a batch or a
+                                 server keeps;  the least recently used go
+                                 first.                                       */
+
+#define CACHEDANSWERS 16     /*  Most list and test answers the query cache
+                                 keeps for each p and n ...                   */
+
+#define MAXCACHEDANSWER 65536 /* ... not counting any longer than this.      */
+
+#define BENCHSAMPLES 5       /*  Timed runs of each benchmark;  we report
+                                 the median (--bench).                        */
+
+#define BENCHSAMPLENANOSEC 20000000ULL /*  About how long each run takes.   */
+
+#define BENCHCANDIDATES 1000 /*  Trial polynomials tested in each run of the
+                                 search benchmark.                            */
+
+#define BENCHTOLERANCE 10.0  /*  Percent slower than the baseline which
+                                 counts as a regression.                      */
+
+#define TRACEBUFFERSIZE 262144 /* Events kept in memory when tracing
+                                    (--trace);  older ones are overwritten.  */
+
+#define NUMPOLYPERCLOCKCHECK 4096 /*  Trial polynomials between looks at the
+                                      clock to see if a checkpoint or a
+                                      progress report is due.                 */
+
+/*==============================================================================
+|                       DATA TYPES SIZED BY THE CONSTANTS
+==============================================================================*/
+
+/*  Position of a sparse trial polynomial in the order the low weight
+    search (-w) goes through them.  The weight is the number of non-zero
+    terms, counting x^n and the constant term.
+*/
+typedef struct
+{
+    int weight ;                     /* Number of non-zero terms.             */
+    int exponent[ MAXDEGPOLY + 1 ] ; /* exponent[ 0 ] = 0 for the constant,
+                                        then the exponents of the middle
+                                        terms in increasing order.            */
+    int coeff[ MAXDEGPOLY + 1 ] ;    /* Non-zero coefficients of the terms
+                                        with those exponents.                 */
+} SparseTrialPoly ;
+
+/*  A non-negative integer too big for a bigint, such as r = 2^n - 1 in
+    the large degree search.  See ppMultiInt.c.
+*/
+typedef struct
+{
+    int          size ;                  /* Limbs in use;  0 for zero.          */
+    unsigned int limb[ MULTIINTLIMBS ] ; /* Base 2^32 digits, lowest first.     */
+} MultiInt ;
+
+/*  The prime factors of a MultiInt. */
+typedef struct
+{
+    int        num_primes ;          /* Primes are in locations 0 to num_primes - 1, */
+    int        max_primes ;          /* out of this many allocated.            */
+    MultiInt * prime ;               /* Distinct primes, in increasing order,  */
+    int      * count ;               /* and their multiplicities.              */
+} MultiFactors ;
+
+/*  An archive of primitive polynomials (--archive), mapped into memory for
+    reading.  See ppArchive.c for the file format.
+*/
+typedef struct
+{
+    const unsigned char * base ;     /* The whole file.                        */
+    bigint size ;                    /* Its size in bytes.                     */
+    int    p ;                       /* Modulus.                               */
+    int    n ;                       /* Degree.                                */
+    bigint count ;                   /* Number of polynomials.                 */
+    bigint r ;                       /* (p^n - 1) / (p - 1) ...                */
+    int    num_factors ;             /* ... its distinct prime factors ...     */
+    bigint primes[ MAXNUMPRIMEFACTORS ] ;
+    int    count_of_prime[ MAXNUMPRIMEFACTORS ] ; /* ... and multiplicities.  */
+    bigint index_stride ;            /* Polynomials between index entries.     */
+    bigint data_offset ;             /* Where the polynomials are ...          */
+    bigint data_size ;               /* ... and how many bytes.                */
+    bigint index_offset ;            /* Where the index is ...                 */
+    bigint index_count ;             /* ... and how many entries.              */
+} PrimpolyArchive ;
+
+/*  Everything the library functions in ppLibrary.c need to know about one
+    p and n.  Each thread uses its own.
+*/
+typedef struct
+{
+    int    p ;                       /* Modulus.                               */
+    int    n ;                       /* Degree.                                */
+    bigint max_num_poly ;            /* p ^ n                                  */
+    bigint r ;                       /* (p^n - 1) / (p - 1) ...                */
+    bigint primes[ MAXNUMPRIMEFACTORS ] ; /* ... its distinct prime factors   */
+    int    count[ MAXNUMPRIMEFACTORS ] ;  /* ... and their multiplicities.    */
+    int    prime_count ;             /* Primes are in locations 0 to prime_count. */
+    bigint num_prim_poly ;           /* How many primitive polynomials.        */
+    SearchStatistics stats ;         /* Running totals for all calls.          */
+} PrimpolyContext ;
+
+/*  Called by primpoly_enumerate for each primitive polynomial.  Return
+    non-zero to stop. */
+typedef int (* PrimpolyCallback)( void * user, const int * f, int n, bigint index ) ;
+
+/*  Results shared between queries in batch mode (ppBatch.c). */
+typedef struct QueryCache QueryCache ;
+
+/*  Position when going through an archive in order. */
+typedef struct
+{
+    PrimpolyArchive * archive ;
+    bigint k ;                       /* Polynomials read so far.               */
+    bigint offset ;                  /* Where the next one is in the data.     */
+    bigint rank ;                    /* Rank of the last one read.             */
+} ArchiveCursor ;
+
+/*  The options and arguments on the command line, from parse_command_line. */
+typedef struct
+{
+    int    testPolynomialForPrimitivity ; /* -t                                */
+    int    listAllPrimitivePolynomials ;  /* -a                                */
+    int    printStatistics ;             /* -s                                 */
+    int    printHelp ;                   /* -h, or a mistake on the line.      */
+    int    selfCheck ;                   /* -c                                 */
+    int    numThreads ;                  /* -j N                               */
+    int    randomSearch ;                /* -r                                 */
+    unsigned long long randomSeed ;      /* ... and its seed.                  */
+    int    lowWeightSearch ;             /* -w                                 */
+    int    minimalPolySearch ;           /* -m                                 */
+    int    unsortedMinimalPolys ;        /* --unsorted                         */
+    int    reciprocalPairs ;             /* -i                                 */
+    char * checkpointFile ;              /* --checkpoint or --resume file ...  */
+    int    resume ;                      /* ... YES if --resume.               */
+    int    shard ;                       /* --shard k/N                        */
+    int    numShards ;
+    char * mergeFiles[ _MAX_PATH ] ;     /* Each --merge file.                 */
+    int    numMergeFiles ;
+    int    listingFormat ;               /* --format, or --archive.            */
+    int    timingFormat ;                /* --timing                           */
+    int    hardwareCounters ;            /* --counters                         */
+    int    showProgress ;                /* --progress                         */
+    int    adaptiveOrder ;               /* --adaptive                         */
+    int    useLanes ;                    /* --lanes                            */
+    char * traceFile ;                   /* --trace                            */
+    bigint traceSample ;                 /* --trace-sample                     */
+    char * archiveFile ;                 /* --archive                          */
+    char * readArchiveFile ;             /* --read-archive                     */
+    char * factorTableFile ;             /* --factors                          */
+    char * batchFile ;                   /* --batch                            */
+    char * serveSocket ;                 /* --serve                            */
+    char * clientSocket ;                /* --client                           */
+    int    bench ;                       /* --bench                            */
+    char * benchBaseline ;               /* --baseline                         */
+    char * benchCompare ;                /* --compare                          */
+    int    p ;                           /* Modulus.                           */
+    int    n ;                           /* Degree.                            */
+} PrimpolyOptions ;
+
+
 /*==============================================================================
 |                            F U N C T I O N S
 ==============================================================================*/
@@ -116,15 +450,21 @@
 /* ppIO.c */
 int parse_command_line( int    argc, 
 					    char * argv[], 
-                        int *  testPolynomialForPrimitivity,
-                        int *  listAllPrimitivePolynomials,
-                        int *  printStatistics,
-                        int *  printHelp,
-                        int *  selfCheck,
-                        int *  p,
-                        int *  n,
-                        int *  testPolynomial ) ;
+                        PrimpolyOptions * options ) ;
 void write_poly       ( int *  a, int n ) ;
+int  string_to_bigint ( const char * s, bigint * x ) ;
+void set_listing_format( int format ) ;
+void write_listing_entry( int * f, int n, int p, bigint prim_poly_count,
+                          bigint num_prim_poly ) ;
+
+
+/* ppOutput.c */
+void put_char    ( char c ) ;
+void put_string  ( const char * s ) ;
+void put_unsigned( bigint x ) ;
+const char * bigint_string( bigint x ) ;
+void put_poly    ( int * a, int n ) ;
+void flush_output( void ) ;
 
 
 /* ppArith.c */
@@ -133,6 +473,9 @@ bigint power            ( int   x, int y ) ;
 int    power_mod        ( int   a, int n, int p ) ;
 int    is_primitive_root( int   a, int p ) ;
 int    inverse_mod_p    ( int n, int p ) ;
+unsigned long long next_random( unsigned long long * state ) ;
+int    random_residue   ( unsigned long long * state, int p ) ;
+bigint multiply_mod     ( bigint a, bigint b, bigint n ) ;
 
 
 /* ppPolyArith.c */
@@ -148,19 +491,26 @@ int  coeff_of_product     ( int  * s, int * t, int   k, int   n, int p ) ;
 void square               ( int  * t, int   power_table[][ MAXDEGPOLY ], int n, int p ) ;
 void product              ( int  * s, int * t, int   power_table[][ MAXDEGPOLY ], int n, int p ) ;
 void times_x              ( int  * t, int   power_table[][ MAXDEGPOLY ], int n, int p ) ;
-void x_to_power           ( bigint m, int * g, int power_table[][ MAXDEGPOLY ], int n, int p ) ;
+int  x_to_power           ( bigint m, int * g, int power_table[][ MAXDEGPOLY ], int n, int p ) ;
 
 
 /* ppFactor.c */
 int    factor                ( bigint   n, bigint * primes, int * count ) ;
 int    is_probably_prime     ( int      n, int      x ) ;
 int    is_almost_surely_prime( int      n ) ;
+int    is_bigint_prime       ( bigint   n ) ;
 bigint EulerPhi              ( bigint   n ) ;
 
 
 /* ppHelperFunc.c */
 void initial_trial_poly   ( int * f, int   n ) ;
 void next_trial_poly      ( int * f, int   n, int p ) ;
+void unrank_trial_poly    ( int * f, int   n, int p, bigint k ) ;
+void random_trial_poly    ( int * f, int   n, int p, unsigned long long * state ) ;
+int  first_sparse_poly    ( SparseTrialPoly * s, int * f, int n, int p, int weight ) ;
+int  next_sparse_poly     ( SparseTrialPoly * s, int * f, int n, int p ) ;
+int  swan_says_reducible  ( int   n, int   k ) ;
+void add_statistics       ( SearchStatistics * total, SearchStatistics * part ) ;
 int  const_coeff_test     ( int * f, int n, int p, int a ) ;
 int  const_coeff_is_primitive_root(  int * f, int n, int p ) ;
 int  skip_test            ( int   i, bigint * primes, int p ) ;
@@ -176,4 +526,186 @@ int  order_m      ( int power_table[][ MAXDEGPOLY ], int n, int p, bigint r,
 int  order_r      ( int power_table[][ MAXDEGPOLY ], int n, int p, bigint r, int * a ) ;
 int  maximal_order( int * f, int n, int p ) ;
 
+
+/* ppParallel.c */
+bigint search_parallel( int n, int p, bigint r, bigint * primes, int prime_count,
+                        bigint num_prim_poly, int num_threads, int list_all,
+                        int * f, SearchStatistics * stats ) ;
+
+
+/* ppMinPoly.c */
+bigint list_all_by_minimal_poly( int * f, int n, int p, bigint num_prim_poly,
+                                 int sorted ) ;
+void   minimal_poly_of_power   ( bigint k, int * g, int power_table[][ MAXDEGPOLY ],
+                                 int n, int p ) ;
+
+
+/* ppCheckpoint.c */
+int check_checkpoint_file( char * file_name ) ;
+int write_checkpoint     ( char * file_name, Checkpoint * state ) ;
+int read_checkpoint      ( char * file_name, Checkpoint * state ) ;
+int resume_output        ( long long offset ) ;
+
+
+/* ppShard.c */
+int    shard_range ( int p, int n, int shard, int num_shards,
+                     bigint * first_rank, bigint * last_rank ) ;
+void   search_shard( int n, int p, bigint r, bigint * primes, int prime_count,
+                     int shard, int num_shards, int list_all ) ;
+bigint merge_shards( char ** file_names, int num_files, int n, int p,
+                     int list_all, bigint num_prim_poly, int * f,
+                     SearchStatistics * stats ) ;
+
+
+/* ppArchive.c */
+int    create_archive    ( char * file_name, int p, int n, bigint r,
+                           bigint * primes, int * count, int prime_count ) ;
+void   append_to_archive ( int * f ) ;
+int    finish_archive    ( void ) ;
+int    open_archive      ( char * file_name, PrimpolyArchive * archive ) ;
+void   close_archive     ( PrimpolyArchive * archive ) ;
+int    archive_poly      ( PrimpolyArchive * archive, bigint k, int * f ) ;
+int    first_archive_poly( PrimpolyArchive * archive, ArchiveCursor * cursor, int * f ) ;
+int    next_archive_poly ( ArchiveCursor * cursor, int * f ) ;
+bigint list_archive      ( char * file_name, int n, int p, bigint num_prim_poly, int * f ) ;
+
+
+/* ppLibrary.c */
+int          primpoly_check       ( int p, int n ) ;
+int          primpoly_init        ( PrimpolyContext * context, int p, int n ) ;
+int          primpoly_test        ( PrimpolyContext * context, const int * f, int * is_primitive ) ;
+int          primpoly_find        ( PrimpolyContext * context, int * f ) ;
+int          primpoly_enumerate   ( PrimpolyContext * context, PrimpolyCallback callback,
+                                    void * user, bigint * num_found ) ;
+int          primpoly_list        ( PrimpolyContext * context, int * buffer, bigint max_polys,
+                                    bigint * num_found ) ;
+const char * primpoly_error_string( int status ) ;
+
+
+/* ppBatch.c */
+QueryCache * create_query_cache    ( void ) ;
+void         free_query_cache      ( QueryCache * cache ) ;
+int          cached_context        ( QueryCache * cache, int p, int n, PrimpolyContext * context ) ;
+int          cached_first_primitive( QueryCache * cache, int p, int n, int * f ) ;
+char *       answer_query          ( QueryCache * cache, const char * query ) ;
+int          run_batch             ( char * file_name, int num_threads ) ;
+
+
+/* ppTiming.c */
+void         set_stage_timing    ( int on ) ;
+int          stage_timing_enabled( void ) ;
+const char * stage_timing_name   ( int stage ) ;
+bigint       stage_clock         ( void ) ;
+bigint       stage_start         ( void ) ;
+bigint       record_stage        ( SearchStatistics * stats, int stage, bigint start ) ;
+void         print_stage_timing  ( SearchStatistics * stats, int p, int n, int format ) ;
+
+
+/* ppFilter.c */
+int  passes_primitivity_tests( int * f, int n, int p, bigint r, bigint * primes,
+                               int prime_count, SearchStatistics * stats ) ;
+void set_adaptive_order      ( int on ) ;
+
+
+/* ppLanes.c */
+bigint search_lanes( int n, int p, bigint r, bigint * primes, int prime_count,
+                     bigint num_prim_poly, int list_all, int * f,
+                     SearchStatistics * stats ) ;
+int    lanes_fit   ( int n, int p ) ;
+
+
+/* ppSwar.c */
+int swar_fits      ( int n, int p ) ;
+int  swar_x_to_power  ( bigint m, int * g, int power_table[][ MAXDEGPOLY ], int n, int p ) ;
+void swar_times_x_poly( int * t, int power_table[][ MAXDEGPOLY ], int n, int p ) ;
+void swar_square_poly ( int * t, int power_table[][ MAXDEGPOLY ], int n, int p ) ;
+void swar_product_poly( int * s, int * t, int power_table[][ MAXDEGPOLY ], int n, int p ) ;
+
+
+/* ppMultiInt.c */
+void         multi_set              ( MultiInt * a, bigint x ) ;
+void         multi_copy             ( MultiInt * a, const MultiInt * b ) ;
+int          multi_to_bigint        ( const MultiInt * a, bigint * x ) ;
+void         multi_power            ( MultiInt * a, int p, int n ) ;
+int          multi_compare          ( const MultiInt * a, const MultiInt * b ) ;
+void         multi_add_small        ( MultiInt * a, unsigned int x ) ;
+void         multi_subtract_small   ( MultiInt * a, unsigned int x ) ;
+void         multi_multiply_small   ( MultiInt * a, unsigned int m ) ;
+unsigned int multi_divide_small     ( MultiInt * a, unsigned int d ) ;
+void         multi_multiply         ( MultiInt * c, const MultiInt * a, const MultiInt * b ) ;
+void         multi_divide           ( MultiInt * q, MultiInt * rem, const MultiInt * a,
+                                      const MultiInt * b ) ;
+void         multi_subtract         ( MultiInt * a, const MultiInt * b ) ;
+void         multi_gcd              ( MultiInt * g, const MultiInt * a, const MultiInt * b ) ;
+int          multi_num_bits         ( const MultiInt * a ) ;
+int          multi_bit              ( const MultiInt * a, int k ) ;
+int          multi_is_prime         ( const MultiInt * a ) ;
+int          multi_is_mersenne_prime( int n ) ;
+void         multi_to_string        ( const MultiInt * a, char * s ) ;
+int          multi_from_string      ( MultiInt * a, const char * s ) ;
+void         multi_add_factor       ( MultiFactors * F, const MultiInt * q, int k ) ;
+void         multi_free_factors     ( MultiFactors * F ) ;
+
+
+/* ppLarge.c */
+int search_large( int n, int low_weight, int list_all, int print_statistics ) ;
+
+
+/* ppFactorTable.c */
+int                  load_factor_table  ( char * file_name ) ;
+int                  factor_from_table  ( bigint n, bigint * primes, int * count ) ;
+const MultiFactors * factor_table_primes( void ) ;
+
+
+/* ppProgress.c */
+void start_progress ( int show_progress, int list_all, bigint total, bigint done ) ;
+void stop_progress  ( void ) ;
+int  progress_due   ( void ) ;
+void report_progress( SearchStatistics * stats, bigint done, bigint hits ) ;
+
+
+/* ppBench.c */
+int run_bench( int p, int n, char * baseline_file, char * compare_file ) ;
+
+
+/* ppCounters.c */
+int          set_hardware_counters     ( int on ) ;
+int          hardware_counters_enabled ( void ) ;
+int          hardware_counter_available( int k ) ;
+const char * hardware_counter_name     ( int k ) ;
+int          counter_deltas            ( bigint * delta ) ;
+
+
+/* ppTrace.c */
+int    set_trace        ( bigint sample_rate ) ;
+void   trace_sample_poly( void ) ;
+bigint trace_begin      ( void ) ;
+void   trace_end        ( const char * name, bigint start ) ;
+int    write_trace      ( char * file_name ) ;
+
+/*  Trace points.  They compile to nothing unless PP_TRACE is defined. */
+#ifdef PP_TRACE
+#define TRACE_DECLARE( start )     bigint start = 0
+#define TRACE_SAMPLE_POLY()        trace_sample_poly()
+#define TRACE_BEGIN( start )       (start) = trace_begin()
+#define TRACE_END( name, start )   trace_end( (name), (start) )
+#else
+#define TRACE_DECLARE( start )
+#define TRACE_SAMPLE_POLY()
+#define TRACE_BEGIN( start )
+#define TRACE_END( name, start )
+#endif
+
+
+/* ppServer.c */
+int run_server( char * socket_path, int num_threads ) ;
+int run_client( char * socket_path ) ;
+
+
+/* ppReciprocal.c */
+bigint list_all_by_reciprocal_pairs( int * f, int n, int p, bigint r,
+                                     bigint * primes, int prime_count,
+                                     bigint num_prim_poly,
+                                     SearchStatistics * stats ) ;
+
 #endif  /*  End of wrapper for header. */
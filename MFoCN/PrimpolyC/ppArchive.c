@@ -0,0 +1,760 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppArchive.c
+|
+|  Description:
+|
+|     Write listings of primitive polynomials to a compact binary archive,
+|     and read them back by memory mapping the file.
+|
+|  Functions:
+|
+|     create_archive
+|     append_to_archive
+|     finish_archive
+|     open_archive
+|     close_archive
+|     archive_poly
+|     first_archive_poly
+|     next_archive_poly
+|     list_archive
+|     put_u32, put_u64, get_u32, get_u64, get_varint
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  FILE FORMAT
+|
+|     All numbers are little endian.  Offsets are in bytes.
+|
+|       0   char[8]  "PPARCHV1"
+|       8   u32      version = 1
+|      12   u32      header size, 80 + 16 * number of factors
+|      16   u32      p
+|      20   u32      n
+|      24   u64      number of primitive polynomials
+|      32   u64      r = (p^n - 1) / (p - 1)
+|      40   u32      number of distinct prime factors of r
+|      44   u32      index stride K
+|      48   u64      offset of the polynomial data
+|      56   u64      size of the polynomial data
+|      64   u64      offset of the index
+|      72   u64      number of index entries
+|      80            for each prime factor of r:  u64 prime, u64 multiplicity
+|
+|     Polynomial data:  the polynomials in the order of the search, each as
+|     its rank f  + f  p + ... + f     p^(n-1), stored as the difference
+|               0    1            n-1
+|     from the rank before it (from 0 for the first one) in the usual
+|     varint code:  7 bits per byte, low bits first, high bit set on every
+|     byte but the last.
+|
+|     Index:  for every Kth polynomial, starting with the 0th, a u64 offset
+|     of its varint within the data, and a u64 rank of the polynomial before
+|     it (0 for the first one).
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>      /* for open()         */
+#include <unistd.h>     /* for close()        */
+#include <sys/mman.h>   /* for mmap()         */
+#include <sys/stat.h>   /* for fstat()        */
+
+#include "Primpoly.h"
+
+#define ARCHIVEMAGIC      "PPARCHV1"
+#define ARCHIVEVERSION    1
+#define ARCHIVEHEADERSIZE 80     /* Not counting the factors of r. */
+
+
+static void   put_u32   ( FILE * fp, unsigned int x ) ;
+static void   put_u64   ( FILE * fp, bigint x ) ;
+static bigint get_u32   ( const unsigned char * b ) ;
+static bigint get_u64   ( const unsigned char * b ) ;
+static int    get_varint( const PrimpolyArchive * archive, bigint * offset, bigint * x ) ;
+
+
+/*  The archive being written.  Only one at a time, by one thread. */
+static FILE   * archive_fp = (FILE *) 0 ;
+static int      archive_p, archive_n ;
+static bigint   archive_count ;          /* Polynomials written so far.     */
+static bigint   archive_last_rank ;      /* Rank of the last one.           */
+static bigint   archive_data_size ;      /* Bytes of polynomial data.       */
+static bigint * archive_index ;          /* Offset, rank pairs.             */
+static bigint   archive_index_capacity ; /* Pairs there is room for.        */
+static bigint   archive_num_factors ;
+
+
+/*==============================================================================
+|                               create_archive                                 |
+================================================================================
+
+DESCRIPTION
+
+     Start writing a new archive.
+
+INPUT
+
+     file_name (char *)          Where to write it.
+     p, n (int)                  Modulus and degree.
+     r (bigint)                  (p^n - 1) / (p - 1)
+     primes, count, prime_count  The factorization of r from factor().
+
+OUTPUT
+
+     The archive file, with a header to be filled in by finish_archive.
+
+RETURNS
+
+     YES if the file was created, NO if not.
+
+METHOD
+
+     Write the header with zeros for what we don't know yet.  The file is
+     opened for update so finish_archive can go back and fill them in.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int create_archive( char * file_name, int p, int n, bigint r,
+                    bigint * primes, int * count, int prime_count )
+{
+int i ;
+
+if ((archive_fp = fopen( file_name, "wb+" )) == (FILE *) 0)
+    return NO ;
+
+archive_p              = p ;
+archive_n              = n ;
+archive_count          = 0 ;
+archive_last_rank      = 0 ;
+archive_data_size      = 0 ;
+archive_num_factors    = (bigint) (prime_count + 1) ;
+archive_index_capacity = 1024 ;
+archive_index = (bigint *) malloc( (size_t) (2 * archive_index_capacity) * sizeof( bigint ) ) ;
+
+if (archive_index == (bigint *) 0)
+{
+    printf( "ERROR:  Not enough memory for the archive index.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+fwrite( ARCHIVEMAGIC, 1, 8, archive_fp ) ;
+put_u32( archive_fp, ARCHIVEVERSION ) ;
+put_u32( archive_fp, (unsigned int) (ARCHIVEHEADERSIZE + 16 * archive_num_factors) ) ;
+put_u32( archive_fp, (unsigned int) p ) ;
+put_u32( archive_fp, (unsigned int) n ) ;
+put_u64( archive_fp, 0 ) ;
+put_u64( archive_fp, r ) ;
+put_u32( archive_fp, (unsigned int) archive_num_factors ) ;
+put_u32( archive_fp, ARCHIVEINDEXSTRIDE ) ;
+
+for (i = 0 ;  i < 4 ;  ++i)
+    put_u64( archive_fp, 0 ) ;
+
+for (i = 0 ;  i <= prime_count ;  ++i)
+{
+    put_u64( archive_fp, primes[ i ] ) ;
+    put_u64( archive_fp, (bigint) count[ i ] ) ;
+}
+
+return YES ;
+
+} /* ================== end of function create_archive ====================== */
+
+
+
+/*==============================================================================
+|                              append_to_archive                               |
+================================================================================
+
+DESCRIPTION
+
+     Add the next primitive polynomial to the archive.
+
+INPUT
+
+     f (int *)      The polynomial.  It must come after the last one in the
+                    order of the search.
+
+METHOD
+
+     Write the difference of its rank from the last one's.  Every
+     ARCHIVEINDEXSTRIDE polynomials, note where we are in the index.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void append_to_archive( int * f )
+{
+bigint rank = 0, delta ;
+int    i ;
+
+for (i = archive_n - 1 ;  i >= 0 ;  --i)
+    rank = rank * (bigint) archive_p + (bigint) f[ i ] ;
+
+if (archive_count % ARCHIVEINDEXSTRIDE == 0)
+{
+    bigint entry = archive_count / ARCHIVEINDEXSTRIDE ;
+
+    if (entry == archive_index_capacity)
+    {
+        archive_index_capacity *= 2 ;
+        archive_index = (bigint *) realloc( archive_index,
+                            (size_t) (2 * archive_index_capacity) * sizeof( bigint ) ) ;
+
+        if (archive_index == (bigint *) 0)
+        {
+            printf( "ERROR:  Not enough memory for the archive index.\n\n" ) ;
+            exit( 1 ) ;
+        }
+    }
+
+    archive_index[ 2 * entry ]     = archive_data_size ;
+    archive_index[ 2 * entry + 1 ] = archive_last_rank ;
+}
+
+/* Varint, low 7 bits first. */
+for (delta = rank - archive_last_rank ;  delta >= 0x80 ;  delta >>= 7)
+{
+    putc( (int) ((delta & 0x7F) | 0x80), archive_fp ) ;
+    ++archive_data_size ;
+}
+
+putc( (int) delta, archive_fp ) ;
+++archive_data_size ;
+
+archive_last_rank = rank ;
+++archive_count ;
+
+} /* ================ end of function append_to_archive ===================== */
+
+
+
+/*==============================================================================
+|                               finish_archive                                 |
+================================================================================
+
+DESCRIPTION
+
+     Write the index, fill in the header and close the archive.
+
+RETURNS
+
+     YES if everything was written, NO if not.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int finish_archive( void )
+{
+bigint data_offset  = ARCHIVEHEADERSIZE + 16 * archive_num_factors ;
+bigint index_offset = data_offset + archive_data_size ;
+bigint index_count  = (archive_count + ARCHIVEINDEXSTRIDE - 1) / ARCHIVEINDEXSTRIDE ;
+bigint i ;
+int    ok ;
+
+for (i = 0 ;  i < 2 * index_count ;  ++i)
+    put_u64( archive_fp, archive_index[ i ] ) ;
+
+fseek( archive_fp, 24, SEEK_SET ) ;
+put_u64( archive_fp, archive_count ) ;
+
+fseek( archive_fp, 48, SEEK_SET ) ;
+put_u64( archive_fp, data_offset ) ;
+put_u64( archive_fp, archive_data_size ) ;
+put_u64( archive_fp, index_offset ) ;
+put_u64( archive_fp, index_count ) ;
+
+ok = !ferror( archive_fp ) ;
+ok = (fclose( archive_fp ) == 0) && ok ;
+
+free( archive_index ) ;
+archive_fp = (FILE *) 0 ;
+
+return ok ;
+
+} /* ================== end of function finish_archive ====================== */
+
+
+
+/*==============================================================================
+|                                open_archive                                  |
+================================================================================
+
+DESCRIPTION
+
+     Map an archive into memory for reading.
+
+INPUT
+
+     file_name (char *)             The archive.
+
+OUTPUT
+
+     archive (PrimpolyArchive *)    Its header, and where its parts are.
+
+RETURNS
+
+     YES if the file is a good archive, NO if not.
+
+EXAMPLE
+
+     PrimpolyArchive archive ;
+     int             f[ MAXDEGPOLY + 1 ] ;
+
+     if (open_archive( "deg20.ppa", &archive ))
+     {
+         archive_poly( &archive, 12345, f ) ;
+         close_archive( &archive ) ;
+     }
+
+METHOD
+
+     mmap() the whole file read-only.  Nothing is read until it is used, so
+     opening even a huge archive is quick.  Check that the parts fit inside
+     the file, so later lookups needn't.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int open_archive( char * file_name, PrimpolyArchive * archive )
+{
+struct stat info ;
+int         fd ;
+bigint      header_size, i ;
+const unsigned char * b ;
+
+memset( archive, 0, sizeof( *archive ) ) ;
+
+if ((fd = open( file_name, O_RDONLY )) < 0)
+    return NO ;
+
+if (fstat( fd, &info ) != 0 || info.st_size < ARCHIVEHEADERSIZE)
+{
+    close( fd ) ;
+    return NO ;
+}
+
+archive->size = (bigint) info.st_size ;
+archive->base = (const unsigned char *) mmap( (void *) 0, (size_t) info.st_size,
+                                              PROT_READ, MAP_SHARED, fd, 0 ) ;
+close( fd ) ;
+
+if (archive->base == (const unsigned char *) MAP_FAILED)
+{
+    archive->base = (const unsigned char *) 0 ;
+    return NO ;
+}
+
+b = archive->base ;
+
+archive->p            = (int) get_u32( b + 16 ) ;
+archive->n            = (int) get_u32( b + 20 ) ;
+archive->count        = get_u64( b + 24 ) ;
+archive->r            = get_u64( b + 32 ) ;
+archive->num_factors  = (int) get_u32( b + 40 ) ;
+archive->index_stride = get_u32( b + 44 ) ;
+archive->data_offset  = get_u64( b + 48 ) ;
+archive->data_size    = get_u64( b + 56 ) ;
+archive->index_offset = get_u64( b + 64 ) ;
+archive->index_count  = get_u64( b + 72 ) ;
+header_size           = get_u32( b + 12 ) ;
+
+if (memcmp( b, ARCHIVEMAGIC, 8 ) != 0 || get_u32( b + 8 ) != ARCHIVEVERSION ||
+    archive->num_factors > MAXNUMPRIMEFACTORS ||
+    header_size != ARCHIVEHEADERSIZE + 16 * (bigint) archive->num_factors ||
+    archive->n < 1 || archive->n > MAXDEGPOLY || archive->p < 2 ||
+    archive->index_stride == 0 ||
+    archive->data_offset != header_size ||
+    archive->index_offset != archive->data_offset + archive->data_size ||
+    archive->index_count != (archive->count + archive->index_stride - 1) / archive->index_stride ||
+    archive->index_offset + 16 * archive->index_count != archive->size)
+{
+    close_archive( archive ) ;
+    return NO ;
+}
+
+for (i = 0 ;  i < (bigint) archive->num_factors ;  ++i)
+{
+    archive->primes[ i ] = get_u64( b + ARCHIVEHEADERSIZE + 16 * i ) ;
+    archive->count_of_prime[ i ] = (int) get_u64( b + ARCHIVEHEADERSIZE + 16 * i + 8 ) ;
+}
+
+return YES ;
+
+} /* =================== end of function open_archive ======================= */
+
+
+
+/*==============================================================================
+|                                close_archive                                 |
+================================================================================
+
+DESCRIPTION
+
+     Unmap an archive.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void close_archive( PrimpolyArchive * archive )
+{
+if (archive->base != (const unsigned char *) 0)
+    munmap( (void *) archive->base, (size_t) archive->size ) ;
+
+archive->base = (const unsigned char *) 0 ;
+
+} /* ================== end of function close_archive ======================= */
+
+
+
+/*==============================================================================
+|                                archive_poly                                  |
+================================================================================
+
+DESCRIPTION
+
+     Get the kth polynomial from an archive.
+
+INPUT
+
+     archive (PrimpolyArchive *)  An open archive.
+     k (bigint)                   0 <= k < archive->count.
+
+OUTPUT
+
+     f (int *)                    The polynomial.
+
+RETURNS
+
+     YES if there is a kth polynomial, NO if k is too big or the data is
+     damaged.
+
+METHOD
+
+     Jump to the index entry before it, then decode at most
+     index_stride varints from there.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int archive_poly( PrimpolyArchive * archive, bigint k, int * f )
+{
+ArchiveCursor cursor ;
+bigint        entry, i ;
+
+if (k >= archive->count)
+    return NO ;
+
+entry = k / archive->index_stride ;
+
+cursor.archive = archive ;
+cursor.k       = entry * archive->index_stride ;
+cursor.offset  = get_u64( archive->base + archive->index_offset + 16 * entry ) ;
+cursor.rank    = get_u64( archive->base + archive->index_offset + 16 * entry + 8 ) ;
+
+for (i = cursor.k ;  i <= k ;  ++i)
+    if (!next_archive_poly( &cursor, f ))
+        return NO ;
+
+return YES ;
+
+} /* =================== end of function archive_poly ======================= */
+
+
+
+/*==============================================================================
+|                             first_archive_poly                               |
+================================================================================
+
+DESCRIPTION
+
+     Start going through an archive in order.
+
+INPUT
+
+     archive (PrimpolyArchive *)  An open archive.
+
+OUTPUT
+
+     cursor (ArchiveCursor *)     Where we are.
+     f (int *)                    The first polynomial.
+
+RETURNS
+
+     YES if there is one, NO if the archive is empty.
+
+EXAMPLE
+
+     ArchiveCursor cursor ;
+
+     for (more = first_archive_poly( &archive, &cursor, f ) ;  more ;
+          more = next_archive_poly( &cursor, f ))
+         ...
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int first_archive_poly( PrimpolyArchive * archive, ArchiveCursor * cursor, int * f )
+{
+cursor->archive = archive ;
+cursor->k       = 0 ;
+cursor->offset  = 0 ;
+cursor->rank    = 0 ;
+
+return next_archive_poly( cursor, f ) ;
+
+} /* ================ end of function first_archive_poly ==================== */
+
+
+
+/*==============================================================================
+|                              next_archive_poly                               |
+================================================================================
+
+DESCRIPTION
+
+     Get the next polynomial from an archive.
+
+INPUT
+
+     cursor (ArchiveCursor *)     Where we are.
+
+OUTPUT
+
+     cursor (ArchiveCursor *)     Moved on by one.
+     f (int *)                    The polynomial.
+
+RETURNS
+
+     YES if there was another one, NO at the end or if the data is damaged.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int next_archive_poly( ArchiveCursor * cursor, int * f )
+{
+PrimpolyArchive * archive = cursor->archive ;
+bigint            delta ;
+
+if (cursor->k >= archive->count || !get_varint( archive, &cursor->offset, &delta ))
+    return NO ;
+
+cursor->rank += delta ;
+++cursor->k ;
+
+unrank_trial_poly( f, archive->n, archive->p, cursor->rank ) ;
+
+return YES ;
+
+} /* ================= end of function next_archive_poly ==================== */
+
+
+
+/*==============================================================================
+|                                list_archive                                  |
+================================================================================
+
+DESCRIPTION
+
+     List all the polynomials in an archive, just as the search would.
+
+INPUT
+
+     file_name (char *)        The archive.
+     n, p (int)                Degree and modulus, which the archive must match.
+     num_prim_poly (bigint)    Total number of primitive polynomials.
+
+OUTPUT
+
+     Standard output           The listing.
+     f (int *)                 The last polynomial.
+
+RETURNS
+
+     The number of polynomials listed.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint list_archive( char * file_name, int n, int p, bigint num_prim_poly, int * f )
+{
+PrimpolyArchive archive ;
+ArchiveCursor   cursor ;
+bigint          prim_poly_count = 0 ;
+int             more ;
+
+if (!open_archive( file_name, &archive ))
+{
+    printf( "ERROR:  %s isn't a primitive polynomial archive.\n\n", file_name ) ;
+    exit( 1 ) ;
+}
+
+if (archive.p != p || archive.n != n || archive.count != num_prim_poly)
+{
+    printf( "ERROR:  The archive %s is for p = %d, n = %d.\n\n", file_name,
+            archive.p, archive.n ) ;
+    exit( 1 ) ;
+}
+
+for (more = first_archive_poly( &archive, &cursor, f ) ;  more ;
+     more = next_archive_poly( &cursor, f ))
+{
+    write_listing_entry( f, n, p, ++prim_poly_count, num_prim_poly ) ;
+}
+
+close_archive( &archive ) ;
+
+return prim_poly_count ;
+
+} /* =================== end of function list_archive ======================= */
+
+
+
+/*==============================================================================
+|                     put_u32, put_u64, get_u32, get_u64                       |
+================================================================================
+
+DESCRIPTION
+
+     Write and read little endian numbers, whatever the machine's byte order.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void put_u32( FILE * fp, unsigned int x )
+{
+int i ;
+
+for (i = 0 ;  i < 4 ;  ++i, x >>= 8)
+    putc( (int) (x & 0xFF), fp ) ;
+
+} /* ==================== end of function put_u32 ========================== */
+
+
+static void put_u64( FILE * fp, bigint x )
+{
+int i ;
+
+for (i = 0 ;  i < 8 ;  ++i, x >>= 8)
+    putc( (int) (x & 0xFF), fp ) ;
+
+} /* ==================== end of function put_u64 ========================== */
+
+
+static bigint get_u32( const unsigned char * b )
+{
+return (bigint) b[ 0 ]         | (bigint) b[ 1 ] << 8 |
+       (bigint) b[ 2 ] << 16   | (bigint) b[ 3 ] << 24 ;
+
+} /* ==================== end of function get_u32 ========================== */
+
+
+static bigint get_u64( const unsigned char * b )
+{
+return get_u32( b ) | get_u32( b + 4 ) << 32 ;
+
+} /* ==================== end of function get_u64 ========================== */
+
+
+
+/*==============================================================================
+|                                 get_varint                                   |
+================================================================================
+
+DESCRIPTION
+
+     Decode one varint from the polynomial data.
+
+INPUT
+
+     archive (PrimpolyArchive *)  An open archive.
+     offset (bigint *)            Where it starts within the data.
+
+OUTPUT
+
+     offset (bigint *)            Just past it.
+     x (bigint *)                 Its value.
+
+RETURNS
+
+     YES if it was all there, NO if it ran off the end of the data.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int get_varint( const PrimpolyArchive * archive, bigint * offset, bigint * x )
+{
+const unsigned char * data = archive->base + archive->data_offset ;
+int                   shift ;
+
+*x = 0 ;
+
+for (shift = 0 ;  *offset < archive->data_size && shift < 64 ;  shift += 7)
+{
+    unsigned char byte = data[ (*offset)++ ] ;
+
+    *x |= (bigint) (byte & 0x7F) << shift ;
+
+    if ((byte & 0x80) == 0)
+        return YES ;
+}
+
+return NO ;
+
+} /* ==================== end of function get_varint ======================== */
@@ -14,6 +14,10 @@
 |      power
 |      power_mod
 |      is_primitive_root
+|      inverse_mod_p
+|      next_random
+|      random_residue
+|      multiply_mod
 |
 |  LEGAL
 |
@@ -471,3 +475,178 @@ int inverse_mod_p( int u, int p )
 
 	return inv_v ;
 }
+
+
+
+/*==============================================================================
+|                                  next_random                                 |
+================================================================================
+
+DESCRIPTION
+
+     Fast, seeded pseudorandom number generator.  The same starting state
+     always gives the same sequence, on any machine.
+
+INPUT
+
+     state (unsigned long long *)  Generator state.  Set it to the seed
+                                   before the first call.
+
+OUTPUT
+
+     state                         Advanced to the next state.
+
+RETURNS
+
+     A pseudorandom 64-bit number.
+
+EXAMPLE
+
+     unsigned long long state = 42 ;
+     x = next_random( &state ) ;
+     y = next_random( &state ) ;
+
+METHOD
+
+     SplitMix64, from Steele, Lea and Flood, "Fast Splittable Pseudorandom
+     Number Generators," OOPSLA 2014.  Step the state by a large odd
+     constant, then scramble it with two xor-shift-multiplies.  The period
+     is 2^64, every seed is good, and it passes BigCrush.
+
+     The state is deliberately unsigned long long rather than bigint, so
+     the sequence doesn't change if bigint is made wider.
+
+BUGS
+
+     Not for cryptography.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+unsigned long long next_random( unsigned long long * state )
+{
+unsigned long long z ;
+
+z = (*state += 0x9E3779B97F4A7C15ULL) ;
+
+z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL ;
+z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL ;
+
+return z ^ (z >> 31) ;
+
+} /* ===================== end of function next_random ====================== */
+
+
+
+/*==============================================================================
+|                                random_residue                                |
+================================================================================
+
+DESCRIPTION
+
+     Draw a uniformly distributed integer modulo p.
+
+INPUT
+
+     state (unsigned long long *)  Generator state for next_random.
+     p     (int, p >= 1)           The modulus.
+
+RETURNS
+
+     A random integer 0 <= x < p, every value equally likely.
+
+METHOD
+
+     Taking next_random() % p would slightly favor small residues unless
+     p divides 2^64.  So throw away draws from the incomplete block of p
+     values at the top of the range and try again.  At most one draw in
+     2^32 is thrown away for p < 2^31.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int random_residue( unsigned long long * state, int p )
+{
+unsigned long long x ;
+
+/*  (2^64 - p) mod p = 2^64 mod p is the size of the incomplete block. */
+unsigned long long excess = (0ULL - (unsigned long long) p) % (unsigned long long) p ;
+
+do {
+    x = next_random( state ) ;
+} while (x < excess) ;
+
+return (int)(x % (unsigned long long) p) ;
+
+} /* =================== end of function random_residue ===================== */
+
+
+
+/*==============================================================================
+|                                 multiply_mod                                 |
+================================================================================
+
+DESCRIPTION
+
+     Multiply two numbers modulo n without overflow.
+
+INPUT
+
+     a, b (bigint)     0 <= a, b < n.
+     n    (bigint)     The modulus, n >= 1.
+
+RETURNS
+
+     a b (mod n)
+
+EXAMPLE
+
+     multiply_mod( 7, 2, 15 ) = 14.
+
+METHOD
+
+     When a b fits in NUMBITS - 1 bits, just multiply.  Otherwise add up
+     the doublings of a picked out by the bits of b, reducing each time.
+     Since a, b < n <= MAXPTON, a sum of two numbers below n never
+     overflows.  The same goes for the 128-bit bigint.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint multiply_mod( bigint a, bigint b, bigint n )
+{
+bigint product = 0 ;
+
+if (a == 0 || b <= (~(bigint) 0 >> 1) / a)
+    return (a * b) % n ;
+
+while (b > 0)
+{
+    if (b & 1)
+    {
+        product += a ;
+        if (product >= n)
+            product -= n ;
+    }
+
+    a += a ;
+    if (a >= n)
+        a -= n ;
+
+    b >>= 1 ;
+}
+
+return product ;
+
+} /* =================== end of function multiply_mod ======================= */
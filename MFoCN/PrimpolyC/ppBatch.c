@@ -0,0 +1,1248 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppBatch.c
+|
+|  Description:
+|
+|     Answer many small queries about different p and n in one process,
+|     sharing what we learn between them.
+|
+|  Functions:
+|
+|     create_query_cache
+|     free_query_cache
+|     find_cache_entry
+|     unlink_cache_entry
+|     free_cache_entry
+|     claim_answer
+|     finish_answer
+|     release_answer
+|     cached_context
+|     cached_first_primitive
+|     answer_query
+|     run_batch
+|     batch_reader
+|     batch_worker
+|     append_answer
+|     append_poly
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  QUERIES
+|
+|     One per line.  Blank lines and lines starting with # are skipped.
+|     Polynomials are written as their coefficients from x ^ n down to the
+|     constant, separated by commas.
+|
+|         find p n              The first primitive polynomial, as pp p n.
+|         test p n 1,0,0,1,1    YES if primitive, NO if not.
+|         count p n             How many primitive polynomials there are.
+|         list p n limit        The first limit of them, in order.
+|
+|     Each answer is one line,  the number of the query, the query, a colon
+|     and the answer, in the same order as the queries:
+|
+|         1 find 2 4 : 1,0,0,1,1
+|         2 count 2 8 : 16
+|         3 find 4 4 : ERROR p must be a prime number
+|
+|     A line longer than MAXQUERYLENGTH is answered ERROR, showing only its
+|     beginning.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+#define NOTSTARTED 0   /*  States of a cached computation.  */
+#define WORKING    1
+#define FINISHED   2
+
+/*  Hash bucket of p and n in the query cache. */
+#define CACHEHASH( p, n ) (((unsigned) (p) * 31U + (unsigned) (n)) % QUERYCACHESIZE)
+
+/*  The answer to a list or test query, kept with its p and n. */
+typedef struct CachedAnswer
+{
+    char                * key ;     /* The rest of the query, written the   */
+                                    /* same way however it was asked.       */
+    char                * text ;    /* The answer, once FINISHED.           */
+    int                   state ;
+    int                   users ;   /* Threads working on it or waiting.    */
+    int                   keep ;    /* NO if too long to keep afterwards.   */
+    struct CacheEntry   * entry ;   /* Whose answer it is.                  */
+    struct CachedAnswer * next ;    /* Next older answer for the entry.     */
+} CachedAnswer ;
+
+/*  What we know about one p and n. */
+typedef struct CacheEntry
+{
+    int             p ;
+    int             n ;
+    int             users ;            /* Threads working on it or waiting. */
+    struct CacheEntry * next ;         /* Next in the same hash bucket.    */
+    struct CacheEntry * newer ;        /* Neighbours in order of last use. */
+    struct CacheEntry * older ;
+    int             context_state ;
+    int             context_status ;   /* From primpoly_init.              */
+    PrimpolyContext context ;          /* Factorization of r and so on.    */
+    int             first_state ;
+    int             first_status ;     /* From primpoly_find.              */
+    int             first[ MAXDEGPOLY + 1 ] ;  /* First primitive polynomial. */
+    CachedAnswer  * answers ;          /* Newest first ...                 */
+    int             num_answers ;      /* ... at most CACHEDANSWERS.       */
+} CacheEntry ;
+
+/*  Everything we know, shared by all threads, hashed on p and n.  When a
+    thread is working on an entry, others wanting the same thing wait for
+    it rather than repeating the work.  Past QUERYCACHESIZE entries, the
+    least recently used one goes, but never one with users, so a pointer
+    to an entry stays good for as long as we count ourselves in them. */
+struct QueryCache
+{
+    pthread_mutex_t lock ;
+    pthread_cond_t  changed ;    /* Some entry was FINISHED.  */
+    CacheEntry    * bucket[ QUERYCACHESIZE ] ;
+    CacheEntry    * newest ;
+    CacheEntry    * oldest ;
+    int             num_entries ;
+} ;
+
+/*  A growing answer string. */
+typedef struct
+{
+    char * text ;
+    size_t length ;
+    size_t capacity ;
+} Answer ;
+
+/*  A query of a batch, and its answer when there is one. */
+typedef struct
+{
+    char * query ;
+    char * answer ;
+    int    too_long ;             /* YES if we only have the beginning.  */
+} BatchSlot ;
+
+/*  The queries of a batch between the reader and the printer.  Query i
+    is in slot[ i % BATCHQUEUE ], which is free again once it's printed.
+    Everything here is under the lock, and anyone who changes it tells
+    the others with changed. */
+typedef struct
+{
+    QueryCache    * cache ;
+    FILE          * fp ;
+    BatchSlot       slot[ BATCHQUEUE ] ;
+    int             num_queries ;   /* Read so far.                      */
+    int             next_query ;    /* Next one for a worker to take.    */
+    int             num_printed ;
+    int             done_reading ;  /* YES at the end of the file.       */
+    pthread_mutex_t lock ;
+    pthread_cond_t  changed ;
+} Batch ;
+
+
+static CacheEntry * find_cache_entry( QueryCache * cache, int p, int n ) ;
+static void         unlink_cache_entry( QueryCache * cache, CacheEntry * entry ) ;
+static void         free_cache_entry( CacheEntry * entry ) ;
+static char *       claim_answer    ( QueryCache * cache, int p, int n, const char * key,
+                                      CachedAnswer ** claimed ) ;
+static void         finish_answer   ( QueryCache * cache, CachedAnswer * answer,
+                                      const char * text, int keep ) ;
+static void         release_answer  ( CachedAnswer * answer ) ;
+static void *       batch_reader    ( void * arg ) ;
+static void *       batch_worker    ( void * arg ) ;
+static void         append_answer   ( Answer * answer, const char * s ) ;
+static void         append_poly     ( Answer * answer, const int * f, int n ) ;
+
+
+/*==============================================================================
+|                        create_query_cache, free_query_cache                  |
+================================================================================
+
+DESCRIPTION
+
+     Make an empty cache, and throw one away.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+QueryCache * create_query_cache( void )
+{
+QueryCache * cache = (QueryCache *) calloc( 1, sizeof( QueryCache ) ) ;
+
+if (cache == (QueryCache *) 0)
+{
+    printf( "ERROR:  Not enough memory for the query cache.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+pthread_mutex_init( &cache->lock, (pthread_mutexattr_t *) 0 ) ;
+pthread_cond_init( &cache->changed, (pthread_condattr_t *) 0 ) ;
+
+return cache ;
+
+} /* ================ end of function create_query_cache ==================== */
+
+
+void free_query_cache( QueryCache * cache )
+{
+CacheEntry * entry ;
+
+while ((entry = cache->oldest) != (CacheEntry *) 0)
+{
+    unlink_cache_entry( cache, entry ) ;
+    free_cache_entry( entry ) ;
+}
+
+pthread_mutex_destroy( &cache->lock ) ;
+pthread_cond_destroy( &cache->changed ) ;
+free( cache ) ;
+
+} /* ================= end of function free_query_cache ===================== */
+
+
+
+/*==============================================================================
+|                              find_cache_entry                                |
+================================================================================
+
+DESCRIPTION
+
+     Find the entry for p and n, making a new one if there isn't one yet,
+     and mark it the most recently used.  The caller must hold the cache
+     lock, and should have checked p and n, so that bad ones don't push
+     out good ones.
+
+METHOD
+
+     Look in p and n's hash bucket.  To make room for a new entry, throw
+     out the least recently used one which no thread is using.  If every
+     one is in use, go over QUERYCACHESIZE for a while.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static CacheEntry * find_cache_entry( QueryCache * cache, int p, int n )
+{
+CacheEntry * entry ;
+unsigned     hash = CACHEHASH( p, n ) ;
+
+for (entry = cache->bucket[ hash ] ;  entry != (CacheEntry *) 0 ;  entry = entry->next)
+    if (entry->p == p && entry->n == n)
+        break ;
+
+/*  Take a known one out, to put it back at the front. */
+if (entry != (CacheEntry *) 0)
+    unlink_cache_entry( cache, entry ) ;
+else
+{
+    if (cache->num_entries >= QUERYCACHESIZE)
+    {
+        for (entry = cache->oldest ;  entry != (CacheEntry *) 0 ;  entry = entry->newer)
+            if (entry->users == 0)
+                break ;
+
+        if (entry != (CacheEntry *) 0)
+        {
+            unlink_cache_entry( cache, entry ) ;
+            free_cache_entry( entry ) ;
+        }
+    }
+
+    entry = (CacheEntry *) calloc( 1, sizeof( CacheEntry ) ) ;
+
+    if (entry == (CacheEntry *) 0)
+    {
+        printf( "ERROR:  Not enough memory for the query cache.\n\n" ) ;
+        exit( 1 ) ;
+    }
+
+    entry->p = p ;
+    entry->n = n ;
+}
+
+entry->next           = cache->bucket[ hash ] ;
+cache->bucket[ hash ] = entry ;
+++cache->num_entries ;
+
+entry->older = cache->newest ;
+entry->newer = (CacheEntry *) 0 ;
+
+if (cache->newest != (CacheEntry *) 0)
+    cache->newest->newer = entry ;
+else
+    cache->oldest = entry ;
+
+cache->newest = entry ;
+
+return entry ;
+
+} /* ================= end of function find_cache_entry ===================== */
+
+
+
+/*==============================================================================
+|                             unlink_cache_entry                               |
+================================================================================
+
+DESCRIPTION
+
+     Take an entry out of its hash bucket and the order of use, without
+     freeing it.  The caller must hold the cache lock.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void unlink_cache_entry( QueryCache * cache, CacheEntry * entry )
+{
+CacheEntry ** link ;
+
+link = &cache->bucket[ CACHEHASH( entry->p, entry->n ) ] ;
+
+while (*link != entry)
+    link = &(*link)->next ;
+
+*link = entry->next ;
+
+if (entry->newer != (CacheEntry *) 0)
+    entry->newer->older = entry->older ;
+else
+    cache->newest = entry->older ;
+
+if (entry->older != (CacheEntry *) 0)
+    entry->older->newer = entry->newer ;
+else
+    cache->oldest = entry->newer ;
+
+--cache->num_entries ;
+
+} /* ================ end of function unlink_cache_entry ==================== */
+
+
+
+
+/*==============================================================================
+|                              free_cache_entry                                |
+================================================================================
+
+DESCRIPTION
+
+     Free an entry taken out of the cache, with its answers.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void free_cache_entry( CacheEntry * entry )
+{
+CachedAnswer * answer ;
+
+while ((answer = entry->answers) != (CachedAnswer *) 0)
+{
+    entry->answers = answer->next ;
+    free( answer->key ) ;
+    free( answer->text ) ;
+    free( answer ) ;
+}
+
+free( entry ) ;
+
+} /* ================= end of function free_cache_entry ===================== */
+
+
+
+/*==============================================================================
+|                               cached_context                                 |
+================================================================================
+
+DESCRIPTION
+
+     Get a fresh context for p and n, factoring r only the first time
+     anyone asks.
+
+OUTPUT
+
+     context (PrimpolyContext *)   A copy with zeroed statistics, which the
+                                   caller may use however it likes.
+
+RETURNS
+
+     The status from primpoly_init.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int cached_context( QueryCache * cache, int p, int n, PrimpolyContext * context )
+{
+CacheEntry * entry ;
+int          status ;
+
+/*  Bad p and n get no entry. */
+if ((status = primpoly_check( p, n )) != PP_OK)
+    return status ;
+
+pthread_mutex_lock( &cache->lock ) ;
+
+entry = find_cache_entry( cache, p, n ) ;
+++entry->users ;
+
+while (entry->context_state == WORKING)
+    pthread_cond_wait( &cache->changed, &cache->lock ) ;
+
+if (entry->context_state == NOTSTARTED)
+{
+    /*  Factor without holding the lock, so other queries carry on. */
+    entry->context_state = WORKING ;
+    pthread_mutex_unlock( &cache->lock ) ;
+
+    status = primpoly_init( context, p, n ) ;
+
+    pthread_mutex_lock( &cache->lock ) ;
+    entry->context        = *context ;
+    entry->context_status = status ;
+    entry->context_state  = FINISHED ;
+    pthread_cond_broadcast( &cache->changed ) ;
+}
+
+*context = entry->context ;
+status   = entry->context_status ;
+--entry->users ;
+
+pthread_mutex_unlock( &cache->lock ) ;
+
+memset( &context->stats, 0, sizeof( context->stats ) ) ;
+
+return status ;
+
+} /* ================== end of function cached_context ====================== */
+
+
+
+/*==============================================================================
+|                           cached_first_primitive                             |
+================================================================================
+
+DESCRIPTION
+
+     Find the first primitive polynomial for p and n, searching only the
+     first time anyone asks.  When several threads ask at once, one
+     searches and the others wait for its answer.
+
+OUTPUT
+
+     f (int *)       The polynomial.
+
+RETURNS
+
+     PP_OK, or the error from primpoly_init or primpoly_find.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int cached_first_primitive( QueryCache * cache, int p, int n, int * f )
+{
+PrimpolyContext context ;
+CacheEntry    * entry ;
+int             status ;
+
+if ((status = cached_context( cache, p, n, &context )) != PP_OK)
+    return status ;
+
+pthread_mutex_lock( &cache->lock ) ;
+
+entry = find_cache_entry( cache, p, n ) ;
+++entry->users ;
+
+while (entry->first_state == WORKING)
+    pthread_cond_wait( &cache->changed, &cache->lock ) ;
+
+if (entry->first_state == NOTSTARTED)
+{
+    entry->first_state = WORKING ;
+    pthread_mutex_unlock( &cache->lock ) ;
+
+    status = primpoly_find( &context, f ) ;
+
+    pthread_mutex_lock( &cache->lock ) ;
+    memcpy( entry->first, f, (size_t) (n + 1) * sizeof( int ) ) ;
+    entry->first_status = status ;
+    entry->first_state  = FINISHED ;
+    pthread_cond_broadcast( &cache->changed ) ;
+}
+
+memcpy( f, entry->first, (size_t) (n + 1) * sizeof( int ) ) ;
+status = entry->first_status ;
+--entry->users ;
+
+pthread_mutex_unlock( &cache->lock ) ;
+
+return status ;
+
+} /* ============== end of function cached_first_primitive ================== */
+
+
+
+/*==============================================================================
+|                        claim_answer, finish_answer                           |
+================================================================================
+
+DESCRIPTION
+
+     Look up the answer to a list or test query, or take on the job of
+     finding it.  When several threads ask the same thing at once, one
+     answers and the others wait for it, as in cached_first_primitive.
+
+INPUT
+
+     p, n (int)                  Already checked, e.g. by cached_context.
+     key (const char *)          The rest of the query, e.g. "list 5".
+
+     text (const char *)         The answer, to finish_answer ...
+     keep (int)                  ... and NO if it's a passing error, e.g.
+                                 out of memory, so no one else gets it
+                                 from the cache later.
+
+OUTPUT
+
+     claimed (CachedAnswer **)   Set when claim_answer returns null:  the
+                                 caller must work out the answer, then
+                                 hand it to finish_answer, even if it's
+                                 an error, since others may be waiting.
+
+RETURNS
+
+     A copy of the answer, which the caller must free(), or null if it's
+     the caller's job to find it.
+
+METHOD
+
+     Each p and n keeps its CACHEDANSWERS most recent answers, less any
+     longer than MAXCACHEDANSWER, which are kept only until everyone
+     waiting for them has a copy.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static char * claim_answer( QueryCache * cache, int p, int n, const char * key,
+                            CachedAnswer ** claimed )
+{
+CacheEntry    * entry ;
+CachedAnswer  * answer ;
+CachedAnswer ** link ;
+CachedAnswer ** oldest_unused ;
+char          * text = (char *) 0 ;
+
+pthread_mutex_lock( &cache->lock ) ;
+
+entry = find_cache_entry( cache, p, n ) ;
+
+for (answer = entry->answers ;  answer != (CachedAnswer *) 0 ;  answer = answer->next)
+    if (strcmp( answer->key, key ) == 0)
+        break ;
+
+if (answer == (CachedAnswer *) 0)
+{
+    /*  Make room by dropping the oldest answer nobody is waiting for. */
+    if (entry->num_answers >= CACHEDANSWERS)
+    {
+        for (link = &entry->answers, oldest_unused = (CachedAnswer **) 0 ;
+             *link != (CachedAnswer *) 0 ;  link = &(*link)->next)
+            if ((*link)->users == 0)
+                oldest_unused = link ;
+
+        if (oldest_unused != (CachedAnswer **) 0)
+        {
+            answer         = *oldest_unused ;
+            *oldest_unused = answer->next ;
+            --entry->num_answers ;
+            free( answer->key ) ;
+            free( answer->text ) ;
+            free( answer ) ;
+        }
+    }
+
+    answer = (CachedAnswer *) calloc( 1, sizeof( CachedAnswer ) ) ;
+
+    if (answer == (CachedAnswer *) 0 || (answer->key = strdup( key )) == (char *) 0)
+    {
+        printf( "ERROR:  Not enough memory for the query cache.\n\n" ) ;
+        exit( 1 ) ;
+    }
+
+    answer->entry  = entry ;
+    answer->next   = entry->answers ;
+    entry->answers = answer ;
+    ++entry->num_answers ;
+}
+
+/*  Both stay put while we count ourselves in them. */
+++entry->users ;
+++answer->users ;
+
+while (answer->state == WORKING)
+    pthread_cond_wait( &cache->changed, &cache->lock ) ;
+
+if (answer->state == NOTSTARTED)
+{
+    answer->state = WORKING ;
+    *claimed      = answer ;
+}
+else
+{
+    if ((text = strdup( answer->text )) == (char *) 0)
+    {
+        printf( "ERROR:  Not enough memory for an answer.\n\n" ) ;
+        exit( 1 ) ;
+    }
+
+    release_answer( answer ) ;
+}
+
+pthread_mutex_unlock( &cache->lock ) ;
+
+return text ;
+
+} /* ================== end of function claim_answer ======================== */
+
+
+static void finish_answer( QueryCache * cache, CachedAnswer * answer, const char * text,
+                           int keep )
+{
+pthread_mutex_lock( &cache->lock ) ;
+
+if ((answer->text = strdup( text )) == (char *) 0)
+{
+    printf( "ERROR:  Not enough memory for an answer.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+answer->keep  = (keep && strlen( text ) <= MAXCACHEDANSWER) ? YES : NO ;
+answer->state = FINISHED ;
+pthread_cond_broadcast( &cache->changed ) ;
+
+release_answer( answer ) ;
+
+pthread_mutex_unlock( &cache->lock ) ;
+
+} /* ================== end of function finish_answer ======================= */
+
+
+
+/*==============================================================================
+|                               release_answer                                 |
+================================================================================
+
+DESCRIPTION
+
+     We're done with an answer.  If it was too long to keep and nobody
+     else wants it, drop it.  The caller must hold the cache lock.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void release_answer( CachedAnswer * answer )
+{
+CacheEntry    * entry = answer->entry ;
+CachedAnswer ** link ;
+
+--entry->users ;
+
+if (--answer->users == 0 && !answer->keep)
+{
+    for (link = &entry->answers ;  *link != answer ;  link = &(*link)->next)
+        ;
+
+    *link = answer->next ;
+    --entry->num_answers ;
+    free( answer->key ) ;
+    free( answer->text ) ;
+    free( answer ) ;
+}
+
+} /* ================= end of function release_answer ======================= */
+
+
+
+/*==============================================================================
+|                                answer_query                                  |
+================================================================================
+
+DESCRIPTION
+
+     Answer one query.
+
+INPUT
+
+     cache (QueryCache *)    Shared with other threads.
+     query (char *)          One line, as described at the top of this file.
+
+RETURNS
+
+     The answer, without the query or the newline, in a string the caller
+     must free().  Errors start with ERROR.
+
+EXAMPLE
+
+     answer_query( cache, "list 2 4 5" ) returns "1,0,0,1,1 1,1,0,0,1".
+
+METHOD
+
+     Parse the line, get the context from the cache, and call the library.
+     list stops after limit polynomials.  The answers to find, list and
+     test are kept in the cache, so asking again costs nothing, and two
+     threads asking at once do the work only once.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+char * answer_query( QueryCache * cache, const char * query )
+{
+char              command[ 16 ] ;
+char              extra[ 2 ] ;
+int               p, n, num_read, offset = 0, num_coeffs, coeff, is_primitive, status ;
+int               f[ MAXDEGPOLY + 1 ] ;
+int             * buffer ;
+bigint            limit = 0, num_found, k ;
+char              number[ 64 ] ;
+char              message[ 96 ] ;
+const char      * rest ;
+char            * cached ;
+PrimpolyContext   context ;
+Answer            answer = { (char *) 0, 0, 0 } ;
+Answer            key    = { (char *) 0, 0, 0 } ;  /* For the cached answer. */
+CachedAnswer    * claimed = (CachedAnswer *) 0 ;
+int               keep = YES ;
+
+append_answer( &answer, "" ) ;
+
+num_read = sscanf( query, "%15s %d %d %n", command, &p, &n, &offset ) ;
+
+if (num_read < 3)
+{
+    append_answer( &answer, "ERROR expecting a command, p and n" ) ;
+    return answer.text ;
+}
+
+rest = query + offset ;
+
+if (strcmp( command, "find" ) == 0)
+{
+    if ((status = cached_first_primitive( cache, p, n, f )) == PP_OK)
+        append_poly( &answer, f, n ) ;
+}
+else if (strcmp( command, "count" ) == 0)
+{
+    if ((status = cached_context( cache, p, n, &context )) == PP_OK)
+    {
+        append_answer( &answer, bigint_string( context.num_prim_poly ) ) ;
+    }
+}
+else if (strcmp( command, "test" ) == 0)
+{
+    if ((status = cached_context( cache, p, n, &context )) == PP_OK)
+    {
+        /* Coefficients from x ^ n down, separated by commas.  Count them
+           all, so that too many or too few is what we complain about. */
+        for (num_coeffs = 0 ;  sscanf( rest, "%d%n", &coeff, &offset ) == 1 ;  )
+        {
+            if (num_coeffs <= n)
+                f[ n - num_coeffs ] = coeff ;
+
+            ++num_coeffs ;
+            rest += offset ;
+
+            if (*rest != ',')
+                break ;
+
+            ++rest ;
+        }
+
+        if (num_coeffs != n + 1)
+        {
+            sprintf( message, "ERROR expecting %d coefficients, from x ^ %d down", n + 1, n ) ;
+            append_answer( &answer, message ) ;
+            return answer.text ;
+        }
+
+        if (sscanf( rest, " %1s", extra ) == 1)
+        {
+            append_answer( &answer, "ERROR expecting coefficients separated by commas" ) ;
+            return answer.text ;
+        }
+
+        /* Someone may have asked already. */
+        append_answer( &key, "test " ) ;
+        append_poly( &key, f, n ) ;
+
+        if ((cached = claim_answer( cache, p, n, key.text, &claimed )) != (char *) 0)
+        {
+            free( key.text ) ;
+            free( answer.text ) ;
+            return cached ;
+        }
+
+        if ((status = primpoly_test( &context, f, &is_primitive )) == PP_OK)
+            append_answer( &answer, is_primitive ? "YES" : "NO" ) ;
+    }
+}
+else if (strcmp( command, "list" ) == 0)
+{
+    if (sscanf( rest, "%63s", number ) != 1 || !string_to_bigint( number, &limit ) || limit == 0)
+    {
+        append_answer( &answer, "ERROR expecting a limit of 1 or more" ) ;
+        return answer.text ;
+    }
+
+    if ((status = cached_context( cache, p, n, &context )) == PP_OK)
+    {
+        if (limit > context.num_prim_poly)
+            limit = context.num_prim_poly ;
+
+        /* Someone may have asked already. */
+        append_answer( &key, "list " ) ;
+        append_answer( &key, bigint_string( limit ) ) ;
+
+        if ((cached = claim_answer( cache, p, n, key.text, &claimed )) != (char *) 0)
+        {
+            free( key.text ) ;
+            free( answer.text ) ;
+            return cached ;
+        }
+
+        buffer = (int *) malloc( (size_t) limit * (size_t) (n + 1) * sizeof( int ) ) ;
+
+        if (buffer == (int *) 0)
+        {
+            /* Maybe there's room next time. */
+            append_answer( &answer, "ERROR not enough memory for the list" ) ;
+            keep = NO ;
+        }
+        else
+        {
+            status = primpoly_list( &context, buffer, limit, &num_found ) ;
+
+            /* Stopping at the limit is what we asked for. */
+            if (status == PP_STOPPED)
+                status = PP_OK ;
+
+            for (k = 0 ;  k < num_found ;  ++k)
+            {
+                if (k > 0)
+                    append_answer( &answer, " " ) ;
+                append_poly( &answer, buffer + k * (bigint) (n + 1), n ) ;
+            }
+
+            free( buffer ) ;
+        }
+    }
+}
+else
+{
+    append_answer( &answer, "ERROR unknown command " ) ;
+    append_answer( &answer, command ) ;
+    return answer.text ;
+}
+
+if (status != PP_OK)
+{
+    append_answer( &answer, "ERROR " ) ;
+    append_answer( &answer, primpoly_error_string( status ) ) ;
+}
+
+/* Pass it on to anyone waiting, and keep it for next time. */
+if (claimed != (CachedAnswer *) 0)
+    finish_answer( cache, claimed, answer.text, keep ) ;
+
+free( key.text ) ;
+
+return answer.text ;
+
+} /* =================== end of function answer_query ======================= */
+
+
+
+/*==============================================================================
+|                                  run_batch                                   |
+================================================================================
+
+DESCRIPTION
+
+     Answer all the queries in a file.
+
+INPUT
+
+     file_name (char *)      The queries, or - for standard input.
+     num_threads (int)       How many queries to work on at once.
+
+OUTPUT
+
+     Standard output         The answers, in the order of the queries.
+
+RETURNS
+
+     0 if all went well, 1 if we couldn't read the file.
+
+METHOD
+
+     A reader thread reads the queries into the slots, staying at most
+     BATCHQUEUE ahead of what we've printed.  The workers each take the
+     next query as soon as it's read, so we can start answering before
+     the end of the file, which for standard input may be a long way off.
+     Meanwhile we print the answers in order, waiting for each one as
+     needed, and hand its slot back to the reader.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int run_batch( char * file_name, int num_threads )
+{
+Batch     * batch ;
+BatchSlot * slot ;
+pthread_t   reader ;
+pthread_t * threads ;
+char      * query ;
+char      * answer ;
+int         i ;
+
+batch   = (Batch *) calloc( 1, sizeof( Batch ) ) ;
+threads = (pthread_t *) calloc( (size_t) num_threads, sizeof( pthread_t ) ) ;
+
+if (batch == (Batch *) 0 || threads == (pthread_t *) 0)
+{
+    printf( "ERROR:  Not enough memory for the batch.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (strcmp( file_name, "-" ) == 0)
+    batch->fp = stdin ;
+else if ((batch->fp = fopen( file_name, "r" )) == (FILE *) 0)
+{
+    printf( "ERROR:  Can't open the batch file %s\n\n", file_name ) ;
+    free( batch ) ;
+    free( threads ) ;
+    return 1 ;
+}
+
+batch->cache = create_query_cache() ;
+pthread_mutex_init( &batch->lock, (pthread_mutexattr_t *) 0 ) ;
+pthread_cond_init( &batch->changed, (pthread_condattr_t *) 0 ) ;
+
+pthread_create( &reader, (pthread_attr_t *) 0, batch_reader, batch ) ;
+
+for (i = 0 ;  i < num_threads ;  ++i)
+    pthread_create( &threads[ i ], (pthread_attr_t *) 0, batch_worker, batch ) ;
+
+for (i = 0 ;  ;  ++i)
+{
+    slot = &batch->slot[ i % BATCHQUEUE ] ;
+
+    pthread_mutex_lock( &batch->lock ) ;
+    while (i < batch->num_queries ? slot->answer == (char *) 0
+                                  : !batch->done_reading)
+        pthread_cond_wait( &batch->changed, &batch->lock ) ;
+
+    if (i == batch->num_queries)
+    {
+        pthread_mutex_unlock( &batch->lock ) ;
+        break ;
+    }
+
+    query  = slot->query ;
+    answer = slot->answer ;
+    pthread_mutex_unlock( &batch->lock ) ;
+
+    printf( "%d %s : %s\n", i + 1, query, answer ) ;
+
+    /*  Whoever sent the queries may be waiting for this answer before
+        sending the next. */
+    fflush( stdout ) ;
+
+    free( query ) ;
+    free( answer ) ;
+
+    pthread_mutex_lock( &batch->lock ) ;
+    slot->query  = (char *) 0 ;
+    slot->answer = (char *) 0 ;
+    ++batch->num_printed ;
+    pthread_cond_broadcast( &batch->changed ) ;
+    pthread_mutex_unlock( &batch->lock ) ;
+}
+
+pthread_join( reader, (void **) 0 ) ;
+
+for (i = 0 ;  i < num_threads ;  ++i)
+    pthread_join( threads[ i ], (void **) 0 ) ;
+
+if (batch->fp != stdin)
+    fclose( batch->fp ) ;
+
+pthread_mutex_destroy( &batch->lock ) ;
+pthread_cond_destroy( &batch->changed ) ;
+free_query_cache( batch->cache ) ;
+free( batch ) ;
+free( threads ) ;
+
+return 0 ;
+
+} /* ===================== end of function run_batch ======================== */
+
+
+
+/*==============================================================================
+|                                batch_reader                                  |
+================================================================================
+
+DESCRIPTION
+
+     Thread which reads the queries of the batch into free slots, waiting
+     for one when all BATCHQUEUE of them are in use.
+
+METHOD
+
+     A line which doesn't fit in MAXQUERYLENGTH characters is kept as a
+     query of its first 40 characters, marked too long, and the rest of
+     it is skipped.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void * batch_reader( void * arg )
+{
+Batch     * batch = (Batch *) arg ;
+BatchSlot * slot ;
+char        line[ MAXQUERYLENGTH + 2 ] ;
+char      * start ;
+char      * query ;
+int         length, too_long, c ;
+
+while (fgets( line, sizeof( line ), batch->fp ) != (char *) 0)
+{
+    length   = (int) strcspn( line, "\r\n" ) ;
+    too_long = (line[ length ] == '\0' && !feof( batch->fp )) ;
+
+    if (too_long)
+    {
+        while ((c = getc( batch->fp )) != EOF && c != '\n')
+            ;
+
+        line[ MAXQUERYLENGTH ] = '\0' ;
+    }
+
+    for (start = line ;  *start == ' ' || *start == '\t' ;  ++start)
+        ;
+
+    length = (int) strcspn( start, "\r\n" ) ;
+    start[ length ] = '\0' ;
+
+    if (length == 0 || start[ 0 ] == '#')
+        continue ;
+
+    /*  Enough of a long line to tell which one it was. */
+    if (too_long && length > 40)
+    {
+        strcpy( start + 40, "..." ) ;
+        length = 43 ;
+    }
+
+    if ((query = (char *) malloc( (size_t) length + 1 )) == (char *) 0)
+    {
+        printf( "ERROR:  Not enough memory for the batch.\n\n" ) ;
+        exit( 1 ) ;
+    }
+
+    strcpy( query, start ) ;
+
+    pthread_mutex_lock( &batch->lock ) ;
+    while (batch->num_queries - batch->num_printed == BATCHQUEUE)
+        pthread_cond_wait( &batch->changed, &batch->lock ) ;
+
+    slot = &batch->slot[ batch->num_queries % BATCHQUEUE ] ;
+    slot->query    = query ;
+    slot->too_long = too_long ;
+    ++batch->num_queries ;
+    pthread_cond_broadcast( &batch->changed ) ;
+    pthread_mutex_unlock( &batch->lock ) ;
+}
+
+pthread_mutex_lock( &batch->lock ) ;
+batch->done_reading = YES ;
+pthread_cond_broadcast( &batch->changed ) ;
+pthread_mutex_unlock( &batch->lock ) ;
+
+return (void *) 0 ;
+
+} /* ==================== end of function batch_reader ====================== */
+
+
+
+/*==============================================================================
+|                                batch_worker                                  |
+================================================================================
+
+DESCRIPTION
+
+     Thread which answers queries from the batch as they're read, until
+     there are none left.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void * batch_worker( void * arg )
+{
+Batch     * batch = (Batch *) arg ;
+BatchSlot * slot ;
+Answer      error ;
+char      * answer ;
+char        number[ 32 ] ;
+
+for (;;)
+{
+    pthread_mutex_lock( &batch->lock ) ;
+    while (batch->next_query == batch->num_queries && !batch->done_reading)
+        pthread_cond_wait( &batch->changed, &batch->lock ) ;
+
+    if (batch->next_query == batch->num_queries)
+    {
+        pthread_mutex_unlock( &batch->lock ) ;
+        break ;
+    }
+
+    /*  The slot can't be reused until we've answered it and it's printed. */
+    slot = &batch->slot[ batch->next_query++ % BATCHQUEUE ] ;
+    pthread_mutex_unlock( &batch->lock ) ;
+
+    if (slot->too_long)
+    {
+        error.text   = (char *) 0 ;
+        error.length = error.capacity = 0 ;
+
+        sprintf( number, "%d", MAXQUERYLENGTH ) ;
+        append_answer( &error, "ERROR query longer than " ) ;
+        append_answer( &error, number ) ;
+        append_answer( &error, " characters" ) ;
+        answer = error.text ;
+    }
+    else
+        answer = answer_query( batch->cache, slot->query ) ;
+
+    pthread_mutex_lock( &batch->lock ) ;
+    slot->answer = answer ;
+    pthread_cond_broadcast( &batch->changed ) ;
+    pthread_mutex_unlock( &batch->lock ) ;
+}
+
+return (void *) 0 ;
+
+} /* ==================== end of function batch_worker ====================== */
+
+
+
+/*==============================================================================
+|                          append_answer, append_poly                          |
+================================================================================
+
+DESCRIPTION
+
+     Add a string, or a polynomial's coefficients from x ^ n down separated
+     by commas, to the end of an answer.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void append_answer( Answer * answer, const char * s )
+{
+size_t length = strlen( s ), capacity ;
+char * text ;
+
+if (answer->length + length + 1 > answer->capacity)
+{
+    capacity = 2 * (answer->length + length + 1) + 64 ;
+    text     = (char *) realloc( answer->text, capacity ) ;
+
+    if (text == (char *) 0)
+    {
+        printf( "ERROR:  Not enough memory for an answer.\n\n" ) ;
+        exit( 1 ) ;
+    }
+
+    answer->text     = text ;
+    answer->capacity = capacity ;
+}
+
+memcpy( answer->text + answer->length, s, length + 1 ) ;
+answer->length += length ;
+
+} /* =================== end of function append_answer ====================== */
+
+
+static void append_poly( Answer * answer, const int * f, int n )
+{
+char number[ 16 ] ;
+int  i ;
+
+for (i = n ;  i >= 0 ;  --i)
+{
+    sprintf( number, (i > 0) ? "%d," : "%d", f[ i ] ) ;
+    append_answer( answer, number ) ;
+}
+
+} /* ==================== end of function append_poly ======================= */
@@ -0,0 +1,694 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppBench.c
+|
+|  Description:
+|
+|     Benchmark the search and the arithmetic it is built from over a fixed
+|     set of p and n, save the results, and compare them with saved ones.
+|
+|  Functions:
+|
+|     run_bench
+|     bench_one
+|     run_kernel
+|     time_kernel
+|     count_kernel
+|     add_result
+|     read_baseline
+|     compare_doubles
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  RESULTS
+|
+|     One per line, the same on the screen and in a baseline file:
+|
+|         p  n  name  value
+|
+|     where name is one of
+|
+|         square_ns ... factor_ns   Nanoseconds per call of the kernel.
+|         square_cycles ...         With --counters, hardware counts per
+|                                   call:  _cycles, _instructions,
+|                                   _l1d_misses, _llc_misses and
+|                                   _branch_misses.
+|         candidates_per_sec        Trial polynomials tested per second.
+|         reject_const_coeff ...    Fraction of the trial polynomials
+|                                   reaching a stage which it rejects.
+|
+|     Lines starting with # are comments.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+#define SQUAREKERNEL     0   /*  The kernels we time.  */
+#define PRODUCTKERNEL    1
+#define XTOPOWERKERNEL   2
+#define POWERTABLEKERNEL 3
+#define NULLITYKERNEL    4
+#define FACTORKERNEL     5
+#define NUMKERNELS       6
+
+#define MAXBENCHRESULTS 1024
+
+static const char * kernel_name[ NUMKERNELS ] =
+{
+    "square",
+    "product",
+    "x_to_power",
+    "construct_power_table",
+    "find_nullity",
+    "factor"
+} ;
+
+/*  The p and n we benchmark unless told otherwise:  small and large n for
+    p = 2, which is what most people want, and a spread of larger p. */
+static const int bench_grid[][ 2 ] =
+{
+    {   2, 16 }, {   2, 32 }, {   2, 62 }, {   3, 20 },
+    {   5, 13 }, {   7, 11 }, {  31,  6 }, { 251,  4 }
+} ;
+
+/*  Everything the kernels work on for one p and n. */
+typedef struct
+{
+    int    p ;
+    int    n ;
+    bigint r ;
+    bigint primes[ MAXNUMPRIMEFACTORS ] ;
+    int    count[ MAXNUMPRIMEFACTORS ] ;
+    int    prime_count ;
+    int    f[ MAXDEGPOLY + 1 ] ;     /* A primitive polynomial.             */
+    int    power_table[ MAXDEGPOLY - 1 ][ MAXDEGPOLY ] ;
+    int    s[ MAXDEGPOLY ] ;         /* Scratch polynomials.                */
+    int    t[ MAXDEGPOLY ] ;
+    int    Q_saved[ MAXDEGPOLY ][ MAXDEGPOLY ] ; /* Berlekamp matrix of f.  */
+    int    Q_space[ MAXDEGPOLY ][ MAXDEGPOLY ] ;
+    int  * Q[ MAXDEGPOLY ] ;
+} BenchSetup ;
+
+/*  One measurement. */
+typedef struct
+{
+    int    p ;
+    int    n ;
+    char   name[ 32 ] ;
+    double value ;
+} BenchResult ;
+
+
+static void   bench_one    ( BenchSetup * b, BenchResult * results, int * num_results ) ;
+static bigint run_kernel   ( BenchSetup * b, int kernel, bigint iterations ) ;
+static double time_kernel  ( BenchSetup * b, int kernel ) ;
+static void   count_kernel ( BenchSetup * b, int kernel, double ns_per_call, double * per_call ) ;
+static void   add_result   ( BenchResult * results, int * num_results, int p, int n,
+                             const char * name, double value ) ;
+static int    read_baseline( char * file_name, BenchResult * results, int * num_results ) ;
+static int    compare_doubles( const void * a, const void * b ) ;
+
+
+/*==============================================================================
+|                                  run_bench                                   |
+================================================================================
+
+DESCRIPTION
+
+     Benchmark the kernels and the search, print the results, and save
+     them or compare them with a baseline.
+
+INPUT
+
+     p, n (int)               Benchmark just this p and n, or the whole
+                              built in grid if p is 0.
+     baseline_file (char *)   Save the results here, if not null.
+     compare_file (char *)    Compare with the results saved here, if not
+                              null.
+
+OUTPUT
+
+     Standard output          The results, and with compare_file, the
+                              change in each and which are regressions.
+
+RETURNS
+
+     0, or 1 if some result is more than BENCHTOLERANCE percent worse than
+     its baseline, or we couldn't read or write a file.
+
+EXAMPLE
+
+     pp --bench --baseline before.txt
+     ... change ppPolyArith.c and rebuild ...
+     pp --bench --compare before.txt
+
+METHOD
+
+     Each kernel is first run with doubling numbers of calls until one
+     run takes a tenth of BENCHSAMPLENANOSEC, which also warms up the
+     caches.  Then BENCHSAMPLES runs of about BENCHSAMPLENANOSEC each are
+     timed, and the median time per call is the result.  The search tests
+     the first BENCHCANDIDATES trial polynomials in order, once to warm up
+     and BENCHSAMPLES more times, and we report the median rate.
+
+BUGS
+
+     Timings on a busy machine vary.  Compare runs on the same quiet
+     machine, and repeat a run which flags a regression before believing
+     it.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int run_bench( int p, int n, char * baseline_file, char * compare_file )
+{
+BenchSetup  * b ;
+BenchResult * results ;
+BenchResult * baseline ;
+FILE        * fp ;
+int           num_results = 0, num_baseline = 0, i, j, k, status = 0 ;
+int           num_grid = (int) (sizeof( bench_grid ) / sizeof( bench_grid[ 0 ] )) ;
+double        change ;
+
+b        = (BenchSetup *)  calloc( 1, sizeof( BenchSetup ) ) ;
+results  = (BenchResult *) calloc( MAXBENCHRESULTS, sizeof( BenchResult ) ) ;
+baseline = (BenchResult *) calloc( MAXBENCHRESULTS, sizeof( BenchResult ) ) ;
+
+if (b == (BenchSetup *) 0 || results == (BenchResult *) 0 || baseline == (BenchResult *) 0)
+{
+    printf( "ERROR:  Not enough memory for the benchmark.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+if (compare_file != (char *) 0 && !read_baseline( compare_file, baseline, &num_baseline ))
+{
+    printf( "ERROR:  Can't read the baseline file %s\n\n", compare_file ) ;
+    return 1 ;
+}
+
+printf( "#   p  n  name                                value\n" ) ;
+
+for (i = 0 ;  i < ((p == 0) ? num_grid : 1) ;  ++i)
+{
+    b->p = (p == 0) ? bench_grid[ i ][ 0 ] : p ;
+    b->n = (p == 0) ? bench_grid[ i ][ 1 ] : n ;
+
+    k = num_results ;
+    bench_one( b, results, &num_results ) ;
+
+    for ( ;  k < num_results ;  ++k)
+    {
+        printf( "%5d %2d  %-28s %14.4f", results[ k ].p, results[ k ].n,
+                results[ k ].name, results[ k ].value ) ;
+
+        for (j = 0 ;  j < num_baseline ;  ++j)
+            if (baseline[ j ].p == results[ k ].p && baseline[ j ].n == results[ k ].n &&
+                strcmp( baseline[ j ].name, results[ k ].name ) == 0)
+                break ;
+
+        if (j < num_baseline)
+        {
+            /*  Rejection rates don't depend on speed;  any change means the
+                search tests something different. */
+            if (strncmp( results[ k ].name, "reject_", 7 ) == 0)
+            {
+                if (results[ k ].value - baseline[ j ].value > 1.0e-6 ||
+                    baseline[ j ].value - results[ k ].value > 1.0e-6)
+                {
+                    printf( "   was %.4f  CHANGED", baseline[ j ].value ) ;
+                    status = 1 ;
+                }
+            }
+            else if (baseline[ j ].value > 0.0 && results[ k ].value > 0.0)
+            {
+                /*  Percent worse:  more time per call, or fewer per second. */
+                if (strcmp( results[ k ].name, "candidates_per_sec" ) == 0)
+                    change = 100.0 * (baseline[ j ].value / results[ k ].value - 1.0) ;
+                else
+                    change = 100.0 * (results[ k ].value / baseline[ j ].value - 1.0) ;
+
+                printf( "   was %14.4f  %+6.1f%% %s", baseline[ j ].value, change,
+                        (change >  BENCHTOLERANCE) ? "REGRESSION" :
+                        (change < -BENCHTOLERANCE) ? "faster" : "" ) ;
+
+                if (change > BENCHTOLERANCE)
+                    status = 1 ;
+            }
+        }
+
+        printf( "\n" ) ;
+        fflush( stdout ) ;
+    }
+}
+
+if (baseline_file != (char *) 0)
+{
+    if ((fp = fopen( baseline_file, "w" )) == (FILE *) 0)
+    {
+        printf( "ERROR:  Can't write the baseline file %s\n\n", baseline_file ) ;
+        return 1 ;
+    }
+
+    fprintf( fp, "# Primpoly benchmark baseline:  p n name value\n" ) ;
+
+    for (k = 0 ;  k < num_results ;  ++k)
+        fprintf( fp, "%d %d %s %.10g\n", results[ k ].p, results[ k ].n,
+                 results[ k ].name, results[ k ].value ) ;
+
+    if (fclose( fp ) != 0)
+    {
+        printf( "ERROR:  Can't write the baseline file %s\n\n", baseline_file ) ;
+        return 1 ;
+    }
+}
+
+free( b ) ;
+free( results ) ;
+free( baseline ) ;
+
+return status ;
+
+} /* ===================== end of function run_bench ======================== */
+
+
+
+/*==============================================================================
+|                                  bench_one                                   |
+================================================================================
+
+DESCRIPTION
+
+     Benchmark every kernel and the search for one p and n.
+
+INPUT
+
+     b (BenchSetup *)        b->p and b->n set.
+
+OUTPUT
+
+     results, num_results    The new results added at the end.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void bench_one( BenchSetup * b, BenchResult * results, int * num_results )
+{
+PrimpolyContext  context ;
+SearchStatistics stats ;
+int              f[ MAXDEGPOLY + 1 ] ;
+double           rate[ BENCHSAMPLES ] ;
+double           ns_per_call, per_call[ NUMHWCOUNTERS ] ;
+bigint           num_candidates, k, start, passed[ NUMSTAGES ] ;
+int              i, c, sample, stage, status ;
+char             name[ 32 ] ;
+
+static const char * stage_name[ NUMSTAGES ] =
+{
+    "", "const_coeff", "linear_factor", "berlekamp", "order_r", "const_test", "order_m"
+} ;
+
+if ((status = primpoly_init( &context, b->p, b->n )) != PP_OK ||
+    (status = primpoly_find( &context, b->f )) != PP_OK)
+{
+    printf( "ERROR:  Can't benchmark p = %d, n = %d:  %s\n\n", b->p, b->n,
+            primpoly_error_string( status ) ) ;
+    exit( 1 ) ;
+}
+
+b->r           = context.r ;
+b->prime_count = context.prime_count ;
+memcpy( b->primes, context.primes, sizeof( b->primes ) ) ;
+
+/*  Set up the operands:  the power table of a primitive f(x), and
+    s = t = x ^ n (mod f(x), p), which is not a trivial element.  */
+construct_power_table( b->power_table, b->f, b->n, b->p ) ;
+
+for (i = 0 ;  i < b->n ;  ++i)
+    b->s[ i ] = b->t[ i ] = b->power_table[ 0 ][ i ] ;
+
+memset( b->Q_saved, 0, sizeof( b->Q_saved ) ) ;
+
+for (i = 0 ;  i < b->n ;  ++i)
+    b->Q[ i ] = b->Q_saved[ i ] ;
+
+generate_Q_matrix( b->Q, b->power_table, b->n, b->p ) ;
+
+for (i = 0 ;  i < b->n ;  ++i)
+    b->Q[ i ] = b->Q_space[ i ] ;
+
+for (i = 0 ;  i < NUMKERNELS ;  ++i)
+{
+    ns_per_call = time_kernel( b, i ) ;
+
+    sprintf( name, "%s_ns", kernel_name[ i ] ) ;
+    add_result( results, num_results, b->p, b->n, name, ns_per_call ) ;
+
+    /*  With --counters, the counts per call too. */
+    if (hardware_counters_enabled())
+    {
+        count_kernel( b, i, ns_per_call, per_call ) ;
+
+        for (c = 0 ;  c < NUMHWCOUNTERS ;  ++c)
+        {
+            if (!hardware_counter_available( c ))
+                continue ;
+
+            sprintf( name, "%s_%s", kernel_name[ i ], hardware_counter_name( c ) ) ;
+            add_result( results, num_results, b->p, b->n, name, per_call[ c ] ) ;
+        }
+    }
+}
+
+
+/*  The whole search over the first trial polynomials, timed a sample at a
+    time.  The first run warms up and gives the rejection counts. */
+num_candidates = context.max_num_poly + 1 ;
+if (num_candidates > BENCHCANDIDATES)
+    num_candidates = BENCHCANDIDATES ;
+
+for (sample = -1 ;  sample < BENCHSAMPLES ;  ++sample)
+{
+    memset( &stats, 0, sizeof( stats ) ) ;
+    initial_trial_poly( f, b->n ) ;
+
+    start = stage_clock() ;
+
+    for (k = 0 ;  k < num_candidates ;  ++k)
+    {
+        next_trial_poly( f, b->n, b->p ) ;
+        ++stats.num_poly ;
+        passes_primitivity_tests( f, b->n, b->p, b->r, b->primes, b->prime_count, &stats ) ;
+    }
+
+    if (sample >= 0)
+        rate[ sample ] = (double) num_candidates * 1.0e9 / (double) (stage_clock() - start + 1) ;
+}
+
+qsort( rate, BENCHSAMPLES, sizeof( double ), compare_doubles ) ;
+add_result( results, num_results, b->p, b->n, "candidates_per_sec", rate[ BENCHSAMPLES / 2 ] ) ;
+
+passed[ POWERTABLESTAGE ] = stats.num_poly ;
+passed[ CONSTCOEFFSTAGE ] = stats.num_const_coeff_prim_root ;
+passed[ LINEARSTAGE     ] = stats.num_free_of_linear_factors ;
+passed[ BERLEKAMPSTAGE  ] = stats.num_irred_to_power ;
+passed[ ORDERRSTAGE     ] = stats.num_order_r ;
+passed[ CONSTTESTSTAGE  ] = stats.num_passing_const_coeff_test ;
+passed[ ORDERMSTAGE     ] = stats.num_order_m ;
+
+/*  The power table rejects nothing;  it's only there for the others. */
+for (stage = CONSTCOEFFSTAGE ;  stage < NUMSTAGES ;  ++stage)
+{
+    sprintf( name, "reject_%s", stage_name[ stage ] ) ;
+    add_result( results, num_results, b->p, b->n, name,
+                (passed[ stage - 1 ] == 0) ? 0.0 :
+                1.0 - (double) passed[ stage ] / (double) passed[ stage - 1 ] ) ;
+}
+
+} /* ===================== end of function bench_one ======================== */
+
+
+
+/*==============================================================================
+|                                 run_kernel                                   |
+================================================================================
+
+DESCRIPTION
+
+     Call a kernel over and over and time it.
+
+INPUT
+
+     b (BenchSetup *)        Operands from bench_one.
+     kernel (int)            Which one, e.g. SQUAREKERNEL.
+     iterations (bigint)     How many calls.
+
+RETURNS
+
+     How long the calls took in nanoseconds.
+
+METHOD
+
+     square and product keep working on their own results, as they do
+     in x_to_power, so the compiler can't skip any calls.  find_nullity
+     destroys its matrix, so each call first gets a fresh copy;  the copy
+     is counted in the time, but takes only n^2 moves against the n^3 of
+     the elimination.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static bigint run_kernel( BenchSetup * b, int kernel, bigint iterations )
+{
+int    g[ MAXDEGPOLY ] ;
+int    count[ MAXNUMPRIMEFACTORS ] ;
+bigint primes[ MAXNUMPRIMEFACTORS ] ;
+bigint start = stage_clock(), k ;
+int    row ;
+
+for (k = 0 ;  k < iterations ;  ++k)
+{
+    switch( kernel )
+    {
+        case SQUAREKERNEL:
+            square( b->t, b->power_table, b->n, b->p ) ;
+        break ;
+
+        case PRODUCTKERNEL:
+            product( b->s, b->t, b->power_table, b->n, b->p ) ;
+        break ;
+
+        case XTOPOWERKERNEL:
+            x_to_power( b->r, g, b->power_table, b->n, b->p ) ;
+        break ;
+
+        case POWERTABLEKERNEL:
+            construct_power_table( b->power_table, b->f, b->n, b->p ) ;
+        break ;
+
+        case NULLITYKERNEL:
+            for (row = 0 ;  row < b->n ;  ++row)
+                memcpy( b->Q[ row ], b->Q_saved[ row ], (size_t) b->n * sizeof( int ) ) ;
+
+            find_nullity( b->Q, b->n, b->p ) ;
+        break ;
+
+        case FACTORKERNEL:
+            factor( b->r, primes, count ) ;
+        break ;
+    }
+}
+
+return stage_clock() - start ;
+
+} /* ===================== end of function run_kernel ======================= */
+
+
+
+/*==============================================================================
+|                                time_kernel                                   |
+================================================================================
+
+DESCRIPTION
+
+     Measure the time per call of a kernel, as described in run_bench.
+
+RETURNS
+
+     The median over BENCHSAMPLES samples of the nanoseconds per call.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static double time_kernel( BenchSetup * b, int kernel )
+{
+double ns_per_call[ BENCHSAMPLES ] ;
+bigint iterations = 1, elapsed ;
+int    sample ;
+
+/*  Warm up, and find how many calls make a sample. */
+while ((elapsed = run_kernel( b, kernel, iterations )) < BENCHSAMPLENANOSEC / 10)
+    iterations *= 2 ;
+
+iterations = iterations * BENCHSAMPLENANOSEC / (elapsed + 1) + 1 ;
+
+for (sample = 0 ;  sample < BENCHSAMPLES ;  ++sample)
+    ns_per_call[ sample ] = (double) run_kernel( b, kernel, iterations ) / (double) iterations ;
+
+qsort( ns_per_call, BENCHSAMPLES, sizeof( double ), compare_doubles ) ;
+
+return ns_per_call[ BENCHSAMPLES / 2 ] ;
+
+} /* ==================== end of function time_kernel ======================= */
+
+
+
+/*==============================================================================
+|                                count_kernel                                  |
+================================================================================
+
+DESCRIPTION
+
+     Measure the hardware counters per call of a kernel.
+
+INPUT
+
+     ns_per_call (double)    From time_kernel, to pick how many calls to
+                             make.
+
+OUTPUT
+
+     per_call (double *)     NUMHWCOUNTERS counts per call.
+
+METHOD
+
+     One run of about BENCHSAMPLENANOSEC, bracketed by reading the
+     counters.  The kernel is already warm from time_kernel.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void count_kernel( BenchSetup * b, int kernel, double ns_per_call, double * per_call )
+{
+bigint delta[ NUMHWCOUNTERS ] ;
+bigint iterations = (bigint) ((double) BENCHSAMPLENANOSEC / (ns_per_call + 1.0)) + 1 ;
+int    k ;
+
+counter_deltas( delta ) ;
+run_kernel( b, kernel, iterations ) ;
+counter_deltas( delta ) ;
+
+for (k = 0 ;  k < NUMHWCOUNTERS ;  ++k)
+    per_call[ k ] = (double) delta[ k ] / (double) iterations ;
+
+} /* ==================== end of function count_kernel ====================== */
+
+
+
+/*==============================================================================
+|                        add_result, compare_doubles                           |
+================================================================================
+
+DESCRIPTION
+
+     Add a result to the end of the list, and compare two doubles for
+     qsort.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void add_result( BenchResult * results, int * num_results, int p, int n,
+                        const char * name, double value )
+{
+if (*num_results == MAXBENCHRESULTS)
+    return ;
+
+results[ *num_results ].p     = p ;
+results[ *num_results ].n     = n ;
+results[ *num_results ].value = value ;
+sprintf( results[ *num_results ].name, "%.31s", name ) ;
+
+++*num_results ;
+
+} /* ===================== end of function add_result ======================= */
+
+
+static int compare_doubles( const void * a, const void * b )
+{
+double x = *(const double *) a ;
+double y = *(const double *) b ;
+
+return (x > y) - (x < y) ;
+
+} /* =================== end of function compare_doubles ==================== */
+
+
+
+/*==============================================================================
+|                                read_baseline                                 |
+================================================================================
+
+DESCRIPTION
+
+     Read results saved by run_bench.
+
+INPUT
+
+     file_name (char *)      The baseline file.
+
+OUTPUT
+
+     results, num_results    The results in it.
+
+RETURNS
+
+     YES if we could read it, NO if not.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int read_baseline( char * file_name, BenchResult * results, int * num_results )
+{
+FILE * fp ;
+char   line[ 256 ] ;
+char   name[ 32 ] ;
+int    p, n ;
+double value ;
+
+if ((fp = fopen( file_name, "r" )) == (FILE *) 0)
+    return NO ;
+
+while (fgets( line, sizeof( line ), fp ) != (char *) 0)
+{
+    if (line[ 0 ] == '#')
+        continue ;
+
+    if (sscanf( line, "%d %d %31s %lf", &p, &n, name, &value ) == 4)
+        add_result( results, num_results, p, n, name, value ) ;
+}
+
+fclose( fp ) ;
+
+return YES ;
+
+} /* =================== end of function read_baseline ====================== */
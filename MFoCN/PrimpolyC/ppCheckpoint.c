@@ -0,0 +1,396 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppCheckpoint.c
+|
+|  Description:
+|
+|     Save the state of a long search to a file, and pick it up again later.
+|
+|  Functions:
+|
+|     check_checkpoint_file
+|     write_checkpoint
+|     read_checkpoint
+|     resume_output
+|     temp_file_name
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>     /* for fsync(), ftruncate() */
+#include <sys/stat.h>   /* for fstat()              */
+
+#include "Primpoly.h"
+
+#define CHECKPOINTVERSION 1  /*  Change when the file layout changes. */
+
+static char * temp_file_name( char * file_name ) ;
+
+
+/*==============================================================================
+|                             check_checkpoint_file                            |
+================================================================================
+
+DESCRIPTION
+
+     Make sure we'll be able to save checkpoints before starting a search
+     which may take days.
+
+INPUT
+
+     file_name (char *)        Name of the checkpoint file.
+
+RETURNS
+
+     YES if the temporary file write_checkpoint uses can be created,
+     NO otherwise.
+
+METHOD
+
+     Create the temporary file and remove it again.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int check_checkpoint_file( char * file_name )
+{
+char * tmp_name ;
+FILE * fp ;
+
+if ((tmp_name = temp_file_name( file_name )) == (char *) 0)
+    return NO ;
+
+if ((fp = fopen( tmp_name, "w" )) == (FILE *) 0)
+{
+    free( tmp_name ) ;
+    return NO ;
+}
+
+fclose( fp ) ;
+remove( tmp_name ) ;
+free( tmp_name ) ;
+
+return YES ;
+
+} /* ============== end of function check_checkpoint_file =================== */
+
+
+
+/*==============================================================================
+|                               write_checkpoint                               |
+================================================================================
+
+DESCRIPTION
+
+     Save the search state to a file, so that either the old state or the
+     new one is there, even if we crash part way through.
+
+INPUT
+
+     file_name (char *)        Name of the checkpoint file.
+     state (Checkpoint *)      Where the search is now.
+
+OUTPUT
+
+     The checkpoint file.
+
+RETURNS
+
+     YES if the checkpoint was saved, NO otherwise.  A failure leaves the
+     previous checkpoint alone;  the caller can keep searching and try
+     again later.
+
+EXAMPLE
+
+     The file is plain text, one name and value per line:
+
+         Primpoly checkpoint 1
+         p 2
+         n 30
+         list_all 1
+         num_poly 536870912
+         ...
+         output_offset 1234567
+
+METHOD
+
+     Write to file_name.tmp, flush it through to the disk with fsync(), then
+     rename() it over the old checkpoint, which replaces it atomically.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int write_checkpoint( char * file_name, Checkpoint * state )
+{
+char * tmp_name ;
+FILE * fp ;
+int    ok ;
+
+if ((tmp_name = temp_file_name( file_name )) == (char *) 0)
+{
+    fprintf( stderr, "WARNING:  Out of memory saving checkpoint file %s\n", file_name ) ;
+    return NO ;
+}
+
+if ((fp = fopen( tmp_name, "w" )) == (FILE *) 0)
+{
+    fprintf( stderr, "WARNING:  Can't open checkpoint file %s\n", tmp_name ) ;
+    free( tmp_name ) ;
+    return NO ;
+}
+
+fprintf( fp, "Primpoly checkpoint %d\n",        CHECKPOINTVERSION ) ;
+fprintf( fp, "p %d\n",                          state->p ) ;
+fprintf( fp, "n %d\n",                          state->n ) ;
+fprintf( fp, "list_all %d\n",                   state->list_all ) ;
+fprintf( fp, "num_poly %s\n",                  bigint_string( state->stats.num_poly ) ) ;
+fprintf( fp, "num_const_coeff_prim_root %s\n",   bigint_string( state->stats.num_const_coeff_prim_root ) ) ;
+fprintf( fp, "num_free_of_linear_factors %s\n",  bigint_string( state->stats.num_free_of_linear_factors ) ) ;
+fprintf( fp, "num_irred_to_power %s\n",          bigint_string( state->stats.num_irred_to_power ) ) ;
+fprintf( fp, "num_order_r %s\n",                 bigint_string( state->stats.num_order_r ) ) ;
+fprintf( fp, "num_passing_const_coeff_test %s\n",  bigint_string( state->stats.num_passing_const_coeff_test ) ) ;
+fprintf( fp, "num_order_m %s\n",                 bigint_string( state->stats.num_order_m ) ) ;
+fprintf( fp, "prim_poly_count %s\n",           bigint_string( state->prim_poly_count ) ) ;
+fprintf( fp, "output_offset %lld\n",            state->output_offset ) ;
+
+ok = (fflush( fp ) == 0) && (fsync( fileno( fp ) ) == 0) ;
+ok = (fclose( fp ) == 0) && ok ;
+
+if (!ok || rename( tmp_name, file_name ) != 0)
+{
+    fprintf( stderr, "WARNING:  Can't save checkpoint file %s\n", file_name ) ;
+    remove( tmp_name ) ;
+    ok = NO ;
+}
+
+free( tmp_name ) ;
+
+return ok ;
+
+} /* ================= end of function write_checkpoint ===================== */
+
+
+
+/*==============================================================================
+|                                read_checkpoint                               |
+================================================================================
+
+DESCRIPTION
+
+     Read back the search state saved by write_checkpoint.
+
+INPUT
+
+     file_name (char *)        Name of the checkpoint file.
+
+OUTPUT
+
+     state (Checkpoint *)      Where the search was.
+
+RETURNS
+
+     YES if the file was read and every field was present, NO otherwise.
+
+METHOD
+
+     Read name and value pairs in any order.  Unknown names are an error,
+     since they mean the file came from a different version.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int read_checkpoint( char * file_name, Checkpoint * state )
+{
+FILE   * fp ;
+char     name[ 64 ] ;
+char     value[ 64 ] ;         /* As text, since a bigint may not fit a long long. */
+bigint * counter ;             /* Where a counter's value goes.                     */
+int      version = 0 ;
+int      num_fields = 0 ;
+
+if ((fp = fopen( file_name, "r" )) == (FILE *) 0)
+    return NO ;
+
+if (fscanf( fp, "Primpoly checkpoint %d", &version ) != 1 || version != CHECKPOINTVERSION)
+{
+    fclose( fp ) ;
+    return NO ;
+}
+
+memset( state, 0, sizeof( *state ) ) ;
+
+while (fscanf( fp, "%63s %63s", name, value ) == 2)
+{
+    counter = (bigint *) 0 ;
+
+    if      (strcmp( name, "p" ) == 0)                            state->p = atoi( value ) ;
+    else if (strcmp( name, "n" ) == 0)                            state->n = atoi( value ) ;
+    else if (strcmp( name, "list_all" ) == 0)                     state->list_all = atoi( value ) ;
+    else if (strcmp( name, "num_poly" ) == 0)                     counter = &state->stats.num_poly ;
+    else if (strcmp( name, "num_const_coeff_prim_root" ) == 0)    counter = &state->stats.num_const_coeff_prim_root ;
+    else if (strcmp( name, "num_free_of_linear_factors" ) == 0)   counter = &state->stats.num_free_of_linear_factors ;
+    else if (strcmp( name, "num_irred_to_power" ) == 0)           counter = &state->stats.num_irred_to_power ;
+    else if (strcmp( name, "num_order_r" ) == 0)                  counter = &state->stats.num_order_r ;
+    else if (strcmp( name, "num_passing_const_coeff_test" ) == 0) counter = &state->stats.num_passing_const_coeff_test ;
+    else if (strcmp( name, "num_order_m" ) == 0)                  counter = &state->stats.num_order_m ;
+    else if (strcmp( name, "prim_poly_count" ) == 0)              counter = &state->prim_poly_count ;
+    else if (strcmp( name, "output_offset" ) == 0)                state->output_offset = atoll( value ) ;
+    else
+        break ;
+
+    /*  The counters are bigints, written by bigint_string. */
+    if (counter != (bigint *) 0 && !string_to_bigint( value, counter ))
+        break ;
+
+    ++num_fields ;
+}
+
+fclose( fp ) ;
+
+return (num_fields == 12) ? YES : NO ;
+
+} /* ================= end of function read_checkpoint ====================== */
+
+
+
+/*==============================================================================
+|                                resume_output                                 |
+================================================================================
+
+DESCRIPTION
+
+     Cut standard output back to where it was at the checkpoint, so the
+     output of the resumed search follows on exactly.
+
+INPUT
+
+     offset (long long)     Size of the output at the checkpoint, or -1 if
+                            standard output wasn't a file.
+
+OUTPUT
+
+     Standard output        Truncated to offset bytes.  Anything printed since
+                            the program started is thrown away:  it is the
+                            same as what is already in the file.
+
+RETURNS
+
+     YES if standard output is ready to go on, NO if it's a file which is
+     shorter than the checkpoint, which happens when the output was
+     redirected with > instead of >>.
+
+EXAMPLE
+
+     pp -a --checkpoint pp.state 2 40 > list.txt
+     ... interrupted ...
+     pp -a --resume pp.state 2 40 >> list.txt
+
+BUGS
+
+     When standard output is a terminal or a pipe, we can't take anything
+     back, so the banner is printed again.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int resume_output( long long offset )
+{
+struct stat info ;
+
+fflush( stdout ) ;
+
+if (offset < 0 || fstat( fileno( stdout ), &info ) != 0 || !S_ISREG( info.st_mode ))
+    return YES ;
+
+if ((long long) info.st_size < offset)
+    return NO ;
+
+if (ftruncate( fileno( stdout ), (off_t) offset ) != 0 ||
+    fseek( stdout, (long) offset, SEEK_SET ) != 0)
+    return NO ;
+
+return YES ;
+
+} /* ================== end of function resume_output ======================= */
+
+
+
+/*==============================================================================
+|                                temp_file_name                                |
+================================================================================
+
+DESCRIPTION
+
+     Name of the file a checkpoint is written to before it's renamed.
+
+INPUT
+
+     file_name (char *)        Name of the checkpoint file.
+
+RETURNS
+
+     file_name.tmp, which the caller must free, or null if out of memory.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static char * temp_file_name( char * file_name )
+{
+char * tmp_name ;
+
+if ((tmp_name = malloc( strlen( file_name ) + sizeof( ".tmp" ) )) != (char *) 0)
+    sprintf( tmp_name, "%s.tmp", file_name ) ;
+
+return tmp_name ;
+
+} /* ================== end of function temp_file_name ====================== */
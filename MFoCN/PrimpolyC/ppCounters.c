@@ -0,0 +1,358 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppCounters.c
+|
+|  Description:
+|
+|     Read the processor's performance counters (cycles, instructions,
+|     cache and branch misses) for the calling thread, on Linux.
+|
+|  Functions:
+|
+|     set_hardware_counters
+|     hardware_counters_enabled
+|     hardware_counter_available
+|     hardware_counter_name
+|     counter_deltas
+|     open_counters
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  AVAILABILITY
+|
+|     The counters come from perf_event_open(2).  They aren't there on
+|     other systems, in most virtual machines and containers, or when
+|     /proc/sys/kernel/perf_event_paranoid forbids them;  then
+|     set_hardware_counters() says so and everything else does nothing.
+|     Only user mode is counted.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+#define NOTOPENED   0   /*  States of a thread's counters.  */
+#define OPENED      1
+#define UNAVAILABLE 2
+
+/*  One thread's counters.  They count only that thread, so each thread
+    opens its own the first time it asks. */
+typedef struct
+{
+    int    state ;
+    int    fd[ NUMHWCOUNTERS ] ;        /* -1 if the event isn't supported.   */
+    int    num_open ;                   /* How many are in the group ...      */
+    int    position[ NUMHWCOUNTERS ] ;  /* ... and where each is in a read.   */
+    bigint last[ NUMHWCOUNTERS ] ;      /* Counts at the previous reading.    */
+} HardwareCounters ;
+
+
+/*  YES once set_hardware_counters() found them working.  Set before the
+    search starts, and only read afterwards. */
+static int hw_counters_on = NO ;
+
+/*  Which events opened on the main thread;  the others print as - . */
+static int hw_counter_available[ NUMHWCOUNTERS ] ;
+
+static const char * hw_counter_name[ NUMHWCOUNTERS ] =
+{
+    "cycles",
+    "instructions",
+    "l1d_misses",
+    "llc_misses",
+    "branch_misses"
+} ;
+
+static _Thread_local HardwareCounters thread_counters ;
+
+static int open_counters( HardwareCounters * hc ) ;
+
+
+/*==============================================================================
+|                           set_hardware_counters                              |
+================================================================================
+
+DESCRIPTION
+
+     Turn the counters on or off for all threads.
+
+INPUT
+
+     on (int)           YES to turn them on.
+
+RETURNS
+
+     YES if they are on, NO if off or we couldn't open them.
+
+METHOD
+
+     Try to open the counters on this thread;  if none will open, leave
+     them off so the timing goes on without them.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int set_hardware_counters( int on )
+{
+int k ;
+
+hw_counters_on = NO ;
+
+if (on && open_counters( &thread_counters ))
+{
+    for (k = 0 ;  k < NUMHWCOUNTERS ;  ++k)
+        hw_counter_available[ k ] = (thread_counters.fd[ k ] >= 0) ;
+
+    hw_counters_on = YES ;
+}
+
+return hw_counters_on ;
+
+} /* ================ end of function set_hardware_counters ================= */
+
+
+
+/*==============================================================================
+|       hardware_counters_enabled, hardware_counter_available, _name           |
+================================================================================
+
+DESCRIPTION
+
+     Are the counters on, did counter k open, and what is it called.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int hardware_counters_enabled( void )
+{
+return hw_counters_on ;
+
+} /* ============= end of function hardware_counters_enabled ================ */
+
+
+int hardware_counter_available( int k )
+{
+return hw_counters_on && hw_counter_available[ k ] ;
+
+} /* ============= end of function hardware_counter_available =============== */
+
+
+const char * hardware_counter_name( int k )
+{
+return hw_counter_name[ k ] ;
+
+} /* =============== end of function hardware_counter_name ================== */
+
+
+
+/*==============================================================================
+|                               counter_deltas                                 |
+================================================================================
+
+DESCRIPTION
+
+     How much each counter of the calling thread went up since the last
+     call on this thread.
+
+OUTPUT
+
+     delta (bigint *)   NUMHWCOUNTERS counts, 0 for counters we don't have.
+
+RETURNS
+
+     YES if the counters were read, NO if they are off or unavailable on
+     this thread.
+
+EXAMPLE
+
+     counter_deltas( delta ) ;     Start counting.
+     x_to_power( ... ) ;
+     counter_deltas( delta ) ;     delta[ CYCLESCOUNTER ] is the cycles
+                                   x_to_power took, plus a little for
+                                   reading the counters.
+
+METHOD
+
+     The counters are read as a group with one read(2), so they all cover
+     the same stretch of code.
+
+BUGS
+
+     The system call costs a microsecond or so, but since we only count
+     user mode, little of it shows up in the counts.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int counter_deltas( bigint * delta )
+{
+HardwareCounters * hc = &thread_counters ;
+int                k ;
+
+for (k = 0 ;  k < NUMHWCOUNTERS ;  ++k)
+    delta[ k ] = 0 ;
+
+if (!hw_counters_on)
+    return NO ;
+
+if (hc->state == NOTOPENED)
+    open_counters( hc ) ;
+
+if (hc->state != OPENED)
+    return NO ;
+
+#ifdef __linux__
+{
+    unsigned long long values[ NUMHWCOUNTERS + 1 ] ;  /* Count, then values. */
+    int                leader = -1 ;
+
+    for (k = 0 ;  k < NUMHWCOUNTERS && leader < 0 ;  ++k)
+        if (hc->fd[ k ] >= 0)
+            leader = hc->fd[ k ] ;
+
+    if (read( leader, values, sizeof( values ) ) < (ssize_t) ((1 + hc->num_open) * sizeof( values[ 0 ] )))
+        return NO ;
+
+    for (k = 0 ;  k < NUMHWCOUNTERS ;  ++k)
+    {
+        if (hc->fd[ k ] < 0)
+            continue ;
+
+        delta[ k ]    = (bigint) values[ 1 + hc->position[ k ] ] - hc->last[ k ] ;
+        hc->last[ k ] = (bigint) values[ 1 + hc->position[ k ] ] ;
+    }
+}
+#endif
+
+return YES ;
+
+} /* =================== end of function counter_deltas ===================== */
+
+
+
+/*==============================================================================
+|                                open_counters                                 |
+================================================================================
+
+DESCRIPTION
+
+     Open the counters for the calling thread, as one group.
+
+OUTPUT
+
+     hc (HardwareCounters *)   OPENED with the events which are supported,
+                               or UNAVAILABLE if none are.
+
+RETURNS
+
+     YES if at least one counter opened.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int open_counters( HardwareCounters * hc )
+{
+int k ;
+
+hc->state    = UNAVAILABLE ;
+hc->num_open = 0 ;
+
+for (k = 0 ;  k < NUMHWCOUNTERS ;  ++k)
+{
+    hc->fd[ k ]   = -1 ;
+    hc->last[ k ] = 0 ;
+}
+
+#ifdef __linux__
+{
+    struct perf_event_attr attr ;
+    int                    leader = -1 ;
+
+    static const struct { unsigned int type ; unsigned long long config ; } event[ NUMHWCOUNTERS ] =
+    {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+    } ;
+
+    for (k = 0 ;  k < NUMHWCOUNTERS ;  ++k)
+    {
+        memset( &attr, 0, sizeof( attr ) ) ;
+        attr.size           = sizeof( attr ) ;
+        attr.type           = event[ k ].type ;
+        attr.config         = event[ k ].config ;
+        attr.exclude_kernel = 1 ;
+        attr.exclude_hv     = 1 ;
+        attr.read_format    = PERF_FORMAT_GROUP ;
+
+        /*  This thread, any processor, in the leader's group. */
+        hc->fd[ k ] = (int) syscall( SYS_perf_event_open, &attr, 0, -1, leader, 0 ) ;
+
+        if (hc->fd[ k ] < 0)
+            continue ;
+
+        if (leader < 0)
+            leader = hc->fd[ k ] ;
+
+        hc->position[ k ] = hc->num_open++ ;
+    }
+
+    if (leader >= 0)
+    {
+        ioctl( leader, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP ) ;
+        ioctl( leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP ) ;
+        hc->state = OPENED ;
+    }
+}
+#endif
+
+return hc->state == OPENED ;
+
+} /* =================== end of function open_counters ====================== */
@@ -13,6 +13,17 @@
 |     factor
 |     is_probably_prime
 |     is_almost_surely_prime
+|     is_bigint_prime
+|     factor_rest
+|     add_prime
+|     pollard_rho
+|     set_modulus
+|     multiply_modulus
+|     to_modulus
+|     power_modulus
+|     multiply_wide
+|     rho_step
+|     gcd_bigint
 |
 |  LEGAL
 |
@@ -47,6 +58,31 @@
 #include "Primpoly.h"
 
 
+/*  Arithmetic modulo n for is_bigint_prime and pollard_rho. */
+typedef struct
+{
+    bigint n ;
+#ifdef PP_INT128
+    bigint n_prime ;            /* -1/n (mod 2^128)                          */
+    bigint r_square ;           /* 2^256 (mod n)                             */
+#endif
+} Modulus ;
+
+
+static void   factor_rest     ( bigint n, bigint * primes, int * count, int * t ) ;
+static void   add_prime       ( bigint q, bigint * primes, int * count, int * t ) ;
+static bigint pollard_rho     ( bigint n ) ;
+static void   set_modulus     ( Modulus * m, bigint n ) ;
+static bigint multiply_modulus( const Modulus * m, bigint a, bigint b ) ;
+static bigint to_modulus      ( const Modulus * m, bigint x ) ;
+static bigint power_modulus   ( const Modulus * m, bigint a, bigint e ) ;
+#ifdef PP_INT128
+static void   multiply_wide   ( bigint a, bigint b, bigint * high, bigint * low ) ;
+#endif
+static bigint rho_step        ( const Modulus * m, bigint y, bigint c ) ;
+static bigint gcd_bigint      ( bigint a, bigint b ) ;
+
+
 /*==============================================================================
 |                                    factor                                    |
 ================================================================================
@@ -96,7 +132,8 @@ METHOD
 	(2)  Next, divide n by all integers d >= 5 except multiples of 2 and 3. 
 
     (3)  Halt either when all prime factors have been divided out (leaving n = 1) 
-	     or when the current value of n is prime.  The stopping test 
+	     or when the current value of n is prime, or when d passes
+         TRIALDIVISORLIMIT.  The stopping test 
 
           (d > | n/d | AND r != 0)
                --   --
@@ -168,13 +205,18 @@ METHOD
 	divisor.
 
 
+    (4)  If d passes TRIALDIVISORLIMIT first, what's left of n has only
+         large prime factors.  factor_rest splits it with Pollard rho,
+         testing each piece with is_bigint_prime, and sorts the primes
+         it finds in with the others.  Rho takes about the square root of
+         p    steps instead of p   , so even 128-bit r's factor in seconds.
+          t-1                  t-1
+
 BUGS
 
-    Can be slow when n is a prime.  We could do a probabilistic test for
-    the primality of n at the statement, "n_is_prime = (r != 0 && q < d) ;"
-    which would speed up the test.  
-    
-    Or we could implement the Pollard rho algorithm instead.
+    is_bigint_prime is a probabilistic test for n >= 3.3 10^24, so in the
+    128-bit build a composite factor could in principle be taken for a
+    prime.
 
 --------------------------------------------------------------------------------
 |                                Function Call                                 |
@@ -301,19 +343,24 @@ do {
         new_d = YES ;
     }
 
-} while ( ! n_is_prime && (n != 1)) ;
+} while ( ! n_is_prime && (n != 1) && d <= TRIALDIVISORLIMIT) ;
 
 if (n == 1)       /*  All factors were divided out. */
 
     return( t - 1 ) ;
 
-else {  /*  Current value of n is prime.  It is the last prime factor. */
+else if (n_is_prime) {  /*  Current value of n is prime.  It is the last prime factor. */
 
     primes[ t ] = n ;
     count[ t ] = 1 ;
     return( t ) ;
 }
 
+/*  The rest of n has no factors below d. */
+factor_rest( n, primes, count, &t ) ;
+
+return( t - 1 ) ;
+
 } /* ========================= end of function factor ======================= */
 
 /*
@@ -350,8 +397,10 @@ EulerPhi( bigint n )
 	else if (n == 1)
 		return 1 ;
 
-	/* Factor n >= 2 into distinct primes. */
-    prime_count = factor( n, primes, count ) ;
+	/* Factor n >= 2 into distinct primes, from the factor table if we can. */
+    prime_count = factor_from_table( n, primes, count ) ;
+    if (prime_count < 0)
+        prime_count = factor( n, primes, count ) ;
 
 	/* Compute Euler phi[ n ] =   */
 	/*                            */
@@ -525,10 +574,13 @@ METHOD
 
     assuming the random number generator is really random.
 
+    The random integers come from next_random with a fixed seed and a
+    state of our own, so the answer is always the same, and we don't
+    disturb rand() for anyone else.
+
 BUGS
 
-    The system pseudorandom number generator needs to be a good one
-    (i.e. passes the spectral test and other statistical tests).
+    None.
 
 --------------------------------------------------------------------------------
 |                                Function Call                                 |
@@ -545,17 +597,17 @@ int
     trial = 0,
     x     = 3 ;
 
+unsigned long long
+    state = 314159 ;   /* Our own generator, so we're safe to call from threads. */
+
 /*------------------------------------------------------------------------------
 |                                Function Body                                 |
 ------------------------------------------------------------------------------*/
 
-/* Seed the random-number generator. */
-srand( 314159 );
-   
 for (trial = 1 ;  trial <= NUM_PRIME_TEST_TRIALS ;  ++trial)
 {
     /*  Generate a new random integer such that 1 < x < n. */
-    x = rand() % n ;
+    x = (int) (next_random( &state ) % (unsigned long long) n) ;
     if (x <= 1) x = 3 ;
 
 	/* Definitely not prime. */
@@ -569,3 +621,477 @@ for (trial = 1 ;  trial <= NUM_PRIME_TEST_TRIALS ;  ++trial)
 return YES ;
 
 } /* ============== end of function is_almost_surely_prime ================ */
+
+
+
+/*==============================================================================
+|                               is_bigint_prime                                |
+================================================================================
+
+DESCRIPTION
+
+     Test whether a bigint n is prime, for factor.  Unlike
+     is_almost_surely_prime, n may be as large as the bigint allows.
+
+INPUT
+
+     n      (bigint)
+
+RETURNS
+
+     YES    If n is prime, or almost surely prime when n >= 3.3 10^24.
+     NO     If n is definitely not prime.
+
+METHOD
+
+     The Miller-Rabin test of is_probably_prime, with the first
+     NUM_PRIME_TEST_TRIALS primes for x.  The first 12 of them are enough
+     to prove n prime for n < 3.3 10^24, which covers every 64-bit bigint.
+     Beyond that a composite n is very unlikely to pass all 25.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int is_bigint_prime( bigint n )
+{
+static const int base[ NUM_PRIME_TEST_TRIALS ] =
+{
+     2,  3,  5,  7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
+    43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97
+} ;
+
+Modulus m ;
+bigint  q, y, one, minus_one ;
+int     i, j, k ;
+
+if (n < 2)
+    return NO ;
+
+for (i = 0 ;  i < NUM_PRIME_TEST_TRIALS ;  ++i)
+{
+    if (n == (bigint) base[ i ])
+        return YES ;
+
+    if (n % (bigint) base[ i ] == 0)
+        return NO ;
+}
+
+/* Factor out powers of 2 to get n = 1 + 2^k q, q odd. */
+for (q = n - 1, k = 0 ;  q % 2 == 0 ;  q /= 2)
+    ++k ;
+
+set_modulus( &m, n ) ;
+one       = to_modulus( &m, 1 ) ;
+minus_one = to_modulus( &m, n - 1 ) ;
+
+for (i = 0 ;  i < NUM_PRIME_TEST_TRIALS ;  ++i)
+{
+    y = power_modulus( &m, to_modulus( &m, (bigint) base[ i ] ), q ) ;
+
+    for (j = 1 ;  j < k && y != one && y != minus_one ;  ++j)
+        y = multiply_modulus( &m, y, y ) ;
+
+    /* Neither x^q = 1 nor x^(2^j q) = -1 for some j < k. */
+    if (y != minus_one && !(j == 1 && y == one))
+        return NO ;
+}
+
+return YES ;
+
+} /* ================= end of function is_bigint_prime ====================== */
+
+
+
+/*==============================================================================
+|                                 factor_rest                                  |
+================================================================================
+
+DESCRIPTION
+
+     Factor what's left of n after trial division, and add its primes to
+     those factor has found so far.
+
+INPUT
+
+     n      (bigint)            Odd, and with no prime factors below
+                                TRIALDIVISORLIMIT.
+
+     primes, count, t           The primes so far, in increasing order, and
+                                how many there are.
+
+OUTPUT
+
+     primes, count, t           With the primes of n added.
+
+METHOD
+
+     If n isn't prime, split it in two with Pollard rho and factor both
+     parts.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void factor_rest( bigint n, bigint * primes, int * count, int * t )
+{
+bigint d ;
+
+if (n == 1)
+    return ;
+
+if (is_bigint_prime( n ))
+{
+    add_prime( n, primes, count, t ) ;
+    return ;
+}
+
+d = pollard_rho( n ) ;
+
+factor_rest( d,     primes, count, t ) ;
+factor_rest( n / d, primes, count, t ) ;
+
+} /* =================== end of function factor_rest ======================== */
+
+
+
+/*==============================================================================
+|                                  add_prime                                   |
+================================================================================
+
+DESCRIPTION
+
+     Count one more factor q, keeping primes[ 0 ] ... primes[ t-1 ] in
+     increasing order as trial division leaves them.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void add_prime( bigint q, bigint * primes, int * count, int * t )
+{
+int i, j ;
+
+for (i = 0 ;  i < *t && primes[ i ] < q ;  ++i)
+    ;
+
+if (i < *t && primes[ i ] == q)
+{
+    ++count[ i ] ;
+    return ;
+}
+
+for (j = *t ;  j > i ;  --j)
+{
+    primes[ j ] = primes[ j - 1 ] ;
+    count[ j ]  = count[ j - 1 ] ;
+}
+
+primes[ i ] = q ;
+count[ i ]  = 1 ;
+++*t ;
+
+} /* ===================== end of function add_prime ======================== */
+
+
+
+/*==============================================================================
+|                                 pollard_rho                                  |
+================================================================================
+
+DESCRIPTION
+
+     Find a factor of a composite n.
+
+INPUT
+
+     n      (bigint)       Odd and composite.
+
+RETURNS
+
+     d      (bigint)       A factor of n with 1 < d < n.
+
+METHOD
+
+     Pollard's rho method with Brent's cycle finding, as in Knuth, vol. 2,
+     Algorithm B, and R. P. Brent, "An Improved Monte Carlo Factorization
+                                    2
+     Algorithm", BIT 20, 1980.  y = y  + c (mod n) runs into a cycle mod
+     each prime q of n after about sqrt( q ) steps.  When it does, q divides
+     the difference of two y's, and so their gcd with n.  We multiply
+     RHOBATCH differences together mod n between gcds, which saves nearly
+     all of them, and go back one step at a time if a batch caught every
+     prime at once.  If even that gives n, try another c.
+
+     The arithmetic is in the form of multiply_modulus, which only scales
+     each y and each product by a number prime to n, so the gcds are the
+     same.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static bigint pollard_rho( bigint n )
+{
+Modulus m ;
+bigint  c, x, y, ys, q, d, r, k, i, steps ;
+
+set_modulus( &m, n ) ;
+
+for (c = 1 ;  ;  ++c)
+{
+    y = 2 ;
+    r = 1 ;
+    q = 1 ;
+    d = 1 ;
+    x = ys = 2 ;
+
+    do {
+        /* Remember y, then take r steps, then r more in batches. */
+        x = y ;
+        for (i = 0 ;  i < r ;  ++i)
+            y = rho_step( &m, y, c ) ;
+
+        for (k = 0 ;  k < r && d == 1 ;  k += RHOBATCH)
+        {
+            ys    = y ;
+            steps = (r - k < RHOBATCH) ? r - k : RHOBATCH ;
+
+            for (i = 0 ;  i < steps ;  ++i)
+            {
+                y = rho_step( &m, y, c ) ;
+                q = multiply_modulus( &m, q, (x > y) ? x - y : y - x ) ;
+            }
+
+            d = gcd_bigint( q, n ) ;
+        }
+
+        r *= 2 ;
+
+    } while (d == 1) ;
+
+    /* The batch found every factor at once.  Redo it a step at a time. */
+    if (d == n)
+    {
+        do {
+            ys = rho_step( &m, ys, c ) ;
+            d  = gcd_bigint( (x > ys) ? x - ys : ys - x, n ) ;
+        } while (d == 1) ;
+    }
+
+    if (d != n)
+        return d ;
+}
+
+} /* ==================== end of function pollard_rho ======================= */
+
+
+
+/*==============================================================================
+|                                set_modulus                                   |
+================================================================================
+
+DESCRIPTION
+
+     Get ready for arithmetic modulo an odd n with multiply_modulus.
+
+INPUT
+
+     n      (bigint)       Odd, n < MAXPTON.
+
+OUTPUT
+
+     m      (Modulus *)
+
+METHOD
+
+     The 64-bit bigint uses multiply_mod and needs only n.
+
+     For the 128-bit bigint, multiply_mod adds up to 127 doublings, which
+     makes Pollard rho far too slow on a 100-bit r.  Instead we use
+                                                                 128
+     Montgomery multiplication:  numbers x are kept as x R with R = 2   and
+     the product of a R and b R is a b R = (a R) (b R) / R (mod n).  The
+     division by R is exact after we add the multiple of n which clears the
+     low 128 bits of (a R) (b R).  That takes n' = -1/n (mod R), which
+     Newton's iteration v = v (2 - n v) finds, doubling the good bits of
+     v each time, starting from v = n, which is good to 3 bits.
+                                    2
+     To put x into this form, multiply it by R  (mod n).
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void set_modulus( Modulus * m, bigint n )
+{
+#ifdef PP_INT128
+bigint v = n, r ;
+int    i ;
+#endif
+
+m->n = n ;
+
+#ifdef PP_INT128
+for (i = 0 ;  i < 6 ;  ++i)
+    v *= 2 - n * v ;
+
+m->n_prime = 0 - v ;
+
+r           = (0 - n) % n ;             /* R (mod n)    */
+m->r_square = multiply_mod( r, r, n ) ; /* R^2 (mod n)  */
+#endif
+
+} /* ==================== end of function set_modulus ======================= */
+
+
+
+/*==============================================================================
+|                multiply_modulus, to_modulus, power_modulus                   |
+================================================================================
+
+DESCRIPTION
+
+     Arithmetic modulo m->n, in the form set_modulus describes:
+
+         multiply_modulus( m, a, b )    The product of a and b.
+
+         to_modulus( m, x )             x in this form.
+
+         power_modulus( m, a, e )       a to the power e.
+
+INPUT
+
+     a, b, x    (bigint)   0 <= a, b, x < m->n.
+     e          (bigint)
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static bigint multiply_modulus( const Modulus * m, bigint a, bigint b )
+{
+#ifdef PP_INT128
+bigint high, low, mn_high, mn_low, t ;
+
+multiply_wide( a, b, &high, &low ) ;
+multiply_wide( low * m->n_prime, m->n, &mn_high, &mn_low ) ;
+
+/*  low + mn_low is 0 or R;  the carry out of it is 1 unless low = 0.  */
+t = high + mn_high + (low != 0) ;
+
+return (t >= m->n) ? t - m->n : t ;
+#else
+return multiply_mod( a, b, m->n ) ;
+#endif
+
+} /* ================= end of function multiply_modulus ===================== */
+
+
+static bigint to_modulus( const Modulus * m, bigint x )
+{
+#ifdef PP_INT128
+return multiply_modulus( m, x, m->r_square ) ;
+#else
+(void) m ;
+return x ;
+#endif
+
+} /* ==================== end of function to_modulus ======================== */
+
+
+static bigint power_modulus( const Modulus * m, bigint a, bigint e )
+{
+bigint product = to_modulus( m, 1 ) ;
+
+while (e > 0)
+{
+    if (e & 1)
+        product = multiply_modulus( m, product, a ) ;
+
+    a = multiply_modulus( m, a, a ) ;
+    e >>= 1 ;
+}
+
+return product ;
+
+} /* =================== end of function power_modulus ====================== */
+
+
+
+#ifdef PP_INT128
+/*==============================================================================
+|                               multiply_wide                                  |
+================================================================================
+
+DESCRIPTION
+
+     The full 256-bit product of two 128-bit numbers, from four 64-bit by
+     64-bit products.
+
+OUTPUT
+
+     high, low  (bigint *)   a b = high R + low.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void multiply_wide( bigint a, bigint b, bigint * high, bigint * low )
+{
+bigint mask = ~(unsigned long long) 0 ;
+bigint a0 = a & mask, a1 = a >> 64 ;
+bigint b0 = b & mask, b1 = b >> 64 ;
+
+bigint p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1 ;
+
+/*  The middle 64 bits, with the carries out of them. */
+bigint middle = (p00 >> 64) + (p01 & mask) + (p10 & mask) ;
+
+*low  = (middle << 64) | (p00 & mask) ;
+*high = p11 + (p01 >> 64) + (p10 >> 64) + (middle >> 64) ;
+
+} /* =================== end of function multiply_wide ====================== */
+#endif
+
+
+
+/*==============================================================================
+|                             rho_step, gcd_bigint                             |
+================================================================================
+
+DESCRIPTION
+
+     Arithmetic for pollard_rho:
+                                     2
+         rho_step( m, y, c )        y  + c (mod m->n)
+
+         gcd_bigint( a, b )         The greatest common divisor of a and b.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static bigint rho_step( const Modulus * m, bigint y, bigint c )
+{
+y = multiply_modulus( m, y, y ) + c ;
+
+return (y >= m->n) ? y - m->n : y ;
+
+} /* ===================== end of function rho_step ========================= */
+
+
+static bigint gcd_bigint( bigint a, bigint b )
+{
+bigint t ;
+
+while (b != 0)
+{
+    t = a % b ;
+    a = b ;
+    b = t ;
+}
+
+return a ;
+
+} /* ==================== end of function gcd_bigint ======================== */
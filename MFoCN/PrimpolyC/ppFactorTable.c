@@ -0,0 +1,386 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppFactorTable.c
+|
+|  Description:
+|
+|     Read a table of known factorizations of p^n - 1 and p^n + 1, and
+|     use its primes to factor r without searching for them.
+|
+|  Functions:
+|
+|     load_factor_table
+|     factor_from_table
+|     factor_table_primes
+|     read_table_entry
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  FILE FORMAT
+|
+|     A text file, one entry per line, in the style of the Cunningham
+|     tables:
+|
+|         p n - q1 q2^k2 ...     the prime factorization of p^n - 1
+|         p n + q1 q2^k2 ...     the prime factorization of p^n + 1
+|
+|     with the primes in decimal, and ^k when one divides k times.  Since
+|     p^(2n) - 1 = (p^n - 1)(p^n + 1), the + entries give the pieces of
+|     p^n - 1 for even n one at a time, as the tables do.  Blank lines,
+|     and everything after a #, are ignored.  For example,
+|
+|         # F_7 = 2^128 + 1, Morrison and Brillhart, 1970.
+|         2 128 + 59649589127497217 5704689200685129054721
+|
+|     FactorTable.txt has the factored Fermat numbers 2^(2^k) + 1, which
+|     give all of 2^n - 1 for n a power of 2 up to 4096.
+|
+|     Each entry is checked as it's read:  every q has to be prime, and
+|     dividing p^n -/+ 1 by the q's as many times as given has to leave
+|     exactly 1.  So a table can't give a wrong factorization, only an
+|     incomplete one.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "Primpoly.h"
+
+
+/*  The distinct primes of all the entries, in increasing order.  */
+static MultiFactors table_primes ;
+
+static void read_table_entry( char * line, char * file_name, int line_number ) ;
+
+
+
+/*==============================================================================
+|                              load_factor_table                               |
+================================================================================
+
+DESCRIPTION
+
+     Read a factor table (--factors) and check its entries.
+
+INPUT
+
+     file_name (char *)    The table, in the format above.
+
+RETURNS
+
+     The number of entries.  Exits with an error for a file we can't read,
+     or for an entry which is wrong.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int load_factor_table( char * file_name )
+{
+FILE * fp ;
+char * line ;
+char * start ;
+int    line_number = 0, num_entries = 0, length ;
+
+if ((fp = fopen( file_name, "r" )) == (FILE *) 0)
+{
+    printf( "ERROR:  Can't open the factor table %s\n\n", file_name ) ;
+    exit( 1 ) ;
+}
+
+if ((line = (char *) malloc( FACTORTABLELINE + 2 )) == (char *) 0)
+{
+    printf( "ERROR:  Not enough memory for the factor table.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+while (fgets( line, FACTORTABLELINE + 2, fp ) != (char *) 0)
+{
+    ++line_number ;
+
+    length = (int) strcspn( line, "\r\n" ) ;
+
+    if (line[ length ] == '\0' && !feof( fp ))
+    {
+        printf( "ERROR:  Line %d of the factor table %s is longer than\n"
+                "        %d characters.\n\n",
+                line_number, file_name, FACTORTABLELINE ) ;
+        exit( 1 ) ;
+    }
+
+    line[ strcspn( line, "#\r\n" ) ] = '\0' ;
+
+    for (start = line ;  *start == ' ' || *start == '\t' ;  ++start)
+        ;
+
+    if (*start == '\0')
+        continue ;
+
+    read_table_entry( start, file_name, line_number ) ;
+    ++num_entries ;
+}
+
+fclose( fp ) ;
+free( line ) ;
+
+return num_entries ;
+
+} /* ================= end of function load_factor_table ==================== */
+
+
+
+/*==============================================================================
+|                              factor_from_table                               |
+================================================================================
+
+DESCRIPTION
+
+     Factor n using the primes of the factor table, as factor() would.
+     main and EulerPhi try this first.
+
+INPUT
+
+     n (bigint)        The number to factor, n >= 2.
+
+OUTPUT
+
+     primes (bigint *)    Distinct prime factors of n, in increasing order,
+     count  (int *)       and their multiplicities, as for factor().
+
+RETURNS
+
+     The index of the last prime, as for factor(), or -1 if the table
+     doesn't finish the job, or there isn't one.  Then call factor().
+
+METHOD
+
+     Divide out each prime of the table, up to what's left of n.  We're
+     done if that leaves 1 or a prime.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int factor_from_table( bigint n, bigint * primes, int * count )
+{
+bigint q ;
+int    i, j, t = 0 ;
+
+if (table_primes.num_primes == 0 || n < 2)
+    return -1 ;
+
+for (i = 0 ;  i < table_primes.num_primes && n != 1 ;  ++i)
+{
+    if (!multi_to_bigint( &table_primes.prime[ i ], &q ) || q > n)
+        break ;
+
+    if (n % q != 0)
+        continue ;
+
+    if (t >= MAXNUMPRIMEFACTORS - 1)
+        return -1 ;
+
+    primes[ t ] = q ;
+    count[ t ]  = 0 ;
+
+    do {
+        n /= q ;
+        ++count[ t ] ;
+    } while (n % q == 0) ;
+
+    ++t ;
+}
+
+if (n != 1)
+{
+    if (!is_bigint_prime( n ))
+        return -1 ;
+
+    /*  Sort the last prime in with the others. */
+    for (j = t ;  j > 0 && primes[ j - 1 ] > n ;  --j)
+    {
+        primes[ j ] = primes[ j - 1 ] ;
+        count[ j ]  = count[ j - 1 ] ;
+    }
+
+    primes[ j ] = n ;
+    count[ j ]  = 1 ;
+    ++t ;
+}
+
+return t - 1 ;
+
+} /* ================= end of function factor_from_table ==================== */
+
+
+
+/*==============================================================================
+|                             factor_table_primes                              |
+================================================================================
+
+DESCRIPTION
+
+     The primes of the factor table, for the large degree search to start
+     factoring r with.
+
+RETURNS
+
+     All the distinct primes, in increasing order;  none if there's no
+     table.  The counts mean nothing.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+const MultiFactors * factor_table_primes( void )
+{
+return &table_primes ;
+
+} /* ================ end of function factor_table_primes =================== */
+
+
+
+/*==============================================================================
+|                               read_table_entry                               |
+================================================================================
+
+DESCRIPTION
+
+     Check one entry of the table, and add its primes to the others.
+
+INPUT
+
+     line (char *)          The entry, without comments.  Taken apart by
+                            strtok.
+     file_name (char *)     For the error messages ...
+     line_number (int)      ... which exit.
+
+METHOD
+
+     Compute m = p^n -/+ 1 and divide it by each prime as many times as
+     given, with no remainder.  What's left has to be 1.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void read_table_entry( char * line, char * file_name, int line_number )
+{
+MultiInt m, q, t, rem ;
+char   * token ;
+char   * power_of ;
+char     sign = '\0' ;
+int      p = 0, n = 0, k, i ;
+
+token = strtok( line, " \t" ) ;
+if (token != (char *) 0)
+    p = atoi( token ) ;
+
+token = strtok( (char *) 0, " \t" ) ;
+if (token != (char *) 0)
+    n = atoi( token ) ;
+
+token = strtok( (char *) 0, " \t" ) ;
+if (token != (char *) 0 && strlen( token ) == 1)
+    sign = token[ 0 ] ;
+
+if (p < 2 || n < 1 || (sign != '-' && sign != '+'))
+{
+    printf( "ERROR:  Line %d of the factor table %s should begin p n - or p n +.\n\n",
+            line_number, file_name ) ;
+    exit( 1 ) ;
+}
+
+if (n * log( (double) p ) / log( 2.0 ) > 32.0 * (MULTIINTLIMBS - 2))
+{
+    printf( "ERROR:  Line %d of the factor table %s:  %d^%d is too large.\n\n",
+            line_number, file_name, p, n ) ;
+    exit( 1 ) ;
+}
+
+multi_power( &m, p, n ) ;
+
+if (sign == '-')
+    multi_subtract_small( &m, 1 ) ;
+else
+    multi_add_small( &m, 1 ) ;
+
+while ((token = strtok( (char *) 0, " \t" )) != (char *) 0)
+{
+    k = 1 ;
+
+    if ((power_of = strchr( token, '^' )) != (char *) 0)
+    {
+        *power_of = '\0' ;
+        k = atoi( power_of + 1 ) ;
+    }
+
+    if (!multi_from_string( &q, token ) || k < 1)
+    {
+        printf( "ERROR:  Line %d of the factor table %s:  can't read the factor %s.\n\n",
+                line_number, file_name, token ) ;
+        exit( 1 ) ;
+    }
+
+    if (q.size == 0 || !multi_is_prime( &q ))
+    {
+        printf( "ERROR:  Line %d of the factor table %s:  %s isn't prime.\n\n",
+                line_number, file_name, token ) ;
+        exit( 1 ) ;
+    }
+
+    for (i = 0 ;  i < k ;  ++i)
+    {
+        multi_divide( &t, &rem, &m, &q ) ;
+
+        if (rem.size != 0)
+        {
+            printf( "ERROR:  Line %d of the factor table %s:\n"
+                    "        %s^%d doesn't divide %d^%d %c 1.\n\n",
+                    line_number, file_name, token, k, p, n, sign ) ;
+            exit( 1 ) ;
+        }
+
+        multi_copy( &m, &t ) ;
+    }
+
+    multi_add_factor( &table_primes, &q, 1 ) ;
+}
+
+if (m.size != 1 || m.limb[ 0 ] != 1)
+{
+    printf( "ERROR:  Line %d of the factor table %s:\n"
+            "        the factors don't multiply back to %d^%d %c 1.\n\n",
+            line_number, file_name, p, n, sign ) ;
+    exit( 1 ) ;
+}
+
+} /* ================= end of function read_table_entry ===================== */
@@ -0,0 +1,609 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppFilter.c
+|
+|  Description:
+|
+|     Run a trial polynomial through the primitivity tests, in the usual
+|     order, or in the order which rejects it most cheaply.
+|
+|  Functions:
+|
+|     passes_primitivity_tests
+|     set_adaptive_order
+|     run_stage
+|     count_pass
+|     reset_filter_order
+|     reorder_filters
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  THE FILTERS
+|
+|     Every test is a yes or no question about f(x) alone, and f(x) is
+|     primitive when all of them say yes, so they can be asked in any
+|     order.  The exception is the constant coefficient test, which needs
+|     the integer from the order r test and always comes right after it.
+|     The power table is built when the first test which uses it comes up,
+|     so a polynomial rejected by the constant coefficient or linear
+|     factor tests never pays for it.
+|
+|     With --adaptive, each thread times the tests and counts how often
+|     each one rejects, and puts them in order of increasing cost per
+|     rejection.  The counts of -s are for the usual order, so they don't
+|     mix with --adaptive.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+#define NUMFILTERS 5        /*  Tests we put in order;  the constant test
+                                rides along with the order r test.          */
+
+/*  The tests in the order of the theorem, cheapest first for most p and n. */
+static const int usual_order[ NUMFILTERS ] =
+{
+    CONSTCOEFFSTAGE, LINEARSTAGE, BERLEKAMPSTAGE, ORDERRSTAGE, ORDERMSTAGE
+} ;
+
+/*  A trial polynomial and what we've worked out about it so far. */
+typedef struct
+{
+    int *    f ;
+    int      n ;
+    int      p ;
+    bigint   r ;
+    bigint * primes ;
+    int      prime_count ;
+    int      a ;                   /* From the order r test.                */
+    int      have_power_table ;    /* YES once power_table is filled in.    */
+
+    /*  x ^ n , ... , x ^ 2n-2 (mod f(x), p) */
+    int      power_table[ MAXDEGPOLY - 1 ] [ MAXDEGPOLY ] ;
+} TrialPoly ;
+
+/*  One thread's order of the tests and what it measured about them.  The
+    measurements are indexed by stage, and halved at each reordering so
+    old ones fade out as the search moves on. */
+typedef struct
+{
+    int    n ;                     /* The order is for this degree ...      */
+    int    p ;                     /* ... and modulus, or 0 if not set up.  */
+    int    order[ NUMFILTERS ] ;   /* Stages in the order we run them.      */
+    bigint candidates ;            /* Trial polynomials seen.               */
+    int    samples ;               /* Measured since the last reordering.   */
+    double nanosec[ NUMSTAGES ] ;  /* Time in each test ...                 */
+    double calls  [ NUMSTAGES ] ;  /* ... how many times it ran ...         */
+    double passed [ NUMSTAGES ] ;  /* ... and how many passed.              */
+    double cost_estimate[ NUMSTAGES ] ;  /* Before we've measured:  rough   */
+    double pass_estimate[ NUMSTAGES ] ;  /* ns per call and fraction passed.*/
+} FilterOrder ;
+
+
+/*  YES for --adaptive.  Set before the search starts, and only read after. */
+static int adaptive_order = NO ;
+
+static _Thread_local FilterOrder thread_order ;
+
+static int  run_stage         ( int stage, TrialPoly * t, SearchStatistics * stats,
+                                int record, bigint * start ) ;
+static void count_pass        ( int stage, SearchStatistics * stats ) ;
+static void reset_filter_order( FilterOrder * fo, int n, int p, int prime_count ) ;
+static void reorder_filters   ( FilterOrder * fo ) ;
+
+
+/*==============================================================================
+|                           passes_primitivity_tests                           |
+================================================================================
+
+DESCRIPTION
+
+    Run a trial polynomial through the whole sequence of primitivity tests,
+    counting how many tests it survives.
+
+INPUT
+
+    f (int *)             Monic polynomial f(x) of degree n.
+    n (int, n >= 2)       Its degree.
+    p (int, p >= 2)       Modulo p coefficient arithmetic.
+                                n
+                               p  - 1
+    r (bigint)            r = -------
+                               p - 1
+    primes (bigint *)     Distinct prime factors of r.
+    prime_count (int)     They are stored in locations 0 through prime_count.
+
+OUTPUT
+
+    stats (SearchStatistics *)  The counter for each test f(x) passes is
+                                incremented.  num_poly is left alone.
+                                With --timing, the time of each test done
+                                is recorded too.
+
+RETURNS
+
+    YES    if f(x) is a primitive polynomial.
+    NO     otherwise.
+
+EXAMPLE
+                                 4
+    Let n = 4, p = 2 and f(x) = x  + x + 1.  f(x) passes every test, so
+    we return YES and increment every counter by 1.
+
+METHOD
+
+    The tests are done from cheapest to most expensive, quitting at the
+    first one which fails:
+
+        Constant coefficient of f(x) * (-1)^n must be a primitive root of p.
+        f(x) can't have any linear factors.
+        f(x) can't have two or more distinct irreducible factors.
+        x^r (mod f(x), p) = a must be an integer.
+        Constant coefficient of f(x) * (-1)^n must equal a mod p.
+        x^m != integer for all m = r / q, q a prime divisor of r.
+
+    With --adaptive, one trial polynomial in ADAPTIVESAMPLERATE goes
+    through every test, whatever the answer, and we time each one.  After
+    ADAPTIVEREORDER of those, the tests are sorted by time per rejection,
+
+        mean time / (1 - fraction passing),
+
+    which puts first the test that gets rid of the most polynomials for
+    the time spent, if the tests reject independently of each other.
+
+    With --trace in a build with PP_TRACE, each test is an event in the
+    trace.
+
+    This was the body of the search loop in main.  It keeps its own
+    power table and scratch space on the stack, so several threads can
+    call it at once.
+
+BUGS
+
+    The tests don't reject independently:  a polynomial with a linear
+    factor has two or more irreducible factors, for one.  So the order is
+    a good one rather than the best.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int passes_primitivity_tests( int * f, int n, int p, bigint r, bigint * primes,
+                              int prime_count, SearchStatistics * stats )
+{
+
+/*------------------------------------------------------------------------------
+|                               Local Variables                                |
+------------------------------------------------------------------------------*/
+
+TrialPoly
+    t ;                            /* The polynomial and its power table.   */
+
+FilterOrder
+    * fo = &thread_order ;         /* This thread's order of the tests.     */
+
+const int
+    * order = usual_order ;        /* The order we use this time.           */
+
+int
+    k,
+    stage,                         /* The test we're on.                    */
+    passed,                        /* Result of the latest test.            */
+    alive = YES,                   /* Passed every test so far?             */
+    sample = NO,                   /* Measuring every test this time?       */
+    timing = stage_timing_enabled() ; /* YES to time each test (--timing).  */
+
+bigint
+    start = 0,                     /* When the current test began.          */
+    sample_start = 0 ;             /* ... and for the measurement.          */
+
+/*------------------------------------------------------------------------------
+|                                Function Body                                 |
+------------------------------------------------------------------------------*/
+
+#ifdef DEBUG_PP_PRIMPOLY
+printf( "\nNext trial polynomial:  " ) ;
+write_poly( f, n ) ;
+printf( "\n" ) ;
+#endif
+
+TRACE_SAMPLE_POLY() ;
+
+t.f                = f ;
+t.n                = n ;
+t.p                = p ;
+t.r                = r ;
+t.primes           = primes ;
+t.prime_count      = prime_count ;
+t.a                = 0 ;
+t.have_power_table = NO ;
+
+if (adaptive_order)
+{
+    if (fo->n != n || fo->p != p)
+        reset_filter_order( fo, n, p, prime_count ) ;
+
+    order  = fo->order ;
+    sample = (fo->candidates++ % ADAPTIVESAMPLERATE == 0) ;
+}
+
+if (timing)
+    start = stage_start() ;
+
+for (k = 0 ;  k < NUMFILTERS && (alive || sample) ;  ++k)
+{
+    stage = order[ k ] ;
+
+    if (sample)
+        sample_start = stage_clock() ;
+
+    passed = run_stage( stage, &t, stats, alive, &start ) ;
+
+    /*  Const coeff. of f(x)*(-1)^n must equal a mod p. */
+    if (passed && stage == ORDERRSTAGE)
+        passed = run_stage( CONSTTESTSTAGE, &t, stats, alive, &start ) ;
+
+    if (sample)
+    {
+        fo->nanosec[ stage ] += (double) (stage_clock() - sample_start) ;
+        fo->calls  [ stage ] += 1.0 ;
+        fo->passed [ stage ] += passed ? 1.0 : 0.0 ;
+    }
+
+    if (!passed)
+        alive = NO ;
+}
+
+if (sample && ++fo->samples == ADAPTIVEREORDER)
+    reorder_filters( fo ) ;
+
+return alive ;
+
+} /* ============= end of function passes_primitivity_tests ================= */
+
+
+
+/*==============================================================================
+|                             set_adaptive_order                               |
+================================================================================
+
+DESCRIPTION
+
+     Turn reordering of the tests on or off (--adaptive).
+
+INPUT
+
+     on (int)          YES to reorder them.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void set_adaptive_order( int on )
+{
+adaptive_order = on ;
+
+} /* ================= end of function set_adaptive_order =================== */
+
+
+
+/*==============================================================================
+|                                  run_stage                                   |
+================================================================================
+
+DESCRIPTION
+
+     Do one test, building the power table first if the test needs it and
+     we don't have it yet.
+
+INPUT
+
+     stage  (int)                CONSTCOEFFSTAGE ... ORDERMSTAGE
+     t      (TrialPoly *)        The trial polynomial.
+     record (int)                YES to count and time the test, NO when
+                                 the polynomial already failed another and
+                                 we're only measuring.
+     start  (bigint *)           When the test began, for --timing.
+
+OUTPUT
+
+     t                           The power table, and a after order r.
+     stats  (SearchStatistics *) Counted if it passed, and timed.
+     start                       When the next test begins.
+
+RETURNS
+
+     YES if f(x) passed.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int run_stage( int stage, TrialPoly * t, SearchStatistics * stats,
+                      int record, bigint * start )
+{
+int passed = NO ;
+int timing = record && stage_timing_enabled() ;
+
+TRACE_DECLARE( trace_start ) ;
+
+/*                         n         2n-2
+    Precompute the powers x ,  ..., x     (mod f(x), p)
+    for use in all later computations.
+*/
+if (!t->have_power_table && stage != CONSTCOEFFSTAGE && stage != LINEARSTAGE)
+{
+    TRACE_BEGIN( trace_start ) ;
+    construct_power_table( t->power_table, t->f, t->n, t->p ) ;
+    TRACE_END( "power table", trace_start ) ;
+
+    t->have_power_table = YES ;
+
+    if (timing)
+        *start = record_stage( stats, POWERTABLESTAGE, *start ) ;
+}
+
+TRACE_BEGIN( trace_start ) ;
+
+switch (stage)
+{
+    /* Constant coefficient of f(x) * (-1)^n must be a primitive root of p. */
+    case CONSTCOEFFSTAGE:
+        passed = const_coeff_is_primitive_root( t->f, t->n, t->p ) ;
+        TRACE_END( "const coeff", trace_start ) ;
+    break ;
+
+    /* f(x) can't have any linear factors. */
+    case LINEARSTAGE:
+        passed = !linear_factor( t->f, t->n, t->p ) ;
+        TRACE_END( "linear factor", trace_start ) ;
+    break ;
+
+    /* f(x) can't have two or more distinct irreducible factors. */
+    case BERLEKAMPSTAGE:
+        passed = !has_multi_irred_factors( t->power_table, t->n, t->p ) ;
+        TRACE_END( "berlekamp", trace_start ) ;
+    break ;
+
+    /* x^r (mod f(x), p) = a must be an integer. */
+    case ORDERRSTAGE:
+        passed = order_r( t->power_table, t->n, t->p, t->r, &t->a ) ;
+        TRACE_END( "order r", trace_start ) ;
+    break ;
+
+    /*  Const coeff. of f(x)*(-1)^n must equal a mod p. */
+    case CONSTTESTSTAGE:
+        passed = const_coeff_test( t->f, t->n, t->p, t->a ) ;
+        TRACE_END( "const test", trace_start ) ;
+    break ;
+
+    /*  x^m != integer for all m = r / q, q a prime divisor of r. */
+    case ORDERMSTAGE:
+        passed = order_m( t->power_table, t->n, t->p, t->r, t->primes, t->prime_count ) ;
+        TRACE_END( "order m", trace_start ) ;
+    break ;
+}
+
+if (timing)
+    *start = record_stage( stats, stage, *start ) ;
+
+if (passed && record)
+    count_pass( stage, stats ) ;
+
+return passed ;
+
+} /* ===================== end of function run_stage ======================== */
+
+
+
+/*==============================================================================
+|                                 count_pass                                   |
+================================================================================
+
+DESCRIPTION
+
+     Count a polynomial passing one of the tests.
+
+INPUT
+
+     stage (int)                   CONSTCOEFFSTAGE ... ORDERMSTAGE
+
+OUTPUT
+
+     stats (SearchStatistics *)    Its counter goes up by one.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void count_pass( int stage, SearchStatistics * stats )
+{
+switch (stage)
+{
+    case CONSTCOEFFSTAGE:  ++stats->num_const_coeff_prim_root ;     break ;
+    case LINEARSTAGE:      ++stats->num_free_of_linear_factors ;    break ;
+    case BERLEKAMPSTAGE:   ++stats->num_irred_to_power ;            break ;
+    case ORDERRSTAGE:      ++stats->num_order_r ;                   break ;
+    case CONSTTESTSTAGE:   ++stats->num_passing_const_coeff_test ;  break ;
+    case ORDERMSTAGE:      ++stats->num_order_m ;                   break ;
+}
+
+} /* ===================== end of function count_pass ======================= */
+
+
+
+/*==============================================================================
+|                             reset_filter_order                               |
+================================================================================
+
+DESCRIPTION
+
+     Start a thread's order of the tests over for degree n modulo p, from
+     rough estimates of what the tests cost and how often they pass.
+
+INPUT
+
+     n, p (int)              Degree and modulus.
+     prime_count (int)       Distinct prime factors of r, less one.
+
+OUTPUT
+
+     fo (FilterOrder *)      Ordered by the estimates, with no measurements.
+
+METHOD
+
+     Costs are in rough nanoseconds from the operation counts:  the
+     linear factor test evaluates f(x) at p points, Berlekamp's method
+     reduces an n by n matrix, and each power of x takes about n squared
+     log2( p^n ) steps.  The fraction passing is for a random polynomial:
+     (1 - 1/p)^p have no roots, and about 1/n are irreducible.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void reset_filter_order( FilterOrder * fo, int n, int p, int prime_count )
+{
+double power_cost = (double) n * (double) n * (double) n * log2( (double) p ) ;
+int    stage, k ;
+
+fo->n          = n ;
+fo->p          = p ;
+fo->candidates = 0 ;
+fo->samples    = 0 ;
+
+for (stage = 0 ;  stage < NUMSTAGES ;  ++stage)
+{
+    fo->nanosec[ stage ] = 0.0 ;
+    fo->calls  [ stage ] = 0.0 ;
+    fo->passed [ stage ] = 0.0 ;
+}
+
+fo->cost_estimate[ CONSTCOEFFSTAGE ] = 50.0 ;
+fo->pass_estimate[ CONSTCOEFFSTAGE ] = 0.5 ;
+
+fo->cost_estimate[ LINEARSTAGE     ] = 2.0 * (double) n * (double) p ;
+fo->pass_estimate[ LINEARSTAGE     ] = pow( 1.0 - 1.0 / (double) p, (double) p ) ;
+
+fo->cost_estimate[ BERLEKAMPSTAGE  ] = (double) n * (double) n * (double) n ;
+fo->pass_estimate[ BERLEKAMPSTAGE  ] = 2.0 / (double) n ;
+
+fo->cost_estimate[ ORDERRSTAGE     ] = power_cost ;
+fo->pass_estimate[ ORDERRSTAGE     ] = 1.0 / (double) n ;
+
+fo->cost_estimate[ ORDERMSTAGE     ] = power_cost * (double) (prime_count + 1) ;
+fo->pass_estimate[ ORDERMSTAGE     ] = 0.9 ;
+
+for (k = 0 ;  k < NUMFILTERS ;  ++k)
+    fo->order[ k ] = usual_order[ k ] ;
+
+reorder_filters( fo ) ;
+
+} /* ================= end of function reset_filter_order =================== */
+
+
+
+/*==============================================================================
+|                               reorder_filters                                |
+================================================================================
+
+DESCRIPTION
+
+     Sort a thread's tests by time per rejection, then let the
+     measurements so far count half as much as the ones to come.
+
+INPUT
+
+     fo (FilterOrder *)      Measurements, or estimates for tests we
+                             haven't measured.
+
+OUTPUT
+
+     fo                      The new order.
+
+METHOD
+
+     An insertion sort, which keeps ties in the usual order.  A test which
+     never rejects anything goes last.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void reorder_filters( FilterOrder * fo )
+{
+double score[ NUMSTAGES ] ;
+double cost, pass ;
+int    stage, j, k ;
+
+for (k = 0 ;  k < NUMFILTERS ;  ++k)
+{
+    stage = fo->order[ k ] ;
+
+    if (fo->calls[ stage ] >= 1.0)
+    {
+        cost = fo->nanosec[ stage ] / fo->calls[ stage ] ;
+        pass = fo->passed [ stage ] / fo->calls[ stage ] ;
+    }
+    else
+    {
+        cost = fo->cost_estimate[ stage ] ;
+        pass = fo->pass_estimate[ stage ] ;
+    }
+
+    score[ stage ] = (pass < 1.0) ? cost / (1.0 - pass) : HUGE_VAL ;
+}
+
+for (k = 1 ;  k < NUMFILTERS ;  ++k)
+{
+    stage = fo->order[ k ] ;
+
+    for (j = k ;  j > 0 && score[ fo->order[ j - 1 ] ] > score[ stage ] ;  --j)
+        fo->order[ j ] = fo->order[ j - 1 ] ;
+
+    fo->order[ j ] = stage ;
+}
+
+for (stage = 0 ;  stage < NUMSTAGES ;  ++stage)
+{
+    fo->nanosec[ stage ] /= 2.0 ;
+    fo->calls  [ stage ] /= 2.0 ;
+    fo->passed [ stage ] /= 2.0 ;
+}
+
+fo->samples = 0 ;
+
+} /* ================== end of function reorder_filters ===================== */
@@ -12,6 +12,13 @@
 |
 |     initial_trial_poly
 |     next_trial_poly
+|     unrank_trial_poly
+|     random_trial_poly
+|     first_sparse_poly
+|     next_sparse_poly
+|     build_sparse_poly
+|     swan_says_reducible
+|     add_statistics
 |     const_coeff_test
 |     const_coeff_is_primitive_root
 |     skip_test
@@ -53,6 +60,9 @@
 #include "Primpoly.h"
 
 
+static void build_sparse_poly( SparseTrialPoly * s, int * f, int n ) ;
+
+
 /*==============================================================================
 |                             initial_trial_poly                               |
 ================================================================================
@@ -188,6 +198,447 @@ for (digit_num = 0 ;  digit_num <= n - 2 ;  ++digit_num)
 } /* ================= end of function next_trial_poly ====================== */
 
 
+/*==============================================================================
+|                               unrank_trial_poly                              |
+================================================================================
+
+DESCRIPTION
+
+    Jump directly to the kth polynomial in the sequence produced by
+    next_trial_poly, without stepping through the ones before it.
+
+INPUT
+                   
+    n (int, n >= 1)     Degree of monic polynomial f(x).
+    p (int, p >= 2)     Modulo p coefficient arithmetic.
+    k (bigint)          Position in the sequence, 0 <= k <= p^n.  k = 0 is
+                                        n
+                        the first one, x .
+
+RETURNS
+
+    f (int *)           The kth polynomial after initial_trial_poly, i.e.
+                        what we would have after calling next_trial_poly
+                        k + 1 times.
+
+EXAMPLE 
+                                          3
+    Let n = 3, p = 5 and k = 7.  Then f(x) = x  + x + 2, since 7 = 1 2 in
+    base 5.
+
+METHOD
+
+    Write k as an n digit number in base p.  The digits are the coefficients
+    of f(x), least significant digit first.  As in next_trial_poly, the
+    x^(n-1) digit is never reduced, so k = p^n gives the one polynomial
+    past the end of the sequence with f[ n-1 ] = p.
+
+BUGS
+
+    None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void 
+    unrank_trial_poly( int * f, int n, int p, bigint k )
+{
+
+/*------------------------------------------------------------------------------
+|                               Local Variables                                |
+------------------------------------------------------------------------------*/
+
+int
+    digit_num ;   /*  Loop counter and digit number. */
+
+/*------------------------------------------------------------------------------
+|                                Function Body                                 |
+------------------------------------------------------------------------------*/
+
+for (digit_num = 0 ;  digit_num <= n - 2 ;  ++digit_num)
+{
+    f[ digit_num ] = (int)(k % (bigint) p) ;
+    k /= (bigint) p ;
+}
+
+f[ n - 1 ] = (int) k ;
+f[ n ]     = 1 ;
+
+} /* ================= end of function unrank_trial_poly ==================== */
+
+
+
+/*==============================================================================
+|                              random_trial_poly                               |
+================================================================================
+
+DESCRIPTION
+
+    Pick a monic polynomial of degree n modulo p at random.
+
+INPUT
+                   
+    n     (int, n >= 1)        Degree of monic polynomial f(x).
+    p     (int, p >= 2)        Modulo p coefficient arithmetic.
+    state (unsigned long long *)  Generator state for next_random.
+
+RETURNS
+
+    f (int *)           A monic polynomial.  Each of the p^n possible ones
+                        is equally likely.
+
+EXAMPLE 
+                                          3      2
+    Let n = 3 and p = 5.  We might get x  + 4 x  + 2.
+
+METHOD
+
+    Draw each coefficient below x^n independently with random_residue.
+
+BUGS
+
+    None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void 
+    random_trial_poly( int * f, int n, int p, unsigned long long * state )
+{
+int i ;
+
+for (i = 0 ;  i <= n - 1 ;  ++i)
+    f[ i ] = random_residue( state, p ) ;
+
+f[ n ] = 1 ;
+
+} /* ================= end of function random_trial_poly ==================== */
+
+
+
+/*==============================================================================
+|                              first_sparse_poly                               |
+================================================================================
+
+DESCRIPTION
+
+    Start going through all monic polynomials of degree n modulo p which
+    have exactly a given number of non-zero terms.
+
+INPUT
+                   
+    n      (int, n >= 1)     Degree of f(x).
+    p      (int, p >= 2)     Modulo p coefficient arithmetic.
+    weight (int)             Number of non-zero terms, counting x^n and the
+                             constant term.
+
+OUTPUT
+
+    s (SparseTrialPoly *)    Where we are in the sequence.
+    f (int *)                The first polynomial of this weight.
+
+RETURNS
+
+    YES    if there are polynomials of this weight.
+    NO     if weight is out of the range 2 to n + 1.
+
+EXAMPLE 
+                                                          5    2
+    Let n = 5, p = 2, weight = 4.  The first one is f(x) = x  + x  + x + 1.
+
+METHOD
+
+    Put the middle terms at the lowest exponents 1, 2, ..., weight-2
+    and make every coefficient 1.
+
+BUGS
+
+    None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int first_sparse_poly( SparseTrialPoly * s, int * f, int n, int p, int weight )
+{
+int i ;
+
+if (weight < 2 || weight > n + 1 || p < 2)
+    return NO ;
+
+s->weight = weight ;
+
+for (i = 0 ;  i <= weight - 2 ;  ++i)
+{
+    s->exponent[ i ] = i ;
+    s->coeff[ i ]    = 1 ;
+}
+
+build_sparse_poly( s, f, n ) ;
+
+return YES ;
+
+} /* ================= end of function first_sparse_poly ==================== */
+
+
+
+/*==============================================================================
+|                               next_sparse_poly                               |
+================================================================================
+
+DESCRIPTION
+
+    Step to the next polynomial with the same number of non-zero terms.
+
+INPUT
+                   
+    s (SparseTrialPoly *)    Where we are in the sequence.
+    n (int, n >= 1)          Degree of f(x).
+    p (int, p >= 2)          Modulo p coefficient arithmetic.
+
+OUTPUT
+
+    s (SparseTrialPoly *)    Advanced to the next polynomial.
+    f (int *)                The next polynomial.
+
+RETURNS
+
+    YES    if there was a next polynomial.
+    NO     if we've been through all of them.
+
+EXAMPLE 
+                                           5    3                   5      3
+    Let n = 5, p = 3, weight = 3 and f(x) = x  + x  + 2.  Next is x  + 2 x  + 1.
+                    5      3                 5    4
+    The one after  x  + 2 x  + 2  is then  x  + x  + 1.
+
+METHOD
+
+    First run through all p-1 non-zero values of each coefficient like the
+    digits of an odometer, the constant term turning fastest.  When they
+    have all rolled over, move the middle exponents to the next set of
+    weight-2 distinct exponents between 1 and n-1.  The sets are taken in
+    colexicographic order:  the highest exponent changes slowest, so terms
+    of low degree are tried first.  Each step advances the lowest exponent
+    which has room to move up and packs the ones below it back down to
+    1, 2, 3, ...
+
+BUGS
+
+    None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int next_sparse_poly( SparseTrialPoly * s, int * f, int n, int p )
+{
+int i, j ;
+int num_middle = s->weight - 2 ;  /* Number of middle terms. */
+int next_exponent ;
+
+/* Next set of non-zero coefficients. */
+for (i = 0 ;  i <= s->weight - 2 ;  ++i)
+{
+    if (++s->coeff[ i ] < p)
+    {
+        build_sparse_poly( s, f, n ) ;
+        return YES ;
+    }
+
+    s->coeff[ i ] = 1 ;
+}
+
+/* Next set of exponents for the middle terms. */
+for (i = 1 ;  i <= num_middle ;  ++i)
+{
+    next_exponent = (i < num_middle) ? s->exponent[ i + 1 ] : n ;
+
+    if (s->exponent[ i ] + 1 < next_exponent)
+    {
+        ++s->exponent[ i ] ;
+
+        for (j = 1 ;  j < i ;  ++j)
+            s->exponent[ j ] = j ;
+
+        build_sparse_poly( s, f, n ) ;
+        return YES ;
+    }
+}
+
+return NO ;
+
+} /* ================== end of function next_sparse_poly ==================== */
+
+
+
+/*==============================================================================
+|                              build_sparse_poly                               |
+================================================================================
+
+DESCRIPTION
+
+    Fill in the coefficients of f(x) from its exponents and non-zero
+    coefficients.
+
+INPUT
+                   
+    s (SparseTrialPoly *)    Exponents and coefficients.
+    n (int, n >= 1)          Degree of f(x).
+
+OUTPUT
+
+    f (int *)                The monic polynomial of degree n.
+
+BUGS
+
+    None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void build_sparse_poly( SparseTrialPoly * s, int * f, int n )
+{
+int i ;
+
+for (i = 0 ;  i <= n - 1 ;  ++i)
+    f[ i ] = 0 ;
+
+for (i = 0 ;  i <= s->weight - 2 ;  ++i)
+    f[ s->exponent[ i ] ] = s->coeff[ i ] ;
+
+f[ n ] = 1 ;
+
+} /* ================= end of function build_sparse_poly ==================== */
+
+
+
+/*==============================================================================
+|                             swan_says_reducible                              |
+================================================================================
+
+DESCRIPTION
+                                           n    k
+    Use Swan's theorem to see if trinomial x  + x  + 1 is reducible
+    modulo 2, without doing any polynomial arithmetic.
+
+INPUT
+                   
+    n (int, n >= 2)          Degree of the trinomial.
+    k (int, 0 < k < n)       Exponent of the middle term.
+
+RETURNS
+
+    YES    if the trinomial is certainly reducible modulo 2.
+    NO     if the theorem can't tell.
+
+EXAMPLE 
+                   8    k
+    Every trinomial x  + x  + 1 is reducible, and for n = 8 we always
+    return YES.  For n = 4, k = 1 we return NO, and x^4 + x + 1 is in fact
+    primitive.
+
+METHOD
+
+    R. G. Swan, "Factorization of polynomials over finite fields," Pacific
+    J. Math. 12 (1962).  Let exactly one of n, k be odd.  Then the
+    trinomial has an even number of irreducible factors, so is reducible,
+    exactly when
+
+        n even, k odd, n != 2k, and nk/2 = 0 or 1 (mod 4), or
+        n odd,  k even, k does not divide 2n, and n = 3 or 5 (mod 8), or
+        n odd,  k even, k divides 2n, and n = 1 or 7 (mod 8).
+
+    When n and k are both odd, apply the theorem to the reciprocal
+    trinomial, k -> n - k, which factors the same way.  When both are even
+    the trinomial is the square of x^(n/2) + x^(k/2) + 1.
+
+    About 60% of trinomials are thrown out this way before testing.
+
+BUGS
+
+    None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int swan_says_reducible( int n, int k )
+{
+
+if (n % 2 == 0 && k % 2 == 0)
+    return YES ;
+
+if (n % 2 != 0 && k % 2 != 0)
+    k = n - k ;
+
+if (n % 2 == 0)
+    return (n != 2 * k && ((n / 2) * k) % 4 <= 1) ? YES : NO ;
+
+if ((2 * n) % k != 0)
+    return (n % 8 == 3 || n % 8 == 5) ? YES : NO ;
+else
+    return (n % 8 == 1 || n % 8 == 7) ? YES : NO ;
+
+} /* ================ end of function swan_says_reducible =================== */
+
+
+
+/*==============================================================================
+|                                add_statistics                                |
+================================================================================
+
+DESCRIPTION
+
+    Add one set of search statistics into another.
+
+INPUT
+
+    total (SearchStatistics *)  Running totals.
+    part  (SearchStatistics *)  Counts from part of the search.
+
+OUTPUT
+
+    total (SearchStatistics *)  total + part, counter by counter.
+
+BUGS
+
+    None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void add_statistics( SearchStatistics * total, SearchStatistics * part )
+{
+int stage, bucket, k ;
+
+total->num_poly                     += part->num_poly ;
+total->num_const_coeff_prim_root    += part->num_const_coeff_prim_root ;
+total->num_free_of_linear_factors   += part->num_free_of_linear_factors ;
+total->num_irred_to_power           += part->num_irred_to_power ;
+total->num_order_r                  += part->num_order_r ;
+total->num_passing_const_coeff_test += part->num_passing_const_coeff_test ;
+total->num_order_m                  += part->num_order_m ;
+
+for (stage = 0 ;  stage < NUMSTAGES ;  ++stage)
+{
+    total->stage_calls[ stage ]   += part->stage_calls[ stage ] ;
+    total->stage_nanosec[ stage ] += part->stage_nanosec[ stage ] ;
+
+    for (k = 0 ;  k < NUMHWCOUNTERS ;  ++k)
+        total->stage_counters[ stage ][ k ] += part->stage_counters[ stage ][ k ] ;
+
+    for (bucket = 0 ;  bucket < NUMTIMEBUCKETS ;  ++bucket)
+        total->stage_histogram[ stage ][ bucket ] += part->stage_histogram[ stage ][ bucket ] ;
+}
+
+} /* ==================== end of function add_statistics ==================== */
+
+
 /*==============================================================================
 |                               const_coeff_test                               |
 ================================================================================
@@ -438,17 +889,18 @@ BUGS
 
 int has_multi_irred_factors( int power_table[][ MAXDEGPOLY ], int n, int p )
 {
-    int ** Q ;
+    int   Q_space[ MAXDEGPOLY ][ MAXDEGPOLY ] ;
+    int * Q[ MAXDEGPOLY ] ;
     int row ;
 	int nullity = 0 ;
 
 
-    /* Allocate space for the Q matrix. */
-    Q = (int **) calloc( n, sizeof( int * ) ) ;
-
+    /* Space for the Q matrix on the stack, so we are safe to call from
+       several threads and don't pay for calloc on every trial polynomial. */
     for (row = 0 ;  row < n ;  ++row)
     {
-        Q[ row ] = (int *)calloc( n, sizeof( int ) ) ;
+        Q[ row ] = Q_space[ row ] ;
+        memset( Q[ row ], 0, (size_t) n * sizeof( int ) ) ;
     }
 
 
@@ -459,14 +911,6 @@ int has_multi_irred_factors( int power_table[][ MAXDEGPOLY ], int n, int p )
 	/* Find nullity of Q-I */
     nullity = find_nullity( Q, n, p ) ;
 
-    /* Free space for the Q matrix. */
-    for (row = 0 ;  row < n ;  ++row)
-    {
-        free( Q[ row ] ) ;
-    }
-
-    free( Q ) ;
-
 
 	/* If nullity >= 2, f( x ) is a reducible polynomial modulo p since it has  */
 	/* two or more distinct irreducible factors.                                */
@@ -12,6 +12,9 @@
 |
 |      parse_command_line
 |      write_poly
+|      string_to_bigint
+|      set_listing_format
+|      write_listing_entry
 |
 |  LEGAL
 |
@@ -42,6 +45,9 @@
 
 #include <stdio.h>  /* for printf()  */
 #include <stdlib.h> /* for _MAX_PATH */
+#include <ctype.h>  /* for isdigit() */
+#include <string.h> /* for strcmp()  */
+#include <time.h>   /* for time()    */
 
 #include "Primpoly.h"
 
@@ -55,19 +61,15 @@ DESCRIPTION
      Parse the command line.
 
 INPUT
-                                                                     n
-     a[]  (int *)  Coefficients of the nth degree polynomial a(x) = a x  + ...
-                                                                     n
-                   + a  x  +  a.    a  is stored at array location a[i], 
-                      1        0     i
-                   0 <= i < n .
 
-     n    (int)    The polynomial's degree.
+     argc, argv        The command line, as passed to main.
 
 OUTPUT
 
-  testPolynomialForPrimitivity 
-    
+     options  (PrimpolyOptions *)  The options, each YES or NO or with its
+                       value, the file names which follow them, and p and n.
+                       Anything not on the command line gets its default.
+                       printHelp is YES if we couldn't make sense of it.
 
 EXAMPLE CALLING SEQUENCE
 
@@ -76,6 +78,44 @@ EXAMPLE CALLING SEQUENCE
    pp -t 2 4 x^3+x^2+1     Checks a polynomial for primitivity.  No blanks, please!
    pp -a 2 4               Lists all primitive polynomials of degree 4 modulo 2.
    pp -c 2 4               Does a time-consuming double check on primitivity.
+   pp -j 8 2 40            Finds a primitive polynomial using 8 threads.
+   pp -a -j 8 2 20         Lists all primitive polynomials using 8 threads.
+   pp -r 2 40              Finds a primitive polynomial by random sampling.
+   pp -r 1234 2 40         ... with the random number generator seed 1234.
+   pp --seed 1234 2 40     ... the same.
+   pp -w 2 40              Finds a primitive polynomial with the fewest terms.
+   pp -a -m 2 20           Lists all primitive polynomials from one of them.
+   pp -a -m --unsorted 2 30
+                           ... printing each as it's found, in no order.
+   pp -a -i 2 20           Lists all, testing one of each reciprocal pair.
+   pp -a --checkpoint pp.state 2 40 > list.txt
+                           Saves the search state every minute or so.
+   pp -a --resume pp.state 2 40 >> list.txt
+                           Picks up where the last checkpoint left off.
+   pp -a --shard 2/3 2 40 > s2
+                           Searches the second third of the polynomials.
+   pp -a --merge s1 --merge s2 --merge s3 2 40
+                           Puts the three shards together.
+   pp -a --format hex 2 8  Lists all as bit masks like 0x11D, one per line.
+   pp --timing text 2 20   Prints the time taken by each test;  also json.
+   pp --counters 2 20      Adds cycles, cache misses, etc. to --timing or --bench.
+   pp -a --progress 2 30 > list.txt
+                           Reports the rate and time left to stderr.
+   pp -a --adaptive 251 4  Reorders the tests to reject polynomials soonest.
+   pp -a --lanes 5 10      Tests 8 trial polynomials at a time.
+   pp --trace t.json --trace-sample 10 2 30
+                           Traces every 10th trial poly (-DPP_TRACE builds).
+   pp -a --archive deg20.ppa 2 20
+                           Lists all to a binary archive file.
+   pp -a --read-archive deg20.ppa 2 20
+                           Lists all from the archive, without searching.
+   pp --batch queries.txt  Answers the queries in the file;  - for stdin.
+   pp --serve /tmp/pp.sock Answers queries sent to the socket.
+   pp --client /tmp/pp.sock
+                           Sends queries from stdin to the server.
+   pp --bench --baseline b.txt
+                           Benchmarks, saving the results;  --compare b.txt
+                           compares with them.
 
 METHOD
 
@@ -92,17 +132,11 @@ BUGS
 
 int parse_command_line( int    argc, 
 					    char * argv[], 
-                        int *  testPolynomialForPrimitivity,
-                        int *  listAllPrimitivePolynomials,
-                        int *  printStatistics,
-                        int *  printHelp,
-                        int *  selfCheck,
-                        int *  p,
-                        int *  n,
-                        int *  testPolynomial )
+                        PrimpolyOptions * options )
 {
 
 int    input_arg_index ;
+int    seed_given = NO ;
 char * input_arg_string ;
 char * option_ptr ;
 
@@ -110,14 +144,42 @@ int    num_arg ;
 char * arg_string[ _MAX_PATH ] ;
 
 /*  Initialize to defaults. */
-*testPolynomialForPrimitivity = NO ;
-*listAllPrimitivePolynomials  = NO ;
-*printStatistics              = NO ;
-*printHelp                    = NO ;
-*selfCheck                    = NO ;
-*p                            = 0 ;
-*n                            = 0 ;
-testPolynomial                = (int *) 0 ;
+options->testPolynomialForPrimitivity = NO ;
+options->listAllPrimitivePolynomials  = NO ;
+options->printStatistics              = NO ;
+options->printHelp                    = NO ;
+options->selfCheck                    = NO ;
+options->numThreads                   = 1 ;
+options->randomSearch                 = NO ;
+options->randomSeed                   = 0 ;
+options->lowWeightSearch              = NO ;
+options->minimalPolySearch            = NO ;
+options->unsortedMinimalPolys         = NO ;
+options->reciprocalPairs              = NO ;
+options->checkpointFile               = (char *) 0 ;
+options->resume                       = NO ;
+options->shard                        = 0 ;
+options->numShards                    = 0 ;
+options->numMergeFiles                = 0 ;
+options->listingFormat                = TEXTFORMAT ;
+options->timingFormat                 = NOTIMING ;
+options->hardwareCounters             = NO ;
+options->showProgress                 = NO ;
+options->adaptiveOrder                = NO ;
+options->useLanes                     = NO ;
+options->traceFile                    = (char *) 0 ;
+options->traceSample                  = 1 ;
+options->archiveFile                  = (char *) 0 ;
+options->readArchiveFile              = (char *) 0 ;
+options->factorTableFile              = (char *) 0 ;
+options->batchFile                    = (char *) 0 ;
+options->serveSocket                  = (char *) 0 ;
+options->clientSocket                 = (char *) 0 ;
+options->bench                        = NO ;
+options->benchBaseline                = (char *) 0 ;
+options->benchCompare                 = (char *) 0 ;
+options->p                            = 0 ;
+options->n                            = 0 ;
 
 
 /*
@@ -130,8 +192,176 @@ for (input_arg_index = 0, num_arg = 0 ;  input_arg_index < argc ;
     /*  Get next argument string. */
     input_arg_string = argv[ input_arg_index ] ;
 
+    /* Save the search state to a file now and then.  Or read it back in
+       and carry on.  The file name is the next argument. */
+    if (strcmp( input_arg_string, "--checkpoint" ) == 0 ||
+        strcmp( input_arg_string, "--resume" ) == 0)
+    {
+        if (input_arg_string[ 2 ] == 'r')
+            options->resume = YES ;
+
+        if (input_arg_index + 1 < argc)
+            options->checkpointFile = argv[ ++input_arg_index ] ;
+        else
+            printf( "ERROR:  Expecting a file name after %s.\n", input_arg_string ) ;
+    }
+    /* Search only shard k of N, written k/N. */
+    else if (strcmp( input_arg_string, "--shard" ) == 0)
+    {
+        if (input_arg_index + 1 >= argc ||
+            sscanf( argv[ ++input_arg_index ], "%d/%d", &options->shard, &options->numShards ) != 2)
+            printf( "ERROR:  Expecting k/N after --shard.\n" ) ;
+    }
+    /* Merge the output of a shard.  Give one of these for each. */
+    else if (strcmp( input_arg_string, "--merge" ) == 0)
+    {
+        if (input_arg_index + 1 < argc && options->numMergeFiles < _MAX_PATH)
+            options->mergeFiles[ options->numMergeFiles++ ] = argv[ ++input_arg_index ] ;
+        else
+            printf( "ERROR:  Expecting a shard file name after --merge.\n" ) ;
+    }
+    /* How to print the listing:  text, hex, dense or jsonl. */
+    else if (strcmp( input_arg_string, "--format" ) == 0)
+    {
+        input_arg_string = (input_arg_index + 1 < argc) ? argv[ ++input_arg_index ] : "" ;
+
+        if      (strcmp( input_arg_string, "text" ) == 0)   options->listingFormat = TEXTFORMAT ;
+        else if (strcmp( input_arg_string, "hex" ) == 0)    options->listingFormat = HEXFORMAT ;
+        else if (strcmp( input_arg_string, "dense" ) == 0)  options->listingFormat = DENSEFORMAT ;
+        else if (strcmp( input_arg_string, "jsonl" ) == 0)  options->listingFormat = JSONFORMAT ;
+        else
+        {
+            printf( "ERROR:  Expecting text, hex, dense or jsonl after --format.\n" ) ;
+            options->printHelp = YES ;
+        }
+    }
+    /* Time the stages of the tests, and print the times as text or json. */
+    else if (strcmp( input_arg_string, "--timing" ) == 0)
+    {
+        input_arg_string = (input_arg_index + 1 < argc) ? argv[ ++input_arg_index ] : "" ;
+
+        if      (strcmp( input_arg_string, "text" ) == 0)  options->timingFormat = TEXTTIMING ;
+        else if (strcmp( input_arg_string, "json" ) == 0)  options->timingFormat = JSONTIMING ;
+        else
+        {
+            printf( "ERROR:  Expecting text or json after --timing.\n" ) ;
+            options->printHelp = YES ;
+        }
+    }
+    /* Write a trace of the search, of every so many trial polynomials. */
+    else if (strcmp( input_arg_string, "--trace" ) == 0)
+    {
+        if (input_arg_index + 1 < argc)
+            options->traceFile = argv[ ++input_arg_index ] ;
+        else
+            printf( "ERROR:  Expecting a file name after --trace.\n" ) ;
+    }
+    else if (strcmp( input_arg_string, "--trace-sample" ) == 0)
+    {
+        if (input_arg_index + 1 < argc)
+            options->traceSample = strtoull( argv[ ++input_arg_index ], (char **) 0, 10 ) ;
+
+        if (options->traceSample < 1)
+        {
+            printf( "ERROR:  Expecting a number of 1 or more after --trace-sample.\n" ) ;
+            options->printHelp = YES ;
+        }
+    }
+    /* Count cycles, cache misses and so on for --timing and --bench. */
+    else if (strcmp( input_arg_string, "--counters" ) == 0)
+        options->hardwareCounters = YES ;
+    /* Report how far the search has got every so often. */
+    else if (strcmp( input_arg_string, "--progress" ) == 0)
+        options->showProgress = YES ;
+    /* Put the tests in the order which is fastest for this p and n. */
+    else if (strcmp( input_arg_string, "--adaptive" ) == 0)
+        options->adaptiveOrder = YES ;
+    /* With -m, list each polynomial as soon as we find it. */
+    else if (strcmp( input_arg_string, "--unsorted" ) == 0)
+        options->unsortedMinimalPolys = YES ;
+    /* Test several trial polynomials at once. */
+    else if (strcmp( input_arg_string, "--lanes" ) == 0)
+        options->useLanes = YES ;
+    /* Write the listing to a binary archive file, or read one back. */
+    else if (strcmp( input_arg_string, "--archive" ) == 0 ||
+             strcmp( input_arg_string, "--read-archive" ) == 0)
+    {
+        if (input_arg_index + 1 >= argc)
+            printf( "ERROR:  Expecting a file name after %s.\n", input_arg_string ) ;
+        else if (input_arg_string[ 2 ] == 'a')
+        {
+            options->archiveFile   = argv[ ++input_arg_index ] ;
+            options->listingFormat = ARCHIVEFORMAT ;
+        }
+        else
+            options->readArchiveFile = argv[ ++input_arg_index ] ;
+    }
+    /* Known factorizations of p^n - 1 and p^n + 1. */
+    else if (strcmp( input_arg_string, "--factors" ) == 0)
+    {
+        if (input_arg_index + 1 < argc)
+            options->factorTableFile = argv[ ++input_arg_index ] ;
+        else
+            printf( "ERROR:  Expecting a file name after --factors.\n" ) ;
+    }
+    /* Answer queries from a file, or - for standard input. */
+    else if (strcmp( input_arg_string, "--batch" ) == 0)
+    {
+        if (input_arg_index + 1 < argc)
+            options->batchFile = argv[ ++input_arg_index ] ;
+        else
+            printf( "ERROR:  Expecting a file name after --batch.\n" ) ;
+    }
+    /* Serve queries on a socket, or send them to a server. */
+    else if (strcmp( input_arg_string, "--serve" ) == 0 ||
+             strcmp( input_arg_string, "--client" ) == 0)
+    {
+        if (input_arg_index + 1 < argc)
+        {
+            if (input_arg_string[ 2 ] == 's')
+                options->serveSocket  = argv[ ++input_arg_index ] ;
+            else
+                options->clientSocket = argv[ ++input_arg_index ] ;
+        }
+        else
+            printf( "ERROR:  Expecting a socket name after %s.\n", input_arg_string ) ;
+    }
+    /* Seed for the random search. */
+    else if (strcmp( input_arg_string, "--seed" ) == 0)
+    {
+        if (input_arg_index + 1 < argc &&
+            isdigit( (unsigned char) argv[ input_arg_index + 1 ][ 0 ] ))
+        {
+            options->randomSearch = YES ;
+            options->randomSeed   = strtoull( argv[ ++input_arg_index ], (char **) 0, 10 ) ;
+            seed_given = YES ;
+        }
+        else
+        {
+            printf( "ERROR:  Expecting a number after --seed.\n" ) ;
+            options->printHelp = YES ;
+        }
+    }
+    /* Benchmark, saving the results to a file or comparing with one. */
+    else if (strcmp( input_arg_string, "--bench" ) == 0)
+        options->bench = YES ;
+    else if (strcmp( input_arg_string, "--baseline" ) == 0 ||
+             strcmp( input_arg_string, "--compare" ) == 0)
+    {
+        if (input_arg_index + 1 < argc)
+        {
+            options->bench = YES ;
+
+            if (input_arg_string[ 2 ] == 'b')
+                options->benchBaseline = argv[ ++input_arg_index ] ;
+            else
+                options->benchCompare  = argv[ ++input_arg_index ] ;
+        }
+        else
+            printf( "ERROR:  Expecting a file name after %s.\n", input_arg_string ) ;
+    }
     /* We have an option:  a hyphen followed by a non-null string. */
-    if (input_arg_string[ 0 ] == '-' && input_arg_string[ 1 ] != '\0')
+    else if (input_arg_string[ 0 ] == '-' && input_arg_string[ 1 ] != '\0')
     {
         /* Scan all options. */
         for (option_ptr = input_arg_string + 1 ;  *option_ptr != '\0' ;
@@ -141,28 +371,56 @@ for (input_arg_index = 0, num_arg = 0 ;  input_arg_index < argc ;
             {
                 /* Test a given polynomial for primitivity. */
                 case 't':
-                    *testPolynomialForPrimitivity = YES ;
+                    options->testPolynomialForPrimitivity = YES ;
                 break ;
 
                 /* List all primitive polynomials.  */
                 case 'a':
-                   *listAllPrimitivePolynomials = YES ;
+                   options->listAllPrimitivePolynomials = YES ;
+                break ;
+
+                /* Try polynomials with the fewest terms first. */
+                case 'w':
+                   options->lowWeightSearch = YES ;
+                break ;
+
+                /* List all as minimal polynomials of powers of one primitive root. */
+                case 'm':
+                   options->minimalPolySearch = YES ;
+                break ;
+
+                /* Test only one polynomial of each reciprocal pair. */
+                case 'i':
+                   options->reciprocalPairs = YES ;
                 break ;
 
                 /* Print statistics on program operation. */
                 case 's':
-                   *printStatistics = YES ;
+                   options->printStatistics = YES ;
                 break ;
 
                 /* Print help. */
                 case 'h':
 				case 'H':
-                    *printHelp = YES ;
+                    options->printHelp = YES ;
                 break ;
 
                 /* Turn on all self-checking (slow!).  */
                 case 'c':
-					*selfCheck = YES ;
+					options->selfCheck = YES ;
+                break ;
+
+                /* Number of threads to search with.  It's the next argument. */
+                case 'j':
+                    if (input_arg_index + 1 < argc)
+                        options->numThreads = atoi( argv[ ++input_arg_index ] ) ;
+                    else
+                        printf( "ERROR:  Expecting the number of threads after -j.\n" ) ;
+                break ;
+
+                /* Search by random sampling.  A seed may come before p and n. */
+                case 'r':
+                    options->randomSearch = YES ;
                 break ;
 
                 default:
@@ -178,17 +436,41 @@ for (input_arg_index = 0, num_arg = 0 ;  input_arg_index < argc ;
 }
 
 
+/* With -r, a third argument before p and n is the seed.  Look only after
+   all the options are parsed so their values aren't taken for it. */
+if (num_arg == 4 && options->randomSearch && !seed_given &&
+    strspn( arg_string[ 1 ], "0123456789" ) == strlen( arg_string[ 1 ] ))
+{
+    options->randomSeed = strtoull( arg_string[ 1 ], (char **) 0, 10 ) ;
+    seed_given = YES ;
+
+    arg_string[ 1 ] = arg_string[ 2 ] ;
+    arg_string[ 2 ] = arg_string[ 3 ] ;
+    num_arg = 3 ;
+}
+
+/* Otherwise seed with the time. */
+if (options->randomSearch && !seed_given)
+    options->randomSeed = (unsigned long long) time( (time_t *) 0 ) ;
+
 /* Assume the next two arguments are p and n. */
 if (num_arg == 3)
 {
-    *p = atoi( arg_string[ 1 ] ) ;
-    *n = atoi( arg_string[ 2 ] ) ;
+    options->p = atoi( arg_string[ 1 ] ) ;
+    options->n = atoi( arg_string[ 2 ] ) ;
 
 }
+/* Each query in a batch or to a server has its own p and n. */
+else if (num_arg == 1 && (options->batchFile != (char *) 0 || options->serveSocket != (char *) 0 ||
+                          options->clientSocket != (char *) 0))
+    ;
+/* Benchmark the built in set of p and n. */
+else if (num_arg == 1 && options->bench)
+    options->p = options->n = 0 ;
 else
 {
     printf( "ERROR:  Expecting two arguments, p and n.\n\n" ) ;
-	*printHelp = YES ;
+	options->printHelp = YES ;
 }
 
 return 0 ;
@@ -237,7 +519,8 @@ EXAMPLE CALLING SEQUENCE
 
 METHOD
 
-    Sheer hacking ingenuity (vulgarity?).
+    Sheer hacking ingenuity (vulgarity?).  The work is done by put_poly, so
+    listings can share it without going through printf.
 
 BUGS
 
@@ -249,75 +532,221 @@ BUGS
 
 void write_poly( int * a, int n )
 {
+put_poly( a, n ) ;
+flush_output() ;
 
-/*------------------------------------------------------------------------------
-|                               Local Variables                                |
+} /* ======================= end of function write_poly ===================== */
+
+
+
+/*==============================================================================
+|                              string_to_bigint                                |
+================================================================================
+
+DESCRIPTION
+
+     Read a bigint written in decimal, the inverse of bigint_string.  Unlike
+     strtoull or sscanf( "%llu" ), it works for every width of bigint.
+
+INPUT
+
+     s (const char *)   The digits, and nothing else.
+
+OUTPUT
+
+     x (bigint *)       The number.
+
+RETURNS
+
+     YES if s was a number which fits in a bigint, NO otherwise.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
 ------------------------------------------------------------------------------*/
 
-int
-    k,                         /*  Loop conter. */
-    coeff,                     /*  Coefficient a sub k.  */
-    first_time_through = YES,  /* = NO after printing the first coefficient. */
-    num_terms = 0 ;            /*  Number of terms printed so far.  */
+int string_to_bigint( const char * s, bigint * x )
+{
+bigint value = 0 ;
+int    digit ;
 
-/*------------------------------------------------------------------------------
-|                                Function Body                                 |
+if (*s == '\0')
+    return NO ;
+
+for ( ;  *s != '\0' ;  ++s)
+{
+    if (*s < '0' || *s > '9')
+        return NO ;
+
+    digit = *s - '0' ;
+
+    if (value > (~(bigint) 0 - (bigint) digit) / 10)
+        return NO ;
+
+    value = 10 * value + (bigint) digit ;
+}
+
+*x = value ;
+return YES ;
+
+} /* ================== end of function string_to_bigint ==================== */
+
+
+
+/*==============================================================================
+|                              set_listing_format                              |
+================================================================================
+
+DESCRIPTION
+
+     Choose how write_listing_entry prints the polynomials.
+
+INPUT
+
+     format (int)   TEXTFORMAT, HEXFORMAT, DENSEFORMAT, JSONFORMAT or
+                    ARCHIVEFORMAT.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
 ------------------------------------------------------------------------------*/
 
-for (k = n ;  k >= 0 ;  --k)
+static int listing_format = TEXTFORMAT ;
+
+void set_listing_format( int format )
 {
+listing_format = format ;
 
-    /*                    
-                      k 
-    Print the term a x  if a  is nonzero.
-                    k       k
-    */
+} /* ================= end of function set_listing_format =================== */
 
-    if ( (coeff = a[ k ]) != 0)
-    {
 
-       /* After the first time thorough, print leading plus signs "+" to 
-          separate the terms of the polynomial. */
 
-        if (!first_time_through)
+/*==============================================================================
+|                              write_listing_entry                             |
+================================================================================
 
-            printf( " + " ) ;
+DESCRIPTION
 
-        first_time_through = NO ;
+     Print one primitive polynomial when we are listing all of them.
 
-        /* Always print the constant term a  but print terms of higher degree
-                                           0 
-           only if a  is not 1.
-                    k             */
+INPUT
 
-        if ( (coeff != 1) || (k == 0) )
+     f               (int *)   Coefficients of the primitive polynomial.
+     n               (int)     Its degree.
+     p               (int)     Modulus of the coefficient arithmetic.
+     prim_poly_count (bigint)  Its number in the list, starting from 1.
+     num_prim_poly   (bigint)  How many primitive polynomials there are.
 
-            printf( "%d", coeff ) ;
+OUTPUT
 
+    Standard output    The polynomial in the format from set_listing_format.
+                       It goes through the output buffer, so call
+                       flush_output() before printing anything else.
 
-        /*                  k                             1      0
-            Print the term x.  Exceptions:  print x, not x, omit x  */
+EXAMPLE CALLING SEQUENCE
 
-        if (k > 1)
+    write_listing_entry( f, 4, 2, 1, 2 ) prints
 
-            printf( " x ^ %d", k ) ;
+    TEXTFORMAT:
 
-        else if (k == 1)
+        Primitive polynomial 1 of 2 modulo 2 of degree 4
 
-            printf( " x" ) ;
+         x ^ 4 +  x + 1
 
-        /*  Start a new line. */
+    HEXFORMAT (p = 2 only), the bits of the coefficients:
 
-        if (++num_terms % NUMTERMSPERLINE == 0)
+        0x13
 
-            printf( "\n" ) ;
+    DENSEFORMAT, the coefficients from x ^ n down, as digits for p <= 10
+    and separated by blanks for larger p:
 
-    } /* end if coeff > 0 */
+        10011
 
-} /* end for */
+    JSONFORMAT, one JSON object per line:
 
-printf( "\n" ) ;
+        {"index":1,"p":2,"n":4,"coeffs":[1,0,0,1,1]}
 
-return ;
+    ARCHIVEFORMAT adds it to the archive from create_archive instead.
 
-} /* ======================= end of function write_poly ===================== */
+BUGS
+
+    None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void write_listing_entry( int * f, int n, int p, bigint prim_poly_count,
+                          bigint num_prim_poly )
+{
+
+/*------------------------------------------------------------------------------
+|                               Local Variables                                |
+------------------------------------------------------------------------------*/
+
+static const char hex_digits[] = "0123456789ABCDEF" ;
+
+bigint bits ;    /* Coefficients of f(x) as a bit mask when p = 2. */
+int    i ;
+
+/*------------------------------------------------------------------------------
+|                                Function Body                                 |
+------------------------------------------------------------------------------*/
+
+switch( listing_format )
+{
+    case HEXFORMAT:
+        for (i = n, bits = 0 ;  i >= 0 ;  --i)
+            bits = (bits << 1) | (bigint) f[ i ] ;
+
+        put_string( "0x" ) ;
+        for (i = 4 * ((n + 1 + 3) / 4 - 1) ;  i >= 0 ;  i -= 4)
+            put_char( hex_digits[ (bits >> i) & 0xF ] ) ;
+        put_char( '\n' ) ;
+    break ;
+
+    case DENSEFORMAT:
+        for (i = n ;  i >= 0 ;  --i)
+        {
+            if (p > 10 && i < n)
+                put_char( ' ' ) ;
+            put_unsigned( (bigint) f[ i ] ) ;
+        }
+        put_char( '\n' ) ;
+    break ;
+
+    case ARCHIVEFORMAT:
+        append_to_archive( f ) ;
+    break ;
+
+    case JSONFORMAT:
+        put_string( "{\"index\":" ) ;
+        put_unsigned( prim_poly_count ) ;
+        put_string( ",\"p\":" ) ;
+        put_unsigned( (bigint) p ) ;
+        put_string( ",\"n\":" ) ;
+        put_unsigned( (bigint) n ) ;
+        put_string( ",\"coeffs\":[" ) ;
+        for (i = n ;  i >= 0 ;  --i)
+        {
+            put_unsigned( (bigint) f[ i ] ) ;
+            if (i > 0)
+                put_char( ',' ) ;
+        }
+        put_string( "]}\n" ) ;
+    break ;
+
+    default:
+        put_string( "\n\nPrimitive polynomial " ) ;
+        put_unsigned( prim_poly_count ) ;
+        put_string( " of " ) ;
+        put_unsigned( num_prim_poly ) ;
+        put_string( " modulo " ) ;
+        put_unsigned( (bigint) p ) ;
+        put_string( " of degree " ) ;
+        put_unsigned( (bigint) n ) ;
+        put_string( "\n\n" ) ;
+        put_poly( f, n ) ;
+        put_string( "\n\n" ) ;
+    break ;
+}
+
+} /* =================== end of function write_listing_entry ================= */
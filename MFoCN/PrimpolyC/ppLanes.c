@@ -0,0 +1,777 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppLanes.c
+|
+|  Description:
+|
+|     Search for primitive polynomials by testing NUMLANES trial
+|     polynomials at once, one per lane, with the same instructions for
+|     all of them.
+|
+|  Functions:
+|
+|     search_lanes
+|     lanes_fit
+|     test_block
+|     gather_lanes
+|     lanes_linear_factor
+|     lanes_power_table
+|     lanes_square
+|     lanes_times_x
+|     lanes_x_to_power
+|     lanes_is_integer
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  LANES
+|
+|     A polynomial of degree n < 64 is too short to split up among the
+|     processor's vector lanes, but x ^ r is worked out by the same
+|     sequence of squarings and multiplications by x for every trial
+|     polynomial.  So we lay out NUMLANES of them side by side,
+|     coefficient k of lane l in a[ k ][ l ], and write every loop with the
+|     lanes innermost, where the compiler can vectorize it.
+|
+|     The coefficients of a square are summed in 64 bits and reduced
+|     modulo p once at the end, instead of after every product.  That
+|     needs 2 n p^2 < 2^64, which lanes_fit checks.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+typedef unsigned int       lane_coeff ;    /* Coefficient, 0 to p-1.          */
+typedef unsigned long long lane_sum ;      /* Sum of products of them.        */
+
+/*  NUMLANES polynomials of degree < n, coefficient k of lane l in [ k ][ l ]. */
+typedef lane_coeff LanePoly[ MAXDEGPOLY + 1 ][ NUMLANES ] ;
+
+/*  What the search keeps from one block of trial polynomials to the next. */
+typedef struct
+{
+    int      n ;
+    int      p ;
+    bigint   r ;
+    bigint * primes ;
+    int      prime_count ;
+    int *    is_root ;             /* is_root[ a ] is YES or NO if a is or
+                                      isn't a primitive root of p, -1 if we
+                                      don't know yet;  null if p is large.  */
+    int      num_in_group ;        /* Lanes in use in the current group.    */
+    int      poly[ NUMLANES ] ;    /* Which trial polynomial is in each.    */
+    LanePoly f ;                   /* The trial polynomials ...             */
+    LanePoly table[ MAXDEGPOLY - 1 ] ;  /* ... and x^n, ..., x^2n-2 mod them. */
+    LanePoly g ;                   /* x ^ m mod them.                       */
+} LaneSearch ;
+
+
+static void test_block         ( LaneSearch * ls, int block[][ MAXDEGPOLY + 1 ],
+                                 int count, int * depth ) ;
+static void gather_lanes       ( LaneSearch * ls, int block[][ MAXDEGPOLY + 1 ],
+                                 int * list, int count ) ;
+static void lanes_linear_factor( LaneSearch * ls, int * has_root ) ;
+static void lanes_power_table  ( LaneSearch * ls ) ;
+static void lanes_square       ( LanePoly g, LanePoly * table, int n, int p ) ;
+static void lanes_times_x      ( LanePoly g, LanePoly * table, int n, int p ) ;
+static void lanes_x_to_power   ( bigint m, LaneSearch * ls ) ;
+static int  lanes_is_integer   ( LanePoly g, int l, int n ) ;
+
+
+/*==============================================================================
+|                                 search_lanes                                 |
+================================================================================
+
+DESCRIPTION
+
+     Search for primitive polynomials of degree n modulo p, NUMLANES at a
+     time (--lanes).  Either list all of them, or find the first one.
+     The output, the polynomial found and the statistics are the same as
+     for the serial search loop in main.
+
+INPUT
+
+     n, p, r, primes, prime_count, num_prim_poly, list_all
+                                   As for search_parallel.
+     f     (int *)                 From initial_trial_poly.
+
+OUTPUT
+
+     f     (int *)                 When list_all is NO, the first primitive
+                                   polynomial.
+     stats (SearchStatistics *)    Counts for each test.
+
+     Standard output               When list_all is YES, each primitive
+                                   polynomial.
+
+RETURNS
+
+     The number of primitive polynomials found:  0 or 1 when list_all is NO.
+
+METHOD
+
+     Take the next LANEBLOCK trial polynomials and find out how many of the
+     tests each one passes with test_block.  Then go through them in order
+     as the serial loop would, counting, listing, and stopping at the first
+     primitive one if that's all we want.  So the counts are exactly the
+     serial ones, even though we test a few more polynomials than needed at
+     the end.  When we only want the first, the blocks are smaller, so we
+     don't test many more.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint search_lanes( int n, int p, bigint r, bigint * primes, int prime_count,
+                     bigint num_prim_poly, int list_all, int * f,
+                     SearchStatistics * stats )
+{
+
+/*------------------------------------------------------------------------------
+|                               Local Variables                                |
+------------------------------------------------------------------------------*/
+
+LaneSearch
+    * ls ;                           /* Lane state, too big for the stack.  */
+
+int
+    (* block)[ MAXDEGPOLY + 1 ],     /* The trial polynomials in the block. */
+    depth[ LANEBLOCK ],              /* How many tests each one passed.     */
+    count,                           /* How many are in the block.          */
+    block_size = LANEBLOCK,          /* How many we'd like in it.           */
+    done = NO,
+    k, a ;
+
+bigint
+    max_num_poly = power( p, n ),    /* The serial loop tests up to
+                                        p ^ n + 1 polynomials.              */
+    prim_poly_count = 0 ;
+
+/*------------------------------------------------------------------------------
+|                                Function Body                                 |
+------------------------------------------------------------------------------*/
+
+ls    = (LaneSearch *) malloc( sizeof( LaneSearch ) ) ;
+block = (int (*)[ MAXDEGPOLY + 1 ]) malloc( LANEBLOCK * sizeof( *block ) ) ;
+
+if (ls == (LaneSearch *) 0 || block == 0)
+{
+    printf( "ERROR:  Out of memory for --lanes.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+ls->n           = n ;
+ls->p           = p ;
+ls->r           = r ;
+ls->primes      = primes ;
+ls->prime_count = prime_count ;
+ls->is_root     = (int *) 0 ;
+
+/*  Trial polynomials come in runs of p with every constant term, so
+    remember which are primitive roots rather than factoring p-1 each time. */
+if (p <= LANEROOTCACHE && (ls->is_root = (int *) malloc( p * sizeof( int ) )) != (int *) 0)
+    for (a = 0 ;  a < p ;  ++a)
+        ls->is_root[ a ] = -1 ;
+
+/*  Don't go far past the first primitive polynomial when it's all we want. */
+if (!list_all)
+    block_size = 4 * NUMLANES ;
+
+while (!done && stats->num_poly <= max_num_poly)
+{
+    count = block_size ;
+    if ((bigint) count > max_num_poly + 1 - stats->num_poly)
+        count = (int) (max_num_poly + 1 - stats->num_poly) ;
+
+    for (k = 0 ;  k < count ;  ++k)
+    {
+        next_trial_poly( f, n, p ) ;
+        memcpy( block[ k ], f, (n + 1) * sizeof( int ) ) ;
+    }
+
+    test_block( ls, block, count, depth ) ;
+
+    for (k = 0 ;  k < count && !done ;  ++k)
+    {
+        ++stats->num_poly ;
+
+        stats->num_const_coeff_prim_root    += (depth[ k ] >= 1) ;
+        stats->num_free_of_linear_factors   += (depth[ k ] >= 2) ;
+        stats->num_irred_to_power           += (depth[ k ] >= 3) ;
+        stats->num_order_r                  += (depth[ k ] >= 4) ;
+        stats->num_passing_const_coeff_test += (depth[ k ] >= 5) ;
+        stats->num_order_m                  += (depth[ k ] >= 6) ;
+
+        if (depth[ k ] == 6)
+        {
+            ++prim_poly_count ;
+
+            if (list_all)
+                write_listing_entry( block[ k ], n, p, prim_poly_count, num_prim_poly ) ;
+            else
+            {
+                memcpy( f, block[ k ], (n + 1) * sizeof( int ) ) ;
+                done = YES ;
+            }
+        }
+
+        if (stats->num_poly % NUMPOLYPERCLOCKCHECK == 0 && progress_due())
+            report_progress( stats, stats->num_poly, prim_poly_count ) ;
+    }
+}
+
+free( ls->is_root ) ;
+free( ls ) ;
+free( block ) ;
+
+return prim_poly_count ;
+
+} /* ==================== end of function search_lanes ====================== */
+
+
+
+/*==============================================================================
+|                                  lanes_fit                                   |
+================================================================================
+
+DESCRIPTION
+
+     Can --lanes handle degree n modulo p?
+
+RETURNS
+
+     YES if 2 n p^2 fits in 64 bits, so the sums in lanes_square and
+     lanes_power_table can't overflow.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int lanes_fit( int n, int p )
+{
+return (bigint) p * (bigint) p <= ~0ULL / (bigint) (2 * n) ;
+
+} /* ====================== end of function lanes_fit ======================== */
+
+
+
+/*==============================================================================
+|                                  test_block                                  |
+================================================================================
+
+DESCRIPTION
+
+     Find out how many of the primitivity tests each polynomial in a block
+     passes, in the order passes_primitivity_tests does them.
+
+INPUT
+
+     ls    (LaneSearch *)   Search parameters and room to work.
+     block (int [][])       count trial polynomials.
+
+OUTPUT
+
+     depth (int *)          For each one, 0 if it failed the constant
+                            coefficient test, ... 6 if it passed them all.
+
+METHOD
+
+     Go through the tests one at a time.  For each, take the polynomials
+     which passed the one before, NUMLANES at a time, so the lanes stay
+     full as the polynomials drop out.  The constant coefficient tests are
+     only a table lookup or two, and Berlekamp's method branches on the
+     data, so those are done one polynomial at a time.
+
+     The power table is worked out again for each group.  That is n
+     squared steps against n cubed log p for the powers of x, and saves
+     keeping a table for every polynomial in the block.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void test_block( LaneSearch * ls, int block[][ MAXDEGPOLY + 1 ],
+                        int count, int * depth )
+{
+int list[ LANEBLOCK ] ;        /* Polynomials still in the running.  */
+int num_in_list = 0 ;
+int num_passed ;
+int has_root[ NUMLANES ] ;         /* Lane has a linear factor.         */
+int power_is_integer[ NUMLANES ] ; /* Lane has x^m an integer.          */
+int passed ;
+int power_table[ MAXDEGPOLY - 1 ][ MAXDEGPOLY ] ;
+int n = ls->n, p = ls->p ;
+int k, i, j, l, a, start, cnt ;
+
+/* Constant coefficient of f(x) * (-1)^n must be a primitive root of p. */
+for (k = 0 ;  k < count ;  ++k)
+{
+    depth[ k ] = 0 ;
+
+    a = mod( (n % 2 != 0) ? -block[ k ][ 0 ] : block[ k ][ 0 ], p ) ;
+
+    if (ls->is_root == (int *) 0)
+        passed = const_coeff_is_primitive_root( block[ k ], n, p ) ;
+    else
+    {
+        if (ls->is_root[ a ] < 0)
+            ls->is_root[ a ] = const_coeff_is_primitive_root( block[ k ], n, p ) ;
+
+        passed = ls->is_root[ a ] ;
+    }
+
+    if (passed)
+    {
+        depth[ k ] = 1 ;
+        list[ num_in_list++ ] = k ;
+    }
+}
+
+/* f(x) can't have any linear factors. */
+for (start = 0, num_passed = 0 ;  start < num_in_list ;  start += NUMLANES)
+{
+    cnt = (num_in_list - start < NUMLANES) ? num_in_list - start : NUMLANES ;
+    gather_lanes( ls, block, list + start, cnt ) ;
+
+    lanes_linear_factor( ls, has_root ) ;
+
+    for (l = 0 ;  l < cnt ;  ++l)
+        if (!has_root[ l ])
+        {
+            depth[ ls->poly[ l ] ] = 2 ;
+            list[ num_passed++ ] = ls->poly[ l ] ;
+        }
+}
+num_in_list = num_passed ;
+
+/* f(x) can't have two or more distinct irreducible factors. */
+for (start = 0, num_passed = 0 ;  start < num_in_list ;  start += NUMLANES)
+{
+    cnt = (num_in_list - start < NUMLANES) ? num_in_list - start : NUMLANES ;
+    gather_lanes( ls, block, list + start, cnt ) ;
+
+    lanes_power_table( ls ) ;
+
+    for (l = 0 ;  l < cnt ;  ++l)
+    {
+        for (i = 0 ;  i <= n - 2 ;  ++i)
+            for (j = 0 ;  j <= n - 1 ;  ++j)
+                power_table[ i ][ j ] = (int) ls->table[ i ][ j ][ l ] ;
+
+        if (!has_multi_irred_factors( power_table, n, p ))
+        {
+            depth[ ls->poly[ l ] ] = 3 ;
+            list[ num_passed++ ] = ls->poly[ l ] ;
+        }
+    }
+}
+num_in_list = num_passed ;
+
+/*  x^r (mod f(x), p) = a must be an integer, and const coeff. of
+    f(x)*(-1)^n must equal a mod p. */
+for (start = 0, num_passed = 0 ;  start < num_in_list ;  start += NUMLANES)
+{
+    cnt = (num_in_list - start < NUMLANES) ? num_in_list - start : NUMLANES ;
+    gather_lanes( ls, block, list + start, cnt ) ;
+
+    lanes_power_table( ls ) ;
+    lanes_x_to_power( ls->r, ls ) ;
+
+    for (l = 0 ;  l < cnt ;  ++l)
+    {
+        if (!lanes_is_integer( ls->g, l, n ))
+            continue ;
+
+        k = ls->poly[ l ] ;
+        depth[ k ] = 4 ;
+
+        if (const_coeff_test( block[ k ], n, p, (int) ls->g[ 0 ][ l ] ))
+        {
+            depth[ k ] = 5 ;
+            list[ num_passed++ ] = k ;
+        }
+    }
+}
+num_in_list = num_passed ;
+
+/*  x^m != integer for all m = r / q, q a prime divisor of r. */
+for (start = 0 ;  start < num_in_list ;  start += NUMLANES)
+{
+    cnt = (num_in_list - start < NUMLANES) ? num_in_list - start : NUMLANES ;
+    gather_lanes( ls, block, list + start, cnt ) ;
+
+    lanes_power_table( ls ) ;
+
+    for (l = 0 ;  l < cnt ;  ++l)
+        power_is_integer[ l ] = NO ;
+
+    for (i = 0 ;  i <= ls->prime_count ;  ++i)
+    {
+        if (skip_test( i, ls->primes, p ))
+            continue ;
+
+        lanes_x_to_power( ls->r / ls->primes[ i ], ls ) ;
+
+        for (l = 0 ;  l < cnt ;  ++l)
+            if (lanes_is_integer( ls->g, l, n ))
+                power_is_integer[ l ] = YES ;
+    }
+
+    for (l = 0 ;  l < cnt ;  ++l)
+        if (!power_is_integer[ l ])
+            depth[ ls->poly[ l ] ] = 6 ;
+}
+
+} /* ===================== end of function test_block ======================= */
+
+
+
+/*==============================================================================
+|                                 gather_lanes                                 |
+================================================================================
+
+DESCRIPTION
+
+     Put up to NUMLANES trial polynomials into the lanes.
+
+INPUT
+
+     block (int [][])       Trial polynomials.
+     list  (int *)          Which of them ...
+     count (int)            ... and how many, 1 to NUMLANES.
+
+OUTPUT
+
+     ls (LaneSearch *)      f and poly.  Unused lanes get a copy of the
+                            first polynomial, so they compute something
+                            sensible, and we ignore them.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void gather_lanes( LaneSearch * ls, int block[][ MAXDEGPOLY + 1 ],
+                          int * list, int count )
+{
+int k, l, src ;
+
+ls->num_in_group = count ;
+
+for (l = 0 ;  l < NUMLANES ;  ++l)
+{
+    src = list[ (l < count) ? l : 0 ] ;
+    ls->poly[ l ] = src ;
+
+    for (k = 0 ;  k <= ls->n ;  ++k)
+        ls->f[ k ][ l ] = (lane_coeff) block[ src ][ k ] ;
+}
+
+} /* ==================== end of function gather_lanes ====================== */
+
+
+
+/*==============================================================================
+|                             lanes_linear_factor                              |
+================================================================================
+
+DESCRIPTION
+
+     Does f(x) in each lane have a linear factor, that is, a root a in
+     1, ..., p-1?
+
+OUTPUT
+
+     has_root (int *)       YES or NO for each lane.
+
+METHOD
+
+     Evaluate all the lanes at a = 1, 2, ... by Horner's rule, stopping as
+     soon as every lane has a root.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void lanes_linear_factor( LaneSearch * ls, int * has_root )
+{
+lane_sum val[ NUMLANES ] ;
+int      n = ls->n, p = ls->p ;
+int      i, l, a, num_with_root = 0 ;
+
+for (l = 0 ;  l < NUMLANES ;  ++l)
+    has_root[ l ] = NO ;
+
+for (a = 1 ;  a <= p - 1 && num_with_root < ls->num_in_group ;  ++a)
+{
+    for (l = 0 ;  l < NUMLANES ;  ++l)
+        val[ l ] = 1 ;
+
+    for (i = n - 1 ;  i >= 0 ;  --i)
+        for (l = 0 ;  l < NUMLANES ;  ++l)
+            val[ l ] = (val[ l ] * (lane_sum) a + ls->f[ i ][ l ]) % (lane_sum) p ;
+
+    for (l = 0 ;  l < ls->num_in_group ;  ++l)
+        if (val[ l ] == 0 && !has_root[ l ])
+        {
+            has_root[ l ] = YES ;
+            ++num_with_root ;
+        }
+}
+
+} /* ================= end of function lanes_linear_factor ================== */
+
+
+
+/*==============================================================================
+|                              lanes_power_table                               |
+================================================================================
+
+DESCRIPTION
+                                    n         2n-2
+     Fill in the table of powers   x ,  ..., x     (mod f(x), p) for
+     each lane, as construct_power_table does for one polynomial.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void lanes_power_table( LaneSearch * ls )
+{
+lane_coeff t[ MAXDEGPOLY + 1 ][ NUMLANES ] ;
+lane_coeff coeff[ NUMLANES ] ;
+int        n = ls->n, p = ls->p ;
+int        i, j, l ;
+
+/*                  n-1
+    Start with t = x    */
+for (j = 0 ;  j <= n - 1 ;  ++j)
+    for (l = 0 ;  l < NUMLANES ;  ++l)
+        t[ j ][ l ] = (j == n - 1) ;
+
+for (i = 0 ;  i <= n - 2 ;  ++i)
+{
+    /*  t(x) = x t(x), and replace x ^ n by -(a     x ^ n-1 + ... + a ).
+                                                n-1                  0
+        When the x ^ n coefficient is 0, we add p times a multiple of
+        f(x), which is the same as nothing. */
+    for (l = 0 ;  l < NUMLANES ;  ++l)
+        coeff[ l ] = (lane_coeff) p - t[ n - 1 ][ l ] ;
+
+    for (j = n - 1 ;  j >= 1 ;  --j)
+        for (l = 0 ;  l < NUMLANES ;  ++l)
+            t[ j ][ l ] = (lane_coeff) (((lane_sum) t[ j - 1 ][ l ] +
+                                         (lane_sum) coeff[ l ] * ls->f[ j ][ l ]) % (lane_sum) p) ;
+
+    for (l = 0 ;  l < NUMLANES ;  ++l)
+        t[ 0 ][ l ] = (lane_coeff) (((lane_sum) coeff[ l ] * ls->f[ 0 ][ l ]) % (lane_sum) p) ;
+
+    memcpy( ls->table[ i ], t, sizeof( t ) ) ;
+}
+
+} /* ================== end of function lanes_power_table =================== */
+
+
+
+/*==============================================================================
+|                                 lanes_square                                 |
+================================================================================
+
+DESCRIPTION
+                         2
+     Compute g(x) = g(x)  (mod f(x), p) in each lane.
+
+INPUT
+
+     g     (LanePoly)       Polynomials of degree n-1 or less.
+     table (LanePoly *)     Power tables.
+     n, p  (int)            Degree of f(x) and the modulus.
+
+OUTPUT
+
+     g                      The squares.
+
+METHOD
+
+     Sum the products for every coefficient of the square in 64 bits,
+     reduce the ones of degree n and up modulo p, fold them back in with
+     the power table, and reduce each coefficient once.  The largest sum
+     is under 2 n p^2.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void lanes_square( LanePoly g, LanePoly * table, int n, int p )
+{
+lane_sum   c[ 2 * MAXDEGPOLY - 1 ][ NUMLANES ] ;
+lane_coeff top[ NUMLANES ] ;
+int        i, j, k, l ;
+
+memset( c, 0, (2 * n - 1) * sizeof( c[ 0 ] ) ) ;
+
+for (i = 0 ;  i <= n - 1 ;  ++i)
+{
+    for (l = 0 ;  l < NUMLANES ;  ++l)
+        c[ 2 * i ][ l ] += (lane_sum) g[ i ][ l ] * g[ i ][ l ] ;
+
+    for (j = i + 1 ;  j <= n - 1 ;  ++j)
+        for (l = 0 ;  l < NUMLANES ;  ++l)
+            c[ i + j ][ l ] += 2 * (lane_sum) g[ i ][ l ] * g[ j ][ l ] ;
+}
+
+for (k = n ;  k <= 2 * n - 2 ;  ++k)
+{
+    for (l = 0 ;  l < NUMLANES ;  ++l)
+        top[ l ] = (lane_coeff) (c[ k ][ l ] % (lane_sum) p) ;
+
+    for (j = 0 ;  j <= n - 1 ;  ++j)
+        for (l = 0 ;  l < NUMLANES ;  ++l)
+            c[ j ][ l ] += (lane_sum) top[ l ] * table[ k - n ][ j ][ l ] ;
+}
+
+for (j = 0 ;  j <= n - 1 ;  ++j)
+    for (l = 0 ;  l < NUMLANES ;  ++l)
+        g[ j ][ l ] = (lane_coeff) (c[ j ][ l ] % (lane_sum) p) ;
+
+} /* ===================== end of function lanes_square ===================== */
+
+
+
+/*==============================================================================
+|                                lanes_times_x                                 |
+================================================================================
+
+DESCRIPTION
+
+     Compute g(x) = x g(x)  (mod f(x), p) in each lane.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void lanes_times_x( LanePoly g, LanePoly * table, int n, int p )
+{
+lane_coeff top[ NUMLANES ] ;
+int        j, l ;
+
+for (l = 0 ;  l < NUMLANES ;  ++l)
+    top[ l ] = g[ n - 1 ][ l ] ;
+
+for (j = n - 1 ;  j >= 1 ;  --j)
+    for (l = 0 ;  l < NUMLANES ;  ++l)
+        g[ j ][ l ] = (lane_coeff) (((lane_sum) g[ j - 1 ][ l ] +
+                                     (lane_sum) top[ l ] * table[ 0 ][ j ][ l ]) % (lane_sum) p) ;
+
+for (l = 0 ;  l < NUMLANES ;  ++l)
+    g[ 0 ][ l ] = (lane_coeff) (((lane_sum) top[ l ] * table[ 0 ][ 0 ][ l ]) % (lane_sum) p) ;
+
+} /* ==================== end of function lanes_times_x ====================== */
+
+
+
+/*==============================================================================
+|                               lanes_x_to_power                               |
+================================================================================
+
+DESCRIPTION
+                       m
+     Compute g(x) = x   (mod f(x), p) in each lane, into ls->g, using the
+     power tables in ls->table.
+
+METHOD
+
+     As x_to_power:  square for every bit of m after the leading one, and
+     multiply by x for every 1 bit.  The bits are the same for every lane.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void lanes_x_to_power( bigint m, LaneSearch * ls )
+{
+int n = ls->n, p = ls->p ;
+int bit, j, l ;
+
+for (j = 0 ;  j <= n - 1 ;  ++j)
+    for (l = 0 ;  l < NUMLANES ;  ++l)
+        ls->g[ j ][ l ] = (j == 1) ;
+
+for (bit = NUMBITS - 1 ;  bit > 0 && !((m >> bit) & 1) ;  --bit)
+    ;
+
+while (--bit >= 0)
+{
+    lanes_square( ls->g, ls->table, n, p ) ;
+
+    if ((m >> bit) & 1)
+        lanes_times_x( ls->g, ls->table, n, p ) ;
+}
+
+} /* ================== end of function lanes_x_to_power ==================== */
+
+
+
+/*==============================================================================
+|                               lanes_is_integer                               |
+================================================================================
+
+DESCRIPTION
+
+     Is g(x) in lane l a constant?
+
+RETURNS
+
+     YES or NO.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int lanes_is_integer( LanePoly g, int l, int n )
+{
+int j ;
+
+for (j = 1 ;  j <= n - 1 ;  ++j)
+    if (g[ j ][ l ] != 0)
+        return NO ;
+
+return YES ;
+
+} /* ================== end of function lanes_is_integer ==================== */
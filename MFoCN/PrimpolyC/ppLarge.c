@@ -0,0 +1,1304 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppLarge.c
+|
+|  Description:
+|
+|     Search for a primitive polynomial modulo 2 of degree n past
+|     MAXDEGPOLY, up to MAXLARGEDEG, with the polynomials and r sized to
+|     n at run time.
+|
+|  Functions:
+|
+|     search_large
+|     is_primitive_large
+|     write_large_listing_entry
+|     factor_large
+|     finish_factoring
+|     pollard_rho_large
+|     rho_step_large
+|     is_one
+|     setup_field
+|     set_field_poly
+|     free_field
+|     spread_bits
+|     top_bit
+|     degree_of
+|     xor_at
+|     reduce_bits
+|     square_mod
+|     times_x_mod
+|     x_to_power_is_one
+|     has_small_factor
+|     is_irreducible_large
+|     coprime
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  METHOD
+|
+|     A polynomial modulo 2 is a string of bits, 64 to a word, with the
+|     coefficient of x ^ k in bit k.  Adding is exclusive or, and squaring
+|     just spreads the bits out, since (a + b)^2 = a^2 + b^2 modulo 2.
+|     To reduce modulo f(x) = x^n + x^e1 + ... + 1, replace the bits of
+|     x^(n+k) a word at a time by x^(k+e1) + ... + x^k, so the cost goes
+|     with the number of terms of f(x).  That's small for the trinomials
+|     and pentanomials of -w, and for the first trial polynomials of the
+|     plain search.
+|
+|     f(x) is primitive when it is irreducible and x has order r = 2^n - 1.
+|     We test, in order,
+|
+|         f(0) = 1 and f(1) = 1, so there are no linear factors,
+|
+|         no factors of degree 2 to LARGESIEVEDEG:
+|             gcd( f(x), x^(2^d) - x ) = 1 for d = 2 ... LARGESIEVEDEG,
+|
+|         Rabin's irreducibility test:  x^(2^n) = x (mod f(x)), and
+|             gcd( x^(2^(n/q)) - x, f(x) ) = 1 for each prime q | n,
+|
+|         x^(r/q) != 1 (mod f(x)) for each prime q | r.
+|
+|     Statistics (-s) go to the same stages as in main, counting an
+|     irreducible polynomial where main counts an irreducible polynomial
+|     or a power of one.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+typedef unsigned long long large_word ;  /*  64 coefficients.  */
+
+/*  f(x) and the space to do arithmetic modulo it. */
+typedef struct
+{
+    int          n ;               /* Degree of f(x).                           */
+    int          num_words ;       /* Words in a polynomial of degree n or less. */
+    int          num_terms ;       /* Terms of f(x) below x ^ n ...             */
+    int        * term ;            /* ... and their exponents, highest first.   */
+    large_word * f ;               /* f(x) itself.                              */
+    large_word * t ;               /* x to some power (mod f(x)).               */
+    large_word * wide ;            /* 2 num_words, for a square to reduce.      */
+    int          num_gcd_words ;   /* Words in u and v, for the gcds.           */
+    large_word * u ;
+    large_word * v ;
+    int          num_primes_of_n ; /* Distinct primes dividing n ...            */
+    int          prime_of_n[ 8 * sizeof( int ) ] ;
+    large_word * snapshot ;        /* ... x^(2^(n/q)) (mod f(x)) for each.      */
+    int          num_exponents ;   /* Distinct primes q dividing r ...          */
+    MultiInt   * exponent ;        /* ... and r / q for each of them.           */
+} LargeField ;
+
+
+static int        is_primitive_large       ( LargeField * L, int * f, SearchStatistics * stats ) ;
+static void       write_large_listing_entry( int * f, int n, bigint prim_poly_count,
+                                             const char * num_prim_poly ) ;
+static void       factor_large             ( int n, const MultiInt * r, MultiFactors * F ) ;
+static int        finish_factoring         ( const MultiInt * c, MultiFactors * F ) ;
+static int        pollard_rho_large        ( const MultiInt * c, MultiInt * d ) ;
+static void       rho_step_large           ( MultiInt * y, const MultiInt * c, int a ) ;
+static int        is_one                   ( const MultiInt * a ) ;
+static void       setup_field              ( LargeField * L, int n, const MultiInt * r,
+                                             const MultiFactors * F ) ;
+static void       set_field_poly           ( LargeField * L, int * f ) ;
+static void       free_field               ( LargeField * L ) ;
+static large_word spread_bits              ( large_word w ) ;
+static int        top_bit                  ( large_word w ) ;
+static int        degree_of                ( const large_word * a, int top_word ) ;
+static void       xor_at                   ( large_word * a, large_word w, int pos ) ;
+static void       reduce_bits              ( large_word * a, int top, int n,
+                                             const int * term, int num_terms ) ;
+static void       square_mod               ( LargeField * L, large_word * a ) ;
+static void       times_x_mod              ( LargeField * L, large_word * a ) ;
+static int        x_to_power_is_one        ( LargeField * L, const MultiInt * m ) ;
+static int        has_small_factor         ( LargeField * L ) ;
+static int        is_irreducible_large     ( LargeField * L ) ;
+static int        coprime                  ( large_word * u, large_word * v, int num_words ) ;
+
+
+/*==============================================================================
+|                                 search_large                                 |
+================================================================================
+
+DESCRIPTION
+
+     Find a primitive polynomial modulo 2 of degree n, or with list_all
+     and low_weight, list all those of the lowest weight, printing the
+     same as main does.
+
+INPUT
+
+     n                (int)    MAXDEGPOLY < n <= MAXLARGEDEG.
+     low_weight       (int)    YES to go by number of terms, as with -w.
+     list_all         (int)    YES to list all (-a);  needs low_weight.
+     print_statistics (int)    YES to print the factors of r and the
+                               counts of the tests (-s).
+
+RETURNS
+
+     0, to pass back from main.  Exits if r can't be factored.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int search_large( int n, int low_weight, int list_all, int print_statistics )
+{
+
+/*------------------------------------------------------------------------------
+|                               Local Variables                                |
+------------------------------------------------------------------------------*/
+
+LargeField       L ;
+MultiFactors     factors ;
+MultiInt         max_num_poly, r, num_prim_poly, t ;
+SearchStatistics stats ;
+SparseTrialPoly  sparse ;
+
+char * text ;               /* A MultiInt in decimal.                    */
+char * num_prim_poly_text ; /* The number of primitive polynomials.      */
+int  * f ;                  /* Trial polynomial.                         */
+int    i, j, weight, more_of_this_weight ;
+int    is_primitive_poly = NO ;
+bigint prim_poly_count = 0, num_skipped_by_swan = 0 ;
+
+/*------------------------------------------------------------------------------
+|                                Function Body                                 |
+------------------------------------------------------------------------------*/
+
+f                  = (int *)  calloc( (size_t) n + 1, sizeof( int ) ) ;
+text               = (char *) malloc( MULTIINTDIGITS ) ;
+num_prim_poly_text = (char *) malloc( MULTIINTDIGITS ) ;
+
+if (f == (int *) 0 || text == (char *) 0 || num_prim_poly_text == (char *) 0)
+{
+    printf( "ERROR:  Not enough memory for the search.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+memset( &factors, 0, sizeof( factors ) ) ;
+memset( &stats,   0, sizeof( stats ) ) ;
+
+/*  Compute 2^n and r = 2^n - 1, and factor r. */
+multi_power( &max_num_poly, 2, n ) ;
+multi_copy( &r, &max_num_poly ) ;
+multi_subtract_small( &r, 1 ) ;
+
+if (print_statistics)
+{
+    multi_to_string( &r, text ) ;
+    printf( "\nFactoring r = %s into\n    ", text ) ;
+}
+
+factor_large( n, &r, &factors ) ;
+
+if (print_statistics)
+{
+    for (i = 0 ;  i < factors.num_primes ;  ++i)
+    {
+        multi_to_string( &factors.prime[ i ], text ) ;
+
+        if (factors.count[ i ] == 1)
+            printf( "%s ", text ) ;
+        else
+            printf( "%s^%d ", text, factors.count[ i ] ) ;
+    }
+    printf( "\n\n" ) ;
+}
+
+/*  Euler's phi of r, over n. */
+if (print_statistics || list_all)
+{
+    multi_set( &num_prim_poly, 1 ) ;
+
+    for (i = 0 ;  i < factors.num_primes ;  ++i)
+    {
+        multi_copy( &t, &factors.prime[ i ] ) ;
+        multi_subtract_small( &t, 1 ) ;
+        multi_multiply( &num_prim_poly, &num_prim_poly, &t ) ;
+
+        for (j = 1 ;  j < factors.count[ i ] ;  ++j)
+            multi_multiply( &num_prim_poly, &num_prim_poly, &factors.prime[ i ] ) ;
+    }
+
+    multi_divide_small( &num_prim_poly, (unsigned int) n ) ;
+    multi_to_string( &num_prim_poly, num_prim_poly_text ) ;
+
+    printf( "Total number of primitive polynomials = %s.  Begin testing...\n\n",
+            num_prim_poly_text ) ;
+}
+
+setup_field( &L, n, &r, &factors ) ;
+
+if (low_weight)
+{
+    /*  As in main, by number of terms, skipping even weights and the
+        trinomials Swan's theorem says are reducible. */
+    for (weight = 3 ;  weight <= n + 1 && weight <= MAXDEGPOLY + 1 && !is_primitive_poly ;
+         weight += 2)
+    {
+        more_of_this_weight = first_sparse_poly( &sparse, f, n, 2, weight ) ;
+
+        while (more_of_this_weight)
+        {
+            if (weight == 3 && swan_says_reducible( n, sparse.exponent[ 1 ] ))
+                ++num_skipped_by_swan ;
+            else
+            {
+                ++stats.num_poly ;
+
+                if (is_primitive_large( &L, f, &stats ))
+                {
+                    is_primitive_poly = YES ;
+
+                    if (list_all)
+                        write_large_listing_entry( f, n, ++prim_poly_count,
+                                                   num_prim_poly_text ) ;
+                    else
+                        break ;
+                }
+            }
+
+            more_of_this_weight = next_sparse_poly( &sparse, f, n, 2 ) ;
+        }
+    }
+}
+else
+{
+    /*  Same order as main.  There is a primitive polynomial, so this ends. */
+    initial_trial_poly( f, n ) ;
+
+    do {
+        next_trial_poly( f, n, 2 ) ;
+        ++stats.num_poly ;
+
+        is_primitive_poly = is_primitive_large( &L, f, &stats ) ;
+    } while (!is_primitive_poly) ;
+}
+
+flush_output() ;
+printf( "\n\n" ) ;
+
+if (list_all)
+    ; /* We're done */
+else if (is_primitive_poly)
+{
+    printf( "\n\nPrimitive polynomial modulo 2 of degree %d\n\n", n ) ;
+    write_poly( f, n ) ;
+    printf( "\n\n" ) ;
+}
+else
+{
+    printf( "Internal error:  \n"
+            "Tested all polynomials of weight up to %d, but failed\n"
+            "to find a primitive polynomial.\n"
+            "Please let the author know by e-mail.\n", MAXDEGPOLY + 1 ) ;
+    exit( 1 ) ;
+}
+
+if (print_statistics)
+{
+    multi_to_string( &max_num_poly, text ) ;
+
+    printf( "+--------- Statistics -----------------------------------------------------------------\n" ) ;
+    printf( "|\n" ) ;
+    printf( "| Total num. degree %3d polynomials mod %3d :    %s\n", n, 2, text ) ;
+    printf( "| Actually tested :                              %s\n",  bigint_string( stats.num_poly ) ) ;
+    printf( "| Const. coeff. was primitive root :      %10s\n",  bigint_string( stats.num_const_coeff_prim_root ) ) ;
+    printf( "| Free of linear factors :                %10s\n",  bigint_string( stats.num_free_of_linear_factors ) ) ;
+    printf( "| Irreducible or irred. to power :        %10s\n",  bigint_string( stats.num_irred_to_power ) ) ;
+    printf( "| Had order r (x^r = integer) :           %10s\n",  bigint_string( stats.num_order_r ) ) ;
+    printf( "| Passed const. coeff. test :             %10s\n",  bigint_string( stats.num_passing_const_coeff_test ) ) ;
+    printf( "| Had order m (x^m != integer) :          %10s\n",  bigint_string( stats.num_order_m ) ) ;
+    if (low_weight)
+        printf( "| Skipped by Swan's theorem :                    %s\n", bigint_string( num_skipped_by_swan ) ) ;
+    printf( "|\n" ) ;
+    printf( "+--------------------------------------------------------------------------------------\n" ) ;
+}
+
+free_field( &L ) ;
+multi_free_factors( &factors ) ;
+free( num_prim_poly_text ) ;
+free( text ) ;
+free( f ) ;
+
+return 0 ;
+
+} /* ===================== end of function search_large ===================== */
+
+
+
+/*==============================================================================
+|                              is_primitive_large                              |
+================================================================================
+
+DESCRIPTION
+
+     Test whether f(x) is primitive, and count the tests it passes.
+
+INPUT
+
+     L     (LargeField *)         Set up for n and r by setup_field.
+     f     (int *)                Coefficients of f(x), f[ 0 ] ... f[ n ].
+
+OUTPUT
+
+     stats (SearchStatistics *)   Counts of the stages passed, added to.
+
+RETURNS
+
+     YES if f(x) is primitive, NO otherwise.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int is_primitive_large( LargeField * L, int * f, SearchStatistics * stats )
+{
+int k, weight = 0 ;
+
+/*  1 is the only primitive root of 2. */
+if (f[ 0 ] == 0)
+    return NO ;
+
+++stats->num_const_coeff_prim_root ;
+
+/*  An even number of terms means f(1) = 0. */
+for (k = 0 ;  k <= L->n ;  ++k)
+    weight += f[ k ] ;
+
+if (weight % 2 == 0)
+    return NO ;
+
+++stats->num_free_of_linear_factors ;
+
+set_field_poly( L, f ) ;
+
+if (has_small_factor( L ) || !is_irreducible_large( L ))
+    return NO ;
+
+/*  Rabin's test has shown x^r = 1, and the constant term is 1. */
+++stats->num_irred_to_power ;
+++stats->num_order_r ;
+++stats->num_passing_const_coeff_test ;
+
+for (k = 0 ;  k < L->num_exponents ;  ++k)
+    if (x_to_power_is_one( L, &L->exponent[ k ] ))
+        return NO ;
+
+++stats->num_order_m ;
+
+return YES ;
+
+} /* ================= end of function is_primitive_large ==================== */
+
+
+
+/*==============================================================================
+|                          write_large_listing_entry                           |
+================================================================================
+
+DESCRIPTION
+
+     List a primitive polynomial as write_listing_entry does in text,
+     with the total number written out beforehand since it's no bigint.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void write_large_listing_entry( int * f, int n, bigint prim_poly_count,
+                                       const char * num_prim_poly )
+{
+put_string( "\n\nPrimitive polynomial " ) ;
+put_unsigned( prim_poly_count ) ;
+put_string( " of " ) ;
+put_string( num_prim_poly ) ;
+put_string( " modulo 2 of degree " ) ;
+put_unsigned( (bigint) n ) ;
+put_string( "\n\n" ) ;
+put_poly( f, n ) ;
+put_string( "\n\n" ) ;
+
+} /* ============== end of function write_large_listing_entry ================ */
+
+
+
+/*==============================================================================
+|                                 factor_large                                 |
+================================================================================
+
+DESCRIPTION
+
+     Factor r = 2^n - 1 into primes.
+
+INPUT
+
+     n (int)                  Degree.
+     r (const MultiInt *)     2^n - 1.
+
+OUTPUT
+
+     F (MultiFactors *)       Its prime factors.  Exits if we can't finish.
+
+METHOD
+
+     Each prime factor q of r has some order d modulo 2 which divides n,
+     so q divides 2^d - 1, and q = 1 (mod d) since d divides q - 1.  Go
+     through the divisors d of n from the smallest.  For d <= MAXDEGPOLY,
+     2^d - 1 is a bigint and factor() does it.  Otherwise take 2^d - 1,
+     divide out the primes found so far, which have smaller orders, and
+     what's left has only primes of order d.  It's prime if d is prime and
+     the Lucas-Lehmer test says so, as for n = 607, 1279 and 2281, or if
+     it passes multi_is_prime.  If not, try LARGETRIALDIVISORS divisors
+     1 + k lcm( 2, d ), stopping as soon as what's left is prime, then
+     split that with Pollard rho if it's no more than LARGERHOBITS long.
+     The primes of the factor table (--factors), if any, count as found
+     from the start, so 2^d - 1 may be all done before we try anything.
+     Last, count how many times each prime divides r.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void factor_large( int n, const MultiInt * r, MultiFactors * F )
+{
+MultiFactors         found ;                    /* Primes so far.            */
+const MultiFactors * table ;                    /* Primes of --factors.      */
+MultiInt             m, t, q ;
+bigint               primes[ MAXNUMPRIMEFACTORS ] ;
+int                  count[ MAXNUMPRIMEFACTORS ] ;
+unsigned long long   divisor, step ;
+long                 num_tried ;
+int                  d, i, k, prime_count ;
+char               * text ;
+
+memset( &found, 0, sizeof( found ) ) ;
+
+table = factor_table_primes() ;
+for (i = 0 ;  i < table->num_primes ;  ++i)
+    multi_add_factor( &found, &table->prime[ i ], 1 ) ;
+
+for (d = 2 ;  d <= n ;  ++d)
+{
+    if (n % d != 0)
+        continue ;
+
+    if (d <= MAXDEGPOLY)
+    {
+        prime_count = factor( power( 2, d ) - 1, primes, count ) ;
+
+        for (i = 0 ;  i <= prime_count ;  ++i)
+        {
+            multi_set( &q, primes[ i ] ) ;
+            multi_add_factor( &found, &q, 1 ) ;
+        }
+        continue ;
+    }
+
+    multi_power( &m, 2, d ) ;
+    multi_subtract_small( &m, 1 ) ;
+
+    for (i = 0 ;  i < found.num_primes ;  ++i)
+    {
+        for (;;)
+        {
+            multi_divide( &t, &q, &m, &found.prime[ i ] ) ;
+            if (q.size != 0)
+                break ;
+            multi_copy( &m, &t ) ;
+        }
+    }
+
+    if (is_one( &m ))
+        continue ;
+
+    if (is_almost_surely_prime( d ) ? multi_is_mersenne_prime( d ) : multi_is_prime( &m ))
+    {
+        multi_add_factor( &found, &m, 1 ) ;
+        continue ;
+    }
+
+    step = (d % 2 == 0) ? (unsigned long long) d : 2 * (unsigned long long) d ;
+
+    for (num_tried = 0, divisor = step + 1 ;
+         num_tried < LARGETRIALDIVISORS && divisor <= 0xFFFFFFFFULL && !is_one( &m ) ;
+         ++num_tried, divisor += step)
+    {
+        multi_copy( &t, &m ) ;
+
+        if (multi_divide_small( &t, (unsigned int) divisor ) != 0)
+            continue ;
+
+        do {
+            multi_copy( &m, &t ) ;
+        } while (multi_divide_small( &t, (unsigned int) divisor ) == 0) ;
+
+        multi_set( &q, (bigint) divisor ) ;
+        multi_add_factor( &found, &q, 1 ) ;
+
+        if (!is_one( &m ) && multi_is_prime( &m ))
+        {
+            multi_add_factor( &found, &m, 1 ) ;
+            multi_set( &m, 1 ) ;
+        }
+    }
+
+    if (!finish_factoring( &m, &found ))
+    {
+        text = (char *) malloc( MULTIINTDIGITS ) ;
+        if (text != (char *) 0)
+        {
+            multi_to_string( &m, text ) ;
+            printf( "ERROR:  Can't finish factoring r = 2^%d - 1.  Its factor\n    %s\n"
+                    "    is composite.  A factor table (--factors) could supply it.\n\n", n, text ) ;
+        }
+        exit( 1 ) ;
+    }
+}
+
+/*  Multiplicities. */
+multi_copy( &m, r ) ;
+
+for (i = 0 ;  i < found.num_primes ;  ++i)
+{
+    for (k = 0 ;  ;  ++k)
+    {
+        multi_divide( &t, &q, &m, &found.prime[ i ] ) ;
+        if (q.size != 0)
+            break ;
+        multi_copy( &m, &t ) ;
+    }
+
+    if (k > 0)
+        multi_add_factor( F, &found.prime[ i ], k ) ;
+}
+
+multi_free_factors( &found ) ;
+
+if (!is_one( &m ))
+{
+    printf( "Internal error:  \n"
+            "The factors of r = 2^%d - 1 don't multiply back to it.\n"
+            "Please let the author know by e-mail.\n\n", n ) ;
+    exit( 1 ) ;
+}
+
+} /* ==================== end of function factor_large ====================== */
+
+
+
+/*==============================================================================
+|                               finish_factoring                               |
+================================================================================
+
+DESCRIPTION
+
+     Add the prime factors of c to F, splitting it with Pollard rho.
+
+RETURNS
+
+     YES if c is now completely factored, NO if rho gave up.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int finish_factoring( const MultiInt * c, MultiFactors * F )
+{
+MultiInt d, e ;
+
+if (is_one( c ))
+    return YES ;
+
+if (multi_is_prime( c ))
+{
+    multi_add_factor( F, c, 1 ) ;
+    return YES ;
+}
+
+if (multi_num_bits( c ) > LARGERHOBITS || !pollard_rho_large( c, &d ))
+    return NO ;
+
+multi_divide( &e, (MultiInt *) 0, c, &d ) ;
+
+return finish_factoring( &d, F ) && finish_factoring( &e, F ) ;
+
+} /* ================== end of function finish_factoring ===================== */
+
+
+
+/*==============================================================================
+|                       pollard_rho_large, rho_step_large                      |
+================================================================================
+
+DESCRIPTION
+
+     Find a factor of a composite c, as pollard_rho does for a bigint.
+
+OUTPUT
+
+     d (MultiInt *)    A factor, 1 < d < c.
+
+RETURNS
+
+     YES if we found one within LARGERHOSTEPS steps, NO if not.
+
+METHOD
+
+     Brent's variant, multiplying RHOBATCH differences together between
+     gcds.  If the gcd jumps to c, go back over the batch one at a time.
+     If that still gives c, try the next polynomial y^2 + a.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int pollard_rho_large( const MultiInt * c, MultiInt * d )
+{
+MultiInt x, y, ys, q, diff ;
+long     num_steps = 0 ;
+int      a, k, i, length ;
+
+for (a = 1 ;  a <= 3 ;  ++a)
+{
+    multi_set( &y, 2 ) ;
+    multi_set( &q, 1 ) ;
+    multi_set( d,  1 ) ;
+
+    for (length = 1 ;  is_one( d ) ;  length *= 2)
+    {
+        multi_copy( &x, &y ) ;
+
+        for (i = 0 ;  i < length ;  ++i)
+            rho_step_large( &y, c, a ) ;
+
+        for (k = 0 ;  k < length && is_one( d ) ;  k += RHOBATCH)
+        {
+            multi_copy( &ys, &y ) ;
+
+            for (i = 0 ;  i < RHOBATCH && i < length - k ;  ++i)
+            {
+                rho_step_large( &y, c, a ) ;
+
+                if (multi_compare( &x, &y ) >= 0)
+                {
+                    multi_copy( &diff, &x ) ;
+                    multi_subtract( &diff, &y ) ;
+                }
+                else
+                {
+                    multi_copy( &diff, &y ) ;
+                    multi_subtract( &diff, &x ) ;
+                }
+
+                multi_multiply( &q, &q, &diff ) ;
+                multi_divide( (MultiInt *) 0, &q, &q, c ) ;
+            }
+
+            multi_gcd( d, &q, c ) ;
+
+            if ((num_steps += RHOBATCH) > LARGERHOSTEPS)
+                return NO ;
+        }
+    }
+
+    if (multi_compare( d, c ) == 0)
+    {
+        do {
+            rho_step_large( &ys, c, a ) ;
+
+            if (multi_compare( &x, &ys ) >= 0)
+            {
+                multi_copy( &diff, &x ) ;
+                multi_subtract( &diff, &ys ) ;
+            }
+            else
+            {
+                multi_copy( &diff, &ys ) ;
+                multi_subtract( &diff, &x ) ;
+            }
+
+            multi_gcd( d, &diff, c ) ;
+        } while (is_one( d )) ;
+    }
+
+    if (multi_compare( d, c ) != 0)
+        return YES ;
+}
+
+return NO ;
+
+} /* ================= end of function pollard_rho_large ===================== */
+
+
+static void rho_step_large( MultiInt * y, const MultiInt * c, int a )
+{
+multi_multiply( y, y, y ) ;
+multi_add_small( y, (unsigned int) a ) ;
+multi_divide( (MultiInt *) 0, y, y, c ) ;
+
+} /* =================== end of function rho_step_large ====================== */
+
+
+
+/*==============================================================================
+|                                    is_one                                    |
+================================================================================
+
+DESCRIPTION
+
+     Is a = 1?
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int is_one( const MultiInt * a )
+{
+return a->size == 1 && a->limb[ 0 ] == 1 ;
+
+} /* ======================== end of function is_one ======================== */
+
+
+
+/*==============================================================================
+|                        setup_field, set_field_poly, free_field               |
+================================================================================
+
+DESCRIPTION
+
+     Allocate the space for arithmetic modulo polynomials of degree n, find
+     the primes dividing n, and the exponents r / q for the order test.
+     Then for each trial polynomial, put f(x) in as bits and a list of
+     terms.  Free it all at the end.
+
+INPUT
+
+     n (int)                     Degree.
+     r (const MultiInt *)        2^n - 1 ...
+     F (const MultiFactors *)    ... and its prime factors.
+     f (int *)                   Trial polynomial for set_field_poly.
+
+OUTPUT
+
+     L (LargeField *)
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void setup_field( LargeField * L, int n, const MultiInt * r, const MultiFactors * F )
+{
+int i, m, q ;
+
+L->n             = n ;
+L->num_words     = n / 64 + 1 ;
+L->num_gcd_words = ((n > (1 << LARGESIEVEDEG)) ? n : (1 << LARGESIEVEDEG)) / 64 + 1 ;
+
+for (L->num_primes_of_n = 0, m = n, q = 2 ;  m > 1 ;  ++q)
+{
+    if (m % q == 0)
+    {
+        L->prime_of_n[ L->num_primes_of_n++ ] = q ;
+
+        while (m % q == 0)
+            m /= q ;
+    }
+}
+
+L->term     = (int *)        malloc( (size_t) (n + 1) * sizeof( int ) ) ;
+L->f        = (large_word *) calloc( (size_t) L->num_words, sizeof( large_word ) ) ;
+L->t        = (large_word *) calloc( (size_t) L->num_words, sizeof( large_word ) ) ;
+L->wide     = (large_word *) calloc( (size_t) (2 * L->num_words), sizeof( large_word ) ) ;
+L->u        = (large_word *) calloc( (size_t) L->num_gcd_words, sizeof( large_word ) ) ;
+L->v        = (large_word *) calloc( (size_t) L->num_gcd_words, sizeof( large_word ) ) ;
+L->snapshot = (large_word *) calloc( (size_t) (L->num_primes_of_n * L->num_words),
+                                     sizeof( large_word ) ) ;
+L->exponent = (MultiInt *)   malloc( (size_t) (F->num_primes + 1) * sizeof( MultiInt ) ) ;
+
+if (L->term == (int *) 0 || L->f == (large_word *) 0 || L->t == (large_word *) 0 ||
+    L->wide == (large_word *) 0 || L->u == (large_word *) 0 || L->v == (large_word *) 0 ||
+    L->snapshot == (large_word *) 0 || L->exponent == (MultiInt *) 0)
+{
+    printf( "ERROR:  Not enough memory for the search.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+L->num_exponents = F->num_primes ;
+
+for (i = 0 ;  i < F->num_primes ;  ++i)
+    multi_divide( &L->exponent[ i ], (MultiInt *) 0, r, &F->prime[ i ] ) ;
+
+} /* ===================== end of function setup_field ====================== */
+
+
+static void set_field_poly( LargeField * L, int * f )
+{
+int k ;
+
+memset( L->f, 0, (size_t) L->num_words * sizeof( large_word ) ) ;
+L->num_terms = 0 ;
+
+for (k = L->n ;  k >= 0 ;  --k)
+{
+    if (f[ k ] != 0)
+    {
+        L->f[ k / 64 ] |= (large_word) 1 << (k % 64) ;
+
+        if (k < L->n)
+            L->term[ L->num_terms++ ] = k ;
+    }
+}
+
+} /* ==================== end of function set_field_poly ===================== */
+
+
+static void free_field( LargeField * L )
+{
+free( L->term ) ;
+free( L->f ) ;
+free( L->t ) ;
+free( L->wide ) ;
+free( L->u ) ;
+free( L->v ) ;
+free( L->snapshot ) ;
+free( L->exponent ) ;
+
+} /* ====================== end of function free_field ====================== */
+
+
+
+/*==============================================================================
+|                     spread_bits, top_bit, degree_of, xor_at                  |
+================================================================================
+
+DESCRIPTION
+
+     Bit twiddling:  spread the low 32 bits of w out to the even bits, so
+     bit k goes to bit 2k;  the highest bit set in w != 0;  the degree of a
+     polynomial looking down from word top_word, or -1 for 0;  and add w
+     times x ^ pos to a(x), where pos may be as low as -63 if the bits of
+     w below -pos are 0.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static large_word spread_bits( large_word w )
+{
+w = (w | (w << 16)) & 0x0000FFFF0000FFFFULL ;
+w = (w | (w <<  8)) & 0x00FF00FF00FF00FFULL ;
+w = (w | (w <<  4)) & 0x0F0F0F0F0F0F0F0FULL ;
+w = (w | (w <<  2)) & 0x3333333333333333ULL ;
+w = (w | (w <<  1)) & 0x5555555555555555ULL ;
+
+return w ;
+
+} /* ===================== end of function spread_bits ====================== */
+
+
+static int top_bit( large_word w )
+{
+int bit = 0 ;
+
+if (w >> 32) { w >>= 32 ;  bit += 32 ; }
+if (w >> 16) { w >>= 16 ;  bit += 16 ; }
+if (w >>  8) { w >>=  8 ;  bit +=  8 ; }
+if (w >>  4) { w >>=  4 ;  bit +=  4 ; }
+if (w >>  2) { w >>=  2 ;  bit +=  2 ; }
+if (w >>  1) {             bit +=  1 ; }
+
+return bit ;
+
+} /* ======================= end of function top_bit ======================== */
+
+
+static int degree_of( const large_word * a, int top_word )
+{
+int i ;
+
+for (i = top_word ;  i >= 0 ;  --i)
+    if (a[ i ] != 0)
+        return 64 * i + top_bit( a[ i ] ) ;
+
+return -1 ;
+
+} /* ====================== end of function degree_of ======================= */
+
+
+static void xor_at( large_word * a, large_word w, int pos )
+{
+int shift ;
+
+if (pos < 0)
+{
+    a[ 0 ] ^= w >> -pos ;
+    return ;
+}
+
+shift = pos % 64 ;
+a[ pos / 64 ] ^= w << shift ;
+
+if (shift != 0 && (w >> (64 - shift)) != 0)
+    a[ pos / 64 + 1 ] ^= w >> (64 - shift) ;
+
+} /* ======================== end of function xor_at ======================== */
+
+
+
+/*==============================================================================
+|                                 reduce_bits                                  |
+================================================================================
+
+DESCRIPTION
+
+     Reduce a(x) of degree top or less modulo g(x) = x^n + x^e1 + ... .
+
+INPUT
+
+     a         (large_word *)    a(x).
+     top       (int)             Bound on its degree.
+     n         (int)             Degree of g(x).
+     term      (const int *)     Exponents e1 > e2 > ... of g(x) below n.
+     num_terms (int)
+
+OUTPUT
+
+     a         (large_word *)    a(x) (mod g(x)), of degree n-1 or less.
+
+METHOD
+
+     If e1 <= n - 64, take the bits of x^n and above a word at a time,
+     from the top down, and replace x^k by x^(k-n+e1) + ... .  These land
+     below the word we took them from, so they're reduced in turn.
+     Otherwise go a bit at a time.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void reduce_bits( large_word * a, int top, int n, const int * term, int num_terms )
+{
+large_word w ;
+int        i, j, k, e ;
+
+if (num_terms > 0 && n - term[ 0 ] < 64)
+{
+    for (k = top ;  k >= n ;  --k)
+    {
+        if ((a[ k / 64 ] >> (k % 64)) & 1)
+        {
+            a[ k / 64 ] ^= (large_word) 1 << (k % 64) ;
+
+            for (j = 0 ;  j < num_terms ;  ++j)
+            {
+                e = k - n + term[ j ] ;
+                a[ e / 64 ] ^= (large_word) 1 << (e % 64) ;
+            }
+        }
+    }
+    return ;
+}
+
+for (i = top / 64 ;  i >= n / 64 ;  --i)
+{
+    w = a[ i ] ;
+
+    if (64 * i < n)
+        w &= ~(large_word) 0 << (n - 64 * i) ;
+
+    if (w == 0)
+        continue ;
+
+    a[ i ] ^= w ;
+
+    for (j = 0 ;  j < num_terms ;  ++j)
+        xor_at( a, w, 64 * i - n + term[ j ] ) ;
+}
+
+} /* ===================== end of function reduce_bits ====================== */
+
+
+
+/*==============================================================================
+|                           square_mod, times_x_mod                            |
+================================================================================
+
+DESCRIPTION
+
+     a(x)^2 (mod f(x)) and x a(x) (mod f(x)) in place, for a(x) of degree
+     n-1 or less.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void square_mod( LargeField * L, large_word * a )
+{
+int i ;
+
+for (i = 0 ;  i < L->num_words ;  ++i)
+{
+    L->wide[ 2 * i ]     = spread_bits( a[ i ] & 0xFFFFFFFFULL ) ;
+    L->wide[ 2 * i + 1 ] = spread_bits( a[ i ] >> 32 ) ;
+}
+
+reduce_bits( L->wide, 2 * (L->n - 1), L->n, L->term, L->num_terms ) ;
+
+memcpy( a, L->wide, (size_t) L->num_words * sizeof( large_word ) ) ;
+
+} /* ===================== end of function square_mod ======================= */
+
+
+static void times_x_mod( LargeField * L, large_word * a )
+{
+large_word carry = 0, next ;
+int        i ;
+
+for (i = 0 ;  i < L->num_words ;  ++i)
+{
+    next   = a[ i ] >> 63 ;
+    a[ i ] = (a[ i ] << 1) | carry ;
+    carry  = next ;
+}
+
+if ((a[ L->n / 64 ] >> (L->n % 64)) & 1)
+{
+    a[ L->n / 64 ] ^= (large_word) 1 << (L->n % 64) ;
+
+    for (i = 0 ;  i < L->num_terms ;  ++i)
+        a[ L->term[ i ] / 64 ] ^= (large_word) 1 << (L->term[ i ] % 64) ;
+}
+
+} /* ==================== end of function times_x_mod ======================= */
+
+
+
+/*==============================================================================
+|                              x_to_power_is_one                               |
+================================================================================
+
+DESCRIPTION
+
+     Is x^m = 1 (mod f(x))?
+
+METHOD
+
+     As x_to_power:  square for each bit of m after the leading 1, and
+     multiply by x for each 1 bit.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int x_to_power_is_one( LargeField * L, const MultiInt * m )
+{
+int bit, i ;
+
+memset( L->t, 0, (size_t) L->num_words * sizeof( large_word ) ) ;
+L->t[ 0 ] = 2 ;
+
+for (bit = multi_num_bits( m ) - 2 ;  bit >= 0 ;  --bit)
+{
+    square_mod( L, L->t ) ;
+
+    if (multi_bit( m, bit ))
+        times_x_mod( L, L->t ) ;
+}
+
+for (i = 1 ;  i < L->num_words ;  ++i)
+    if (L->t[ i ] != 0)
+        return NO ;
+
+return L->t[ 0 ] == 1 ;
+
+} /* ================= end of function x_to_power_is_one ===================== */
+
+
+
+/*==============================================================================
+|                               has_small_factor                               |
+================================================================================
+
+DESCRIPTION
+
+     Does f(x) have a factor of degree 2 to LARGESIEVEDEG?  Much cheaper
+     than Rabin's test, and throws out most of the trial polynomials.
+
+METHOD
+
+     f(x) has a factor of degree d or a divisor of d exactly when it has a
+     common factor with x^(2^d) - x, the product of all the irreducible
+     polynomials of those degrees.  Reducing f(x) modulo x^(2^d) - x is
+     cheap, since it has only 2 terms, and leaves a small gcd to take.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int has_small_factor( LargeField * L )
+{
+static const int x_term[ 1 ] = { 1 } ;
+
+int d, q ;
+
+for (d = 2 ;  d <= LARGESIEVEDEG ;  ++d)
+{
+    q = 1 << d ;
+
+    memset( L->u, 0, (size_t) L->num_gcd_words * sizeof( large_word ) ) ;
+    memcpy( L->u, L->f, (size_t) L->num_words * sizeof( large_word ) ) ;
+
+    if (L->n >= q)
+        reduce_bits( L->u, L->n, q, x_term, 1 ) ;
+
+    memset( L->v, 0, (size_t) L->num_gcd_words * sizeof( large_word ) ) ;
+    L->v[ q / 64 ] |= (large_word) 1 << (q % 64) ;
+    L->v[ 0 ]      ^= 2 ;
+
+    if (!coprime( L->u, L->v, L->num_gcd_words ))
+        return YES ;
+}
+
+return NO ;
+
+} /* ================== end of function has_small_factor ===================== */
+
+
+
+/*==============================================================================
+|                             is_irreducible_large                             |
+================================================================================
+
+DESCRIPTION
+
+     Rabin's test for the irreducibility of f(x).
+
+METHOD
+
+     Square n times to get x^(2^k) for k = 1 ... n, keeping the ones for
+     k = n / q.  f(x) is irreducible if and only if x^(2^n) = x (mod f(x))
+     and x^(2^(n/q)) - x is prime to f(x) for each prime q | n.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int is_irreducible_large( LargeField * L )
+{
+size_t size = (size_t) L->num_words * sizeof( large_word ) ;
+int    i, k ;
+
+memset( L->t, 0, size ) ;
+L->t[ 0 ] = 2 ;
+
+for (k = 1 ;  k <= L->n ;  ++k)
+{
+    square_mod( L, L->t ) ;
+
+    for (i = 0 ;  i < L->num_primes_of_n ;  ++i)
+        if (k == L->n / L->prime_of_n[ i ])
+            memcpy( L->snapshot + i * L->num_words, L->t, size ) ;
+}
+
+if (L->t[ 0 ] != 2)
+    return NO ;
+
+for (i = 1 ;  i < L->num_words ;  ++i)
+    if (L->t[ i ] != 0)
+        return NO ;
+
+for (i = 0 ;  i < L->num_primes_of_n ;  ++i)
+{
+    memset( L->u, 0, (size_t) L->num_gcd_words * sizeof( large_word ) ) ;
+    memset( L->v, 0, (size_t) L->num_gcd_words * sizeof( large_word ) ) ;
+    memcpy( L->u, L->snapshot + i * L->num_words, size ) ;
+    memcpy( L->v, L->f, size ) ;
+    L->u[ 0 ] ^= 2 ;
+
+    if (!coprime( L->u, L->v, L->num_gcd_words ))
+        return NO ;
+}
+
+return YES ;
+
+} /* ================ end of function is_irreducible_large =================== */
+
+
+
+/*==============================================================================
+|                                   coprime                                    |
+================================================================================
+
+DESCRIPTION
+
+     Is gcd( u(x), v(x) ) = 1?  Euclid's algorithm, with the remainders
+     taken by shifting and adding.  Overwrites u and v.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int coprime( large_word * u, large_word * v, int num_words )
+{
+large_word * swap ;
+int          du = degree_of( u, num_words - 1 ),
+             dv = degree_of( v, num_words - 1 ),
+             d, j ;
+
+for (;;)
+{
+    if (dv < 0)
+        return du == 0 ;
+
+    if (dv == 0)
+        return YES ;
+
+    while (du >= dv)
+    {
+        for (j = dv / 64 ;  j >= 0 ;  --j)
+            xor_at( u, v[ j ], 64 * j + du - dv ) ;
+
+        du = degree_of( u, du / 64 ) ;
+    }
+
+    swap = u ;  u  = v ;   v  = swap ;
+    d    = du ; du = dv ;  dv = d ;
+}
+
+} /* ======================= end of function coprime ======================== */
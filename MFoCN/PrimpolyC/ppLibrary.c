@@ -0,0 +1,507 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppLibrary.c
+|
+|  Description:
+|
+|     Library interface for finding, testing and listing primitive
+|     polynomials from inside another program.
+|
+|  Functions:
+|
+|     primpoly_check
+|     primpoly_init
+|     primpoly_test
+|     primpoly_find
+|     primpoly_enumerate
+|     primpoly_list
+|     store_in_buffer
+|     primpoly_error_string
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  THREADS
+|
+|     None of these functions print or exit, and everything they compute
+|     lives in the PrimpolyContext.  But the tests they call still read a
+|     few switches which main sets from the command line:
+|
+|         --timing, --counters    (ppTiming.c, ppCounters.c)
+|         --adaptive              (ppFilter.c, with a thread local order
+|                                  of the tests)
+|         --factors               (ppFactorTable.c, used to factor r
+|                                  and by EulerPhi in primpoly_init)
+|
+|     and with -DPP_TRACE, the trace hooks record into a shared buffer.
+|     All of these are off unless set, and are set once before any
+|     searching starts.  So several threads may call these functions at
+|     once, each with its own PrimpolyContext, as long as nobody changes
+|     a switch or loads a table meanwhile.
+|
+|  BUILDING
+|
+|     Everything but Primpoly.c, which has main, goes into the library:
+|
+|         cc -O2 -c pp*.c
+|         ar rcs libprimpoly.a pp*.o
+|         cc -O2 -o count count.c libprimpoly.a -lm -pthread
+|
+|     where count.c is, for example,
+|
+|         #include <stdio.h>
+|         #include "Primpoly.h"
+|
+|         static int show( void * user, const int * f, int n, bigint index )
+|         {
+|         int k ;
+|
+|         for (k = n ;  k >= 0 ;  --k)
+|             if (f[ k ] != 0)
+|                 printf( " %d x^%d", f[ k ], k ) ;
+|         printf( "\n" ) ;
+|
+|         return index == *(bigint *) user ;    (nonzero stops)
+|         }
+|
+|         int main( void )
+|         {
+|         PrimpolyContext context ;
+|         bigint          limit = 3, num_found = 0 ;
+|
+|         if (primpoly_init( &context, 5, 4 ) != PP_OK)
+|             return 1 ;
+|
+|         primpoly_enumerate( &context, show, &limit, &num_found ) ;
+|         printf( "%s of %s\n", bigint_string( num_found ),
+|                 bigint_string( context.num_prim_poly ) ) ;
+|         return 0 ;
+|         }
+|
+|     which prints the first 3 of the 48 primitive polynomials of degree 4
+|     modulo 5.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "Primpoly.h"
+
+
+/*==============================================================================
+|                                primpoly_check                                |
+================================================================================
+
+DESCRIPTION
+
+     Check p and n, without doing any of the work of primpoly_init.
+
+INPUT
+
+     p (int)                       The modulus.
+     n (int)                       The degree.
+
+RETURNS
+
+     PP_OK if primpoly_init would accept them, otherwise PP_BAD_P,
+     PP_BAD_N or PP_TOO_BIG, as it would return.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int primpoly_check( int p, int n )
+{
+if (n > MAXDEGPOLY || n < 2)
+    return PP_BAD_N ;
+
+if (p < 2 || !is_almost_surely_prime( p ))
+    return PP_BAD_P ;
+
+if (n * log( (double) p ) > log( (double) (sbigint) MAXPTON ))
+    return PP_TOO_BIG ;
+
+return PP_OK ;
+
+} /* =================== end of function primpoly_check ===================== */
+
+
+
+/*==============================================================================
+|                                primpoly_init                                 |
+================================================================================
+
+DESCRIPTION
+
+     Set up a context for degree n polynomials modulo p.
+
+INPUT
+
+     p (int)                       A prime, p >= 2.
+     n (int)                       The degree, 2 <= n <= MAXDEGPOLY.
+
+OUTPUT
+
+     context (PrimpolyContext *)   Caller's storage, filled in with p, n,
+                                   the factorization of r, the number of
+                                   primitive polynomials, and zeroed
+                                   statistics.
+
+RETURNS
+
+     PP_OK, or PP_BAD_P, PP_BAD_N, PP_TOO_BIG if p, n are out of range.
+
+EXAMPLE
+
+     PrimpolyContext context ;
+     int             f[ MAXDEGPOLY + 1 ] ;
+
+     if (primpoly_init( &context, 2, 4 ) == PP_OK &&
+         primpoly_find( &context, f ) == PP_OK)
+         ...  f[] has x^4 + x + 1
+
+METHOD
+
+     The same checks and setup as main, returning a status instead of
+     printing an error and exiting.  Like main, factor r from the table
+     loaded with --factors if it's there.  The context needs no cleaning up.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int primpoly_init( PrimpolyContext * context, int p, int n )
+{
+int status ;
+
+memset( context, 0, sizeof( *context ) ) ;
+
+if ((status = primpoly_check( p, n )) != PP_OK)
+    return status ;
+
+context->p             = p ;
+context->n             = n ;
+context->max_num_poly  = power( p, n ) ;
+context->r             = (context->max_num_poly - 1) / (p - 1) ;
+context->prime_count   = factor_from_table( context->r, context->primes, context->count ) ;
+
+if (context->prime_count < 0)
+    context->prime_count = factor( context->r, context->primes, context->count ) ;
+
+context->num_prim_poly = EulerPhi( context->max_num_poly - 1 ) / n ;
+
+return PP_OK ;
+
+} /* =================== end of function primpoly_init ====================== */
+
+
+
+/*==============================================================================
+|                                primpoly_test                                 |
+================================================================================
+
+DESCRIPTION
+
+     Test a polynomial for primitivity.
+
+INPUT
+
+     context (PrimpolyContext *)   From primpoly_init.
+     f (int *)                     Coefficients f[ 0 ] ... f[ n ], with
+                                   f[ n ] = 1 and 0 <= f[ i ] < p.
+
+OUTPUT
+
+     is_primitive (int *)          YES or NO.
+     context->stats                Updated.
+
+RETURNS
+
+     PP_OK, or PP_BAD_POLY if f isn't monic with coefficients modulo p.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int primpoly_test( PrimpolyContext * context, const int * f, int * is_primitive )
+{
+int g[ MAXDEGPOLY + 1 ] ;
+int i ;
+
+if (f[ context->n ] != 1)
+    return PP_BAD_POLY ;
+
+for (i = 0 ;  i <= context->n ;  ++i)
+{
+    if (f[ i ] < 0 || f[ i ] >= context->p)
+        return PP_BAD_POLY ;
+
+    g[ i ] = f[ i ] ;
+}
+
+++context->stats.num_poly ;
+
+*is_primitive = passes_primitivity_tests( g, context->n, context->p, context->r,
+                                          context->primes, context->prime_count,
+                                          &context->stats ) ;
+return PP_OK ;
+
+} /* =================== end of function primpoly_test ====================== */
+
+
+
+/*==============================================================================
+|                                primpoly_find                                 |
+================================================================================
+
+DESCRIPTION
+
+     Find the first primitive polynomial in the order of the search, the
+     same one the program prints.
+
+INPUT
+
+     context (PrimpolyContext *)   From primpoly_init.
+
+OUTPUT
+
+     f (int *)                     The polynomial, n + 1 coefficients.
+     context->stats                Updated.
+
+RETURNS
+
+     PP_OK, or PP_NOT_FOUND, which would be a bug.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int primpoly_find( PrimpolyContext * context, int * f )
+{
+bigint rank ;
+
+initial_trial_poly( f, context->n ) ;
+
+for (rank = 0 ;  rank <= context->max_num_poly ;  ++rank)
+{
+    next_trial_poly( f, context->n, context->p ) ;
+    ++context->stats.num_poly ;
+
+    if (passes_primitivity_tests( f, context->n, context->p, context->r,
+                                  context->primes, context->prime_count,
+                                  &context->stats ))
+        return PP_OK ;
+}
+
+return PP_NOT_FOUND ;
+
+} /* =================== end of function primpoly_find ====================== */
+
+
+
+/*==============================================================================
+|                             primpoly_enumerate                               |
+================================================================================
+
+DESCRIPTION
+
+     Go through all primitive polynomials in order, handing each to a
+     function of the caller's.
+
+INPUT
+
+     context (PrimpolyContext *)   From primpoly_init.
+     callback (PrimpolyCallback)   Called as callback( user, f, n, index ) for
+                                   each primitive polynomial f, with index
+                                   counting from 1.  f is only good during the
+                                   call.  Return non-zero to stop early.
+     user (void *)                 Passed along to callback.
+
+OUTPUT
+
+     num_found (bigint *)          How many were handed to callback.
+     context->stats                Updated.
+
+RETURNS
+
+     PP_OK when done, or PP_STOPPED if callback asked to stop.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int primpoly_enumerate( PrimpolyContext * context, PrimpolyCallback callback,
+                        void * user, bigint * num_found )
+{
+int    f[ MAXDEGPOLY + 1 ] ;
+bigint rank ;
+
+*num_found = 0 ;
+
+initial_trial_poly( f, context->n ) ;
+
+for (rank = 0 ;  rank <= context->max_num_poly ;  ++rank)
+{
+    next_trial_poly( f, context->n, context->p ) ;
+    ++context->stats.num_poly ;
+
+    if (passes_primitivity_tests( f, context->n, context->p, context->r,
+                                  context->primes, context->prime_count,
+                                  &context->stats ))
+    {
+        ++*num_found ;
+
+        if (callback( user, f, context->n, *num_found ) != 0)
+            return PP_STOPPED ;
+    }
+}
+
+return PP_OK ;
+
+} /* ================= end of function primpoly_enumerate =================== */
+
+
+
+/*==============================================================================
+|                               store_in_buffer                                |
+================================================================================
+
+DESCRIPTION
+
+     Callback for primpoly_list:  copy the polynomial into the caller's
+     buffer, and stop when it is full.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+typedef struct
+{
+    int *  buffer ;
+    bigint max_polys ;
+} ListBuffer ;
+
+static int store_in_buffer( void * user, const int * f, int n, bigint index )
+{
+ListBuffer * list = (ListBuffer *) user ;
+
+memcpy( list->buffer + (index - 1) * (bigint) (n + 1), f, (size_t) (n + 1) * sizeof( int ) ) ;
+
+return index == list->max_polys ;
+
+} /* ================ end of function store_in_buffer ======================= */
+
+
+
+/*==============================================================================
+|                                primpoly_list                                 |
+================================================================================
+
+DESCRIPTION
+
+     Collect the first primitive polynomials in order into a buffer.
+
+INPUT
+
+     context (PrimpolyContext *)   From primpoly_init.
+     max_polys (bigint)            Room in buffer, in polynomials.
+
+OUTPUT
+
+     buffer (int *)                max_polys * (n + 1) ints.  Polynomial k
+                                   (from 0) is at buffer + k * (n + 1).
+     num_found (bigint *)          How many were stored.
+
+RETURNS
+
+     PP_OK if that was all of them, PP_STOPPED if the buffer filled first.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int primpoly_list( PrimpolyContext * context, int * buffer, bigint max_polys,
+                   bigint * num_found )
+{
+ListBuffer list ;
+
+*num_found = 0 ;
+
+if (max_polys == 0)
+    return (context->num_prim_poly == 0) ? PP_OK : PP_STOPPED ;
+
+list.buffer    = buffer ;
+list.max_polys = max_polys ;
+
+/* Filling the buffer with the very last one isn't stopping early. */
+if (primpoly_enumerate( context, store_in_buffer, &list, num_found ) == PP_STOPPED &&
+    *num_found < context->num_prim_poly)
+    return PP_STOPPED ;
+
+return PP_OK ;
+
+} /* =================== end of function primpoly_list ====================== */
+
+
+
+/*==============================================================================
+|                            primpoly_error_string                             |
+================================================================================
+
+DESCRIPTION
+
+     Describe a status returned by one of the primpoly_ functions.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+const char * primpoly_error_string( int status )
+{
+switch( status )
+{
+    case PP_OK:         return "no error" ;
+    case PP_BAD_P:      return "p must be a prime number" ;
+    case PP_BAD_N:      return "n is out of range" ;
+    case PP_TOO_BIG:    return "p to the nth power is too large" ;
+    case PP_BAD_POLY:   return "polynomial must be monic with coefficients modulo p" ;
+    case PP_NOT_FOUND:  return "no primitive polynomial found" ;
+    case PP_STOPPED:    return "stopped before the end" ;
+    default:            return "unknown error" ;
+}
+
+} /* ================ end of function primpoly_error_string ================= */
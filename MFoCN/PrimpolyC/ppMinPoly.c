@@ -0,0 +1,629 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppMinPoly.c
+|
+|  Description:
+|
+|     List all primitive polynomials as minimal polynomials of the
+|     primitive elements of the field generated by one of them.
+|
+|  Functions:
+|
+|     list_all_by_minimal_poly
+|     make_wheel
+|     is_coset_leader
+|     minimal_poly_of_power
+|     berlekamp_massey
+|     compare_ranks
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Primpoly.h"
+
+
+static unsigned int * make_wheel( bigint * primes, int prime_count, int p,
+                                  bigint * wheel_size, unsigned int * num_spokes,
+                                  int * num_on_wheel, int * p_on_wheel ) ;
+static int  is_coset_leader ( bigint k, bigint N, int n, int p ) ;
+static int  berlekamp_massey( int * s, int len, int * c, int p ) ;
+static int  compare_ranks   ( const void * a, const void * b ) ;
+
+
+/*==============================================================================
+|                          list_all_by_minimal_poly                            |
+================================================================================
+
+DESCRIPTION
+
+     List all primitive polynomials of degree n modulo p, given one of them,
+     without testing any trial polynomials.
+
+INPUT
+
+     f             (int *)       A primitive polynomial of degree n modulo p.
+     n             (int, n >= 2) Its degree.
+     p             (int, p >= 2) Modulo p coefficient arithmetic.
+     num_prim_poly (bigint)      Total number of primitive polynomials.
+     sorted        (int)         YES to list them in the same order as the
+                                 search loop, NO to list each as soon as
+                                 we find it (--unsorted).
+
+OUTPUT
+
+     Standard output             Every primitive polynomial, in the format
+                                 of the search loop in main.
+
+RETURNS
+
+     The number of primitive polynomials listed.
+
+EXAMPLE
+                   4                                                  4
+     Let f(x) = x  + x + 1 modulo 2, whose root a generates GF( 2 ).
+                                  4
+     The units modulo N = 2  - 1 = 15 are k = 1, 2, 4, 7, 8, 11, 13, 14, which
+     fall into the two cyclotomic cosets {1, 2, 4, 8} and {7, 14, 13, 11}.
+                                                          7                 4    3
+     The leaders are 1, giving f(x) back again, and 7:  a  has the minimal
+     polynomial x^4 + x^3 + 1.
+
+METHOD
+                                                                n
+     Let a be a root of f(x), so a is a generator of the group GF(p )*
+                       n                                      k
+     of order N = p  - 1.  The other generators are exactly a  for
+     gcd( k, N ) = 1, and the primitive polynomials are exactly their
+                                                           k    kp
+     minimal polynomials.  Conjugate elements have the same one:  a,  a  ,
+        2
+       kp
+     a    , ... all share a minimal polynomial, so we only take the smallest
+     k in each cyclotomic coset { k p^i mod N }.
+
+     Multiplying by p rotates the n base p digits of k, so a leader has
+     its smallest digit on top, and doesn't end in 0.  Its top digit is
+     then below p - 1, and k < (p - 1) p^(n-1), which for p = 2 is half of
+     the exponents.  Rather than try each k up to there, we step along a
+     wheel made of p and the small primes of N, whose spokes are just the
+     k prime to all of them;  see make_wheel.  Any large primes of N, and
+     the coset, we check for each k on the wheel.
+
+     This does O( n^3 ) work per primitive polynomial, instead of testing
+     all p^n trial polynomials, of which only about 1 in n is primitive.
+
+     The polynomials come out in no useful order.  To list them in order
+     we save their ranks in the order of next_trial_poly, sort them, and
+     print them at the end.  Unsorted, we print each one as we go, and
+     need no memory for them at all.
+
+BUGS
+
+     Sorted, we need a bigint for every primitive polynomial before we can
+     print the first.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint list_all_by_minimal_poly( int * f, int n, int p, bigint num_prim_poly,
+                                 int sorted )
+{
+
+/*------------------------------------------------------------------------------
+|                               Local Variables                                |
+------------------------------------------------------------------------------*/
+
+bigint
+    N,                             /* p^n - 1, the order of the group.      */
+    k,                             /* Exponent of the generator a^k.        */
+    limit,                         /* All coset leaders are below this.     */
+    base,                          /* Multiple of the wheel size.           */
+    wheel_size,                    /* Product of the primes on the wheel.   */
+    rank,                          /* Position of g(x) in the search order. */
+    pk,                            /* p^i while computing the rank.         */
+    num_found = 0,                 /* Primitive polynomials found so far.   */
+    primes[ MAXNUMPRIMEFACTORS ],  /* The distinct prime factors of N.      */
+    * ranks = (bigint *) 0 ;       /* Ranks of all primitive polynomials.   */
+
+unsigned int
+    * spoke,                       /* Residues prime to the wheel.          */
+    num_spokes,
+    j ;
+
+int
+    count[ MAXNUMPRIMEFACTORS ],   /* ... and their multiplicities.         */
+    prime_count,                   /* Primes are in locations 0 to prime_count. */
+    num_on_wheel,                  /* primes[ 0 ... num_on_wheel-1 ] are.   */
+    p_on_wheel,                    /* YES if p is too.                      */
+    i,
+    is_unit,                       /* YES if gcd( k, N ) = 1.               */
+    g[ MAXDEGPOLY + 1 ],           /* Minimal polynomial of a^k.            */
+
+    /*  x ^ n , ... , x ^ 2n-2 (mod f(x), p) */
+    power_table[ MAXDEGPOLY - 1 ] [ MAXDEGPOLY ] ;
+
+/*------------------------------------------------------------------------------
+|                                Function Body                                 |
+------------------------------------------------------------------------------*/
+
+N = power( p, n ) - 1 ;
+
+limit = N + 1 - power( p, n - 1 ) ;
+
+prime_count = factor( N, primes, count ) ;
+
+construct_power_table( power_table, f, n, p ) ;
+
+spoke = make_wheel( primes, prime_count, p, &wheel_size, &num_spokes,
+                    &num_on_wheel, &p_on_wheel ) ;
+
+if (sorted)
+{
+    ranks = (bigint *) malloc( (size_t) num_prim_poly * sizeof( bigint ) ) ;
+
+    if (ranks == (bigint *) 0)
+    {
+        printf( "ERROR:  Not enough memory to hold all the primitive polynomials.\n"
+                "        Try again with --unsorted.\n\n" ) ;
+        exit( 1 ) ;
+    }
+}
+
+for (base = 0 ;  base < limit ;  base += wheel_size)
+{
+    for (j = 0 ;  j < num_spokes ;  ++j)
+    {
+        k = base + spoke[ j ] ;
+
+        if (k >= limit)
+            break ;
+
+        /*  A leader is a unit, and isn't a multiple of p. */
+        is_unit = (k != 0 && (p_on_wheel || k % (bigint) p != 0)) ;
+        for (i = num_on_wheel ;  is_unit && i <= prime_count ;  ++i)
+            if (k % primes[ i ] == 0)
+                is_unit = NO ;
+
+        if (!is_unit || !is_coset_leader( k, N, n, p ))
+            continue ;
+
+        minimal_poly_of_power( k, g, power_table, n, p ) ;
+
+        if (num_found == num_prim_poly)
+        {
+            printf( "Internal error:  \n"
+                    "Found more minimal polynomials than there are primitive polynomials.\n"
+                    "Please let the author know by e-mail.\n" ) ;
+            exit( 1 ) ;
+        }
+
+        if (!sorted)
+        {
+            write_listing_entry( g, n, p, ++num_found, num_prim_poly ) ;
+            continue ;
+        }
+
+        for (i = 0, rank = 0, pk = 1 ;  i <= n - 1 ;  ++i, pk *= p)
+            rank += (bigint) g[ i ] * pk ;
+
+        ranks[ num_found++ ] = rank ;
+    }
+}
+
+free( spoke ) ;
+
+if (sorted)
+{
+    qsort( ranks, (size_t) num_found, sizeof( bigint ), compare_ranks ) ;
+
+    for (k = 0 ;  k < num_found ;  ++k)
+    {
+        unrank_trial_poly( g, n, p, ranks[ k ] ) ;
+        write_listing_entry( g, n, p, k + 1, num_prim_poly ) ;
+    }
+
+    free( ranks ) ;
+}
+
+return num_found ;
+
+} /* =============== end of function list_all_by_minimal_poly ================ */
+
+
+
+/*==============================================================================
+|                                 make_wheel                                   |
+================================================================================
+
+DESCRIPTION
+
+     Make a wheel for stepping through the numbers prime to p and the
+     small primes of N.
+
+INPUT
+
+     primes (bigint *)       The distinct primes of N, increasing.
+     prime_count (int)       Primes are in locations 0 to prime_count.
+     p (int)                 The prime p, which doesn't divide N.
+
+OUTPUT
+
+     wheel_size (bigint *)   The product W of the primes on the wheel.
+     num_spokes (unsigned int *)
+                             How many residues 0 <= s < W are prime to W.
+     num_on_wheel (int *)    primes[ 0 ], ..., primes[ num_on_wheel - 1 ]
+                             are on the wheel,
+     p_on_wheel (int *)      and p is, if this is YES.
+
+RETURNS
+
+     The residues s, increasing, in an array the caller must free().  Every
+     k prime to the wheel is base + s for some multiple base of W.
+
+EXAMPLE
+
+     For p = 2 and N = 15, W = 2 * 3 * 5 = 30 and the residues are 1, 7,
+     11, 13, 17, 19, 23, 29.
+
+METHOD
+
+     Take the primes in increasing order while W stays within MINPOLYWHEEL,
+     then p if it fits.  Sieve the residues with each prime.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static unsigned int * make_wheel( bigint * primes, int prime_count, int p,
+                                  bigint * wheel_size, unsigned int * num_spokes,
+                                  int * num_on_wheel, int * p_on_wheel )
+{
+unsigned char * sieve ;
+unsigned int  * spoke ;
+unsigned int    W = 1, s, q, j ;
+int             i ;
+
+for (i = 0 ;  i <= prime_count && primes[ i ] <= MINPOLYWHEEL / W ;  ++i)
+    W *= (unsigned int) primes[ i ] ;
+
+*num_on_wheel = i ;
+*p_on_wheel   = ((unsigned int) p <= MINPOLYWHEEL / W) ;
+
+if (*p_on_wheel)
+    W *= (unsigned int) p ;
+
+sieve = (unsigned char *) calloc( (size_t) W, sizeof( unsigned char ) ) ;
+spoke = (unsigned int *)  malloc( (size_t) W * sizeof( unsigned int ) ) ;
+
+if (sieve == (unsigned char *) 0 || spoke == (unsigned int *) 0)
+{
+    printf( "ERROR:  Not enough memory for the minimal polynomial search.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+for (i = 0 ;  i <= *num_on_wheel ;  ++i)
+{
+    if (i < *num_on_wheel)
+        q = (unsigned int) primes[ i ] ;
+    else if (*p_on_wheel)
+        q = (unsigned int) p ;
+    else
+        break ;
+
+    for (s = 0 ;  s < W ;  s += q)
+        sieve[ s ] = 1 ;
+}
+
+for (s = 0, j = 0 ;  s < W ;  ++s)
+    if (!sieve[ s ])
+        spoke[ j++ ] = s ;
+
+free( sieve ) ;
+
+*wheel_size = (bigint) W ;
+*num_spokes = j ;
+
+return spoke ;
+
+} /* ==================== end of function make_wheel ======================== */
+
+
+
+/*==============================================================================
+|                               is_coset_leader                                |
+================================================================================
+
+DESCRIPTION
+
+     Test if k is the smallest number in its cyclotomic coset modulo N.
+
+INPUT
+
+     k (bigint)       0 < k < N.
+     N (bigint)       p^n - 1.
+     n (int)          Size of the coset at most.
+     p (int)          The prime.
+
+RETURNS
+                                          i
+     YES    if k <= k p^i (mod N) for all 1 <= i <= n-1.
+     NO     otherwise.
+
+EXAMPLE
+
+     For p = 2, N = 15, the coset of 7 is { 7, 14, 13, 11 }, so 7 is a
+     leader and 11 is not.
+
+METHOD
+
+     Multiply by p over and over, stopping as soon as we get something
+     smaller.  Half the time that happens on the first step.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int is_coset_leader( bigint k, bigint N, int n, int p )
+{
+bigint conjugate = k ;
+int    i ;
+
+for (i = 1 ;  i <= n - 1 ;  ++i)
+{
+    conjugate = multiply_mod( conjugate, (bigint) p, N ) ;
+
+    if (conjugate < k)
+        return NO ;
+}
+
+return YES ;
+
+} /* ================== end of function is_coset_leader ===================== */
+
+
+
+/*==============================================================================
+|                            minimal_poly_of_power                             |
+================================================================================
+
+DESCRIPTION
+                                             k
+     Find the minimal polynomial of g(x) of a  over GF( p ), where a is a
+     root of the primitive polynomial f(x).
+
+INPUT
+
+     k (bigint)              The power, gcd( k, p^n - 1 ) = 1.
+     power_table (int **)    x ^ k (mod f(x), p) for n <= k <= 2n-2.
+     n (int)                 Degree of f(x).
+     p (int)                 Modulo p coefficient arithmetic.
+
+OUTPUT
+
+     g (int *)               Monic minimal polynomial of degree n.
+
+EXAMPLE
+                    4                                     3
+     With f(x) = x  + x + 1 modulo 2 and k = 7, b = x  + x + 1 and
+                         4    3
+     we get g(x) = x  + x  + 1.
+
+METHOD
+               k
+     Let b = a  = x^k (mod f(x), p).  Take the sequence of constant
+                  j
+     terms of b ,  j = 0, 1, ..., 2n-1, each from the one before by
+     product().  The sequence satisfies the linear recurrence whose
+     characteristic polynomial is the minimal polynomial of b, and since
+     that polynomial is irreducible of degree n, it is also the shortest
+     recurrence the sequence satisfies.  Berlekamp-Massey finds it from the
+     2n terms.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void minimal_poly_of_power( bigint k, int * g,
+                            int power_table[][ MAXDEGPOLY ], int n, int p )
+{
+int b[ MAXDEGPOLY ] ;              /* a^k                     */
+int b_to_j[ MAXDEGPOLY ] ;         /* a^(kj)                  */
+int s[ 2 * MAXDEGPOLY ] ;          /* Its constant terms.     */
+int c[ 2 * MAXDEGPOLY + 1 ] ;      /* Connection polynomial.  */
+int i, j, L ;
+
+x_to_power( k, b, power_table, n, p ) ;
+
+for (i = 0 ;  i <= n - 1 ;  ++i)
+    b_to_j[ i ] = 0 ;
+b_to_j[ 0 ] = 1 ;
+
+for (j = 0 ;  j < 2 * n ;  ++j)
+{
+    s[ j ] = b_to_j[ 0 ] ;
+    product( b_to_j, b, power_table, n, p ) ;
+}
+
+L = berlekamp_massey( s, 2 * n, c, p ) ;
+
+if (L != n)
+{
+    printf( "Internal error:  \n"
+            "Minimal polynomial of a power of x has degree %d, not %d.\n"
+            "Please let the author know by e-mail.\n", L, n ) ;
+    exit( 1 ) ;
+}
+
+/*                                            L        L-1
+    Connection polynomial 1 + c z + ... + c  z  gives x  + c  x    + ... + c .
+                               1           L               1                L
+*/
+for (i = 0 ;  i <= n ;  ++i)
+    g[ i ] = c[ n - i ] ;
+
+} /* ============== end of function minimal_poly_of_power =================== */
+
+
+
+/*==============================================================================
+|                               berlekamp_massey                               |
+================================================================================
+
+DESCRIPTION
+
+     Find the shortest linear recurrence satisfied by a sequence modulo p.
+
+INPUT
+
+     s   (int *)    s[ 0 ], ..., s[ len-1 ], the sequence.
+     len (int)      Its length.
+     p   (int)      Prime modulus.
+
+OUTPUT
+                                                       L
+     c   (int *)    Connection polynomial 1 + c z + ... c  z, so that
+                                               1         L
+                    s  + c  s    + ... + c  s     = 0 (mod p)  for L <= j < len.
+                     j    1  j-1          L  j-L
+
+RETURNS
+
+     L, the length of the recurrence.
+
+METHOD
+
+     J. L. Massey, "Shift-register synthesis and BCH decoding," IEEE Trans.
+     Info. Theory, IT-15 (1969).  Keep the best recurrence c so far and the
+     last one b before the length changed.  When c fails to predict the
+     next term, subtract a multiple of b, shifted by m places, which makes
+     up the discrepancy.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int berlekamp_massey( int * s, int len, int * c, int p )
+{
+int b[ 2 * MAXDEGPOLY + 1 ] ;  /* Recurrence before the last length change. */
+int t[ 2 * MAXDEGPOLY + 1 ] ;  /* Copy of c.                                 */
+int L  = 0 ;                   /* Current length.                            */
+int m  = 1 ;                   /* Steps since the last length change.       */
+int bd = 1 ;                   /* Discrepancy at the last length change.    */
+int d, coeff, i, j ;
+
+for (i = 0 ;  i <= len ;  ++i)
+    c[ i ] = b[ i ] = 0 ;
+
+c[ 0 ] = b[ 0 ] = 1 ;
+
+for (i = 0 ;  i < len ;  ++i)
+{
+    /* Discrepancy between s[ i ] and what c predicts. */
+    d = s[ i ] ;
+    for (j = 1 ;  j <= L ;  ++j)
+        d = mod( d + mod( c[ j ] * s[ i - j ], p ), p ) ;
+
+    if (d == 0)
+    {
+        ++m ;
+        continue ;
+    }
+
+    coeff = mod( d * inverse_mod_p( bd, p ), p ) ;
+
+    if (2 * L <= i)
+    {
+        for (j = 0 ;  j <= len ;  ++j)
+            t[ j ] = c[ j ] ;
+
+        for (j = 0 ;  j + m <= len ;  ++j)
+            c[ j + m ] = mod( c[ j + m ] - mod( coeff * b[ j ], p ), p ) ;
+
+        L  = i + 1 - L ;
+        bd = d ;
+        m  = 1 ;
+
+        for (j = 0 ;  j <= len ;  ++j)
+            b[ j ] = t[ j ] ;
+    }
+    else
+    {
+        for (j = 0 ;  j + m <= len ;  ++j)
+            c[ j + m ] = mod( c[ j + m ] - mod( coeff * b[ j ], p ), p ) ;
+
+        ++m ;
+    }
+}
+
+return L ;
+
+} /* ================= end of function berlekamp_massey ===================== */
+
+
+
+/*==============================================================================
+|                                compare_ranks                                 |
+================================================================================
+
+DESCRIPTION
+
+     Comparison function for sorting bigints with qsort.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int compare_ranks( const void * a, const void * b )
+{
+bigint x = *(const bigint *) a ;
+bigint y = *(const bigint *) b ;
+
+return (x > y) - (x < y) ;
+
+} /* =================== end of function compare_ranks ====================== */
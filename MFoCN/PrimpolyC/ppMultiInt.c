@@ -0,0 +1,965 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppMultiInt.c
+|
+|  Description:
+|
+|     Multiple precision integers, for r = p^n - 1 when it is too big for a
+|     bigint, and lists of their prime factors.
+|
+|  Functions:
+|
+|     multi_set
+|     multi_copy
+|     multi_to_bigint
+|     multi_power
+|     multi_compare
+|     multi_add_small
+|     multi_subtract_small
+|     multi_multiply_small
+|     multi_divide_small
+|     multi_multiply
+|     multi_divide
+|     multi_subtract
+|     multi_gcd
+|     multi_num_bits
+|     multi_bit
+|     multi_is_prime
+|     multi_is_mersenne_prime
+|     multi_to_string
+|     multi_from_string
+|     multi_add_factor
+|     multi_free_factors
+|     multi_trim
+|     multi_power_mod
+|     mersenne_reduce
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  REPRESENTATION
+|
+|     A MultiInt holds its value in base 2^32 limbs, least significant
+|     first, with no leading zero limbs, so zero has size 0.  There's room
+|     for the product of two numbers below 2^MAXLARGEDEG, and that's all
+|     the large degree search needs.  Arithmetic is schoolbook, with the
+|     division of Knuth, The Art of Computer Programming, Vol. 2,
+|     Section 4.3.1, Algorithm D.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Primpoly.h"
+
+
+static void multi_trim     ( MultiInt * a ) ;
+static void multi_power_mod( MultiInt * y, const MultiInt * a, const MultiInt * e,
+                             const MultiInt * m ) ;
+static void mersenne_reduce( MultiInt * s, int n ) ;
+
+
+/*==============================================================================
+|                                  multi_set                                   |
+================================================================================
+
+DESCRIPTION
+
+     Set a MultiInt to the value of a bigint.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_set( MultiInt * a, bigint x )
+{
+for (a->size = 0 ;  x != 0 ;  x >>= 32)
+    a->limb[ a->size++ ] = (unsigned int) x ;
+
+} /* ====================== end of function multi_set ======================= */
+
+
+
+/*==============================================================================
+|                                  multi_copy                                  |
+================================================================================
+
+DESCRIPTION
+
+     a = b, copying only the limbs in use.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_copy( MultiInt * a, const MultiInt * b )
+{
+a->size = b->size ;
+memcpy( a->limb, b->limb, (size_t) b->size * sizeof( b->limb[ 0 ] ) ) ;
+
+} /* ====================== end of function multi_copy ====================== */
+
+
+
+/*==============================================================================
+|                               multi_to_bigint                                |
+================================================================================
+
+DESCRIPTION
+
+     The value of a MultiInt as a bigint, if it fits.
+
+RETURNS
+
+     YES and x if a < 2^NUMBITS, NO otherwise.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int multi_to_bigint( const MultiInt * a, bigint * x )
+{
+int i ;
+
+/*  NUMBITS is 8 * sizeof( bigint ) without brackets, so bracket it for the cast. */
+if (multi_num_bits( a ) > (int) (NUMBITS))
+    return NO ;
+
+for (*x = 0, i = a->size - 1 ;  i >= 0 ;  --i)
+    *x = (*x << 16 << 16) | (bigint) a->limb[ i ] ;
+
+return YES ;
+
+} /* =================== end of function multi_to_bigint ===================== */
+
+
+
+/*==============================================================================
+|                                 multi_power                                  |
+================================================================================
+
+DESCRIPTION
+                 n
+     Set a = p ,  like power() but without the limit on the size.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_power( MultiInt * a, int p, int n )
+{
+multi_set( a, 1 ) ;
+
+while (n-- > 0)
+    multi_multiply_small( a, (unsigned int) p ) ;
+
+} /* ===================== end of function multi_power ====================== */
+
+
+
+/*==============================================================================
+|                                multi_compare                                 |
+================================================================================
+
+DESCRIPTION
+
+     Compare two MultiInts.
+
+RETURNS
+
+     -1, 0 or 1 as a < b, a = b or a > b.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int multi_compare( const MultiInt * a, const MultiInt * b )
+{
+int i ;
+
+if (a->size != b->size)
+    return (a->size < b->size) ? -1 : 1 ;
+
+for (i = a->size - 1 ;  i >= 0 ;  --i)
+    if (a->limb[ i ] != b->limb[ i ])
+        return (a->limb[ i ] < b->limb[ i ]) ? -1 : 1 ;
+
+return 0 ;
+
+} /* ==================== end of function multi_compare ===================== */
+
+
+
+/*==============================================================================
+|                 multi_add_small, multi_subtract_small                        |
+================================================================================
+
+DESCRIPTION
+
+     a + x and a - x for a one limb x.  For the subtraction, a >= x.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_add_small( MultiInt * a, unsigned int x )
+{
+unsigned long long carry = x ;
+int                i ;
+
+for (i = 0 ;  carry != 0 && i < a->size ;  ++i)
+{
+    carry       += a->limb[ i ] ;
+    a->limb[ i ] = (unsigned int) carry ;
+    carry      >>= 32 ;
+}
+
+if (carry != 0)
+    a->limb[ a->size++ ] = (unsigned int) carry ;
+
+} /* =================== end of function multi_add_small ===================== */
+
+
+void multi_subtract_small( MultiInt * a, unsigned int x )
+{
+unsigned int borrow = x ;
+int          i ;
+
+for (i = 0 ;  borrow != 0 && i < a->size ;  ++i)
+{
+    unsigned int old = a->limb[ i ] ;
+
+    a->limb[ i ] = old - borrow ;
+    borrow       = (old < borrow) ? 1 : 0 ;
+}
+
+multi_trim( a ) ;
+
+} /* ================= end of function multi_subtract_small ================== */
+
+
+
+/*==============================================================================
+|                 multi_multiply_small, multi_divide_small                     |
+================================================================================
+
+DESCRIPTION
+
+     a m, and a / d in place for one limb m and d > 0.
+
+RETURNS
+
+     multi_divide_small returns the remainder, a mod d.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_multiply_small( MultiInt * a, unsigned int m )
+{
+unsigned long long carry = 0 ;
+int                i ;
+
+for (i = 0 ;  i < a->size ;  ++i)
+{
+    carry       += (unsigned long long) a->limb[ i ] * m ;
+    a->limb[ i ] = (unsigned int) carry ;
+    carry      >>= 32 ;
+}
+
+if (carry != 0)
+    a->limb[ a->size++ ] = (unsigned int) carry ;
+
+multi_trim( a ) ;
+
+} /* ================= end of function multi_multiply_small ================== */
+
+
+unsigned int multi_divide_small( MultiInt * a, unsigned int d )
+{
+unsigned long long rem = 0 ;
+int                i ;
+
+for (i = a->size - 1 ;  i >= 0 ;  --i)
+{
+    rem          = (rem << 32) | a->limb[ i ] ;
+    a->limb[ i ] = (unsigned int) (rem / d) ;
+    rem         %= d ;
+}
+
+multi_trim( a ) ;
+
+return (unsigned int) rem ;
+
+} /* ================== end of function multi_divide_small =================== */
+
+
+
+/*==============================================================================
+|                                multi_multiply                                |
+================================================================================
+
+DESCRIPTION
+
+     c = a b.  c may be the same as a or b.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_multiply( MultiInt * c, const MultiInt * a, const MultiInt * b )
+{
+MultiInt           t ;
+unsigned long long carry ;
+int                i, j ;
+
+t.size = a->size + b->size ;
+memset( t.limb, 0, (size_t) t.size * sizeof( t.limb[ 0 ] ) ) ;
+
+for (i = 0 ;  i < a->size ;  ++i)
+{
+    for (carry = 0, j = 0 ;  j < b->size ;  ++j)
+    {
+        carry += (unsigned long long) a->limb[ i ] * b->limb[ j ] + t.limb[ i + j ] ;
+        t.limb[ i + j ] = (unsigned int) carry ;
+        carry >>= 32 ;
+    }
+
+    t.limb[ i + b->size ] = (unsigned int) carry ;
+}
+
+multi_trim( &t ) ;
+multi_copy( c, &t ) ;
+
+} /* =================== end of function multi_multiply ====================== */
+
+
+
+/*==============================================================================
+|                                 multi_divide                                 |
+================================================================================
+
+DESCRIPTION
+
+     Divide a by b > 0 to get a quotient and a remainder.
+
+INPUT
+
+     a, b (const MultiInt *)
+
+OUTPUT
+
+     q   (MultiInt *)    a / b, or pass 0 if it isn't wanted.
+     rem (MultiInt *)    a mod b, or 0.  q and rem may be the same as a.
+
+METHOD
+
+     Knuth's Algorithm D as given in Warren, Hacker's Delight, Section 9-2.
+     Shift b left until its top bit is set, and a the same amount.  Then
+     each digit of the quotient is a guess from the top two limbs, off by
+     at most 2, which we correct.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_divide( MultiInt * q, MultiInt * rem, const MultiInt * a, const MultiInt * b )
+{
+MultiInt           u, v, quotient ;
+unsigned long long qhat, rhat, prod ;
+long long          t, k ;
+int                m, n, i, j, s ;
+
+n = b->size ;
+
+if (multi_compare( a, b ) < 0)
+{
+    if (rem != (MultiInt *) 0)
+        multi_copy( rem, a ) ;
+    if (q != (MultiInt *) 0)
+        q->size = 0 ;
+    return ;
+}
+
+if (n == 1)
+{
+    multi_copy( &u, a ) ;
+    multi_set( &v, (bigint) multi_divide_small( &u, b->limb[ 0 ] ) ) ;
+    if (q != (MultiInt *) 0)
+        multi_copy( q, &u ) ;
+    if (rem != (MultiInt *) 0)
+        multi_copy( rem, &v ) ;
+    return ;
+}
+
+m = a->size - n ;
+
+/*  Normalize. */
+for (s = 0 ;  !(b->limb[ n - 1 ] << s & 0x80000000U) ;  ++s)
+    ;
+
+for (i = n - 1 ;  i > 0 ;  --i)
+    v.limb[ i ] = (b->limb[ i ] << s) | (s ? b->limb[ i - 1 ] >> (32 - s) : 0) ;
+v.limb[ 0 ] = b->limb[ 0 ] << s ;
+
+u.limb[ a->size ] = s ? a->limb[ a->size - 1 ] >> (32 - s) : 0 ;
+for (i = a->size - 1 ;  i > 0 ;  --i)
+    u.limb[ i ] = (a->limb[ i ] << s) | (s ? a->limb[ i - 1 ] >> (32 - s) : 0) ;
+u.limb[ 0 ] = a->limb[ 0 ] << s ;
+
+for (j = m ;  j >= 0 ;  --j)
+{
+    prod = ((unsigned long long) u.limb[ j + n ] << 32) | u.limb[ j + n - 1 ] ;
+    qhat = prod / v.limb[ n - 1 ] ;
+    rhat = prod % v.limb[ n - 1 ] ;
+
+    while (qhat >> 32 != 0 ||
+           qhat * v.limb[ n - 2 ] > ((rhat << 32) | u.limb[ j + n - 2 ]))
+    {
+        --qhat ;
+        rhat += v.limb[ n - 1 ] ;
+        if (rhat >> 32 != 0)
+            break ;
+    }
+
+    /*  Multiply and subtract. */
+    for (k = 0, i = 0 ;  i < n ;  ++i)
+    {
+        prod = qhat * v.limb[ i ] ;
+        t    = (long long) u.limb[ i + j ] - k - (long long) (prod & 0xFFFFFFFFULL) ;
+        u.limb[ i + j ] = (unsigned int) t ;
+        k    = (long long) (prod >> 32) - (t >> 32) ;
+    }
+    t = (long long) u.limb[ j + n ] - k ;
+    u.limb[ j + n ] = (unsigned int) t ;
+
+    /*  Subtracted too much, so add back. */
+    if (t < 0)
+    {
+        --qhat ;
+        for (k = 0, i = 0 ;  i < n ;  ++i)
+        {
+            t = (long long) u.limb[ i + j ] + v.limb[ i ] + k ;
+            u.limb[ i + j ] = (unsigned int) t ;
+            k = t >> 32 ;
+        }
+        u.limb[ j + n ] += (unsigned int) k ;
+    }
+
+    quotient.limb[ j ] = (unsigned int) qhat ;
+}
+
+quotient.size = m + 1 ;
+multi_trim( &quotient ) ;
+
+/*  Unnormalize the remainder. */
+for (i = 0 ;  i < n ;  ++i)
+    u.limb[ i ] = (u.limb[ i ] >> s) | (s ? u.limb[ i + 1 ] << (32 - s) : 0) ;
+u.size = n ;
+multi_trim( &u ) ;
+
+if (q != (MultiInt *) 0)
+    multi_copy( q, &quotient ) ;
+if (rem != (MultiInt *) 0)
+    multi_copy( rem, &u ) ;
+
+} /* ==================== end of function multi_divide ======================= */
+
+
+
+/*==============================================================================
+|                           multi_subtract, multi_gcd                          |
+================================================================================
+
+DESCRIPTION
+
+     a - b in place for a >= b, and the greatest common divisor g of a
+     and b.
+
+METHOD
+
+     Euclid's algorithm for the gcd.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_subtract( MultiInt * a, const MultiInt * b )
+{
+long long borrow = 0, t ;
+int       i ;
+
+for (i = 0 ;  i < a->size ;  ++i)
+{
+    t            = (long long) a->limb[ i ] - (i < b->size ? (long long) b->limb[ i ] : 0) - borrow ;
+    a->limb[ i ] = (unsigned int) t ;
+    borrow       = (t < 0) ? 1 : 0 ;
+}
+
+multi_trim( a ) ;
+
+} /* ==================== end of function multi_subtract ===================== */
+
+
+void multi_gcd( MultiInt * g, const MultiInt * a, const MultiInt * b )
+{
+MultiInt u, v ;
+
+multi_copy( &u, a ) ;
+multi_copy( &v, b ) ;
+
+while (v.size != 0)
+{
+    multi_divide( (MultiInt *) 0, &u, &u, &v ) ;
+    multi_copy( g, &u ) ;
+    multi_copy( &u, &v ) ;
+    multi_copy( &v, g ) ;
+}
+
+multi_copy( g, &u ) ;
+
+} /* ======================= end of function multi_gcd ======================= */
+
+
+
+/*==============================================================================
+|                          multi_num_bits, multi_bit                           |
+================================================================================
+
+DESCRIPTION
+
+     The number of bits in a, not counting leading zeros, and bit k of a.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int multi_num_bits( const MultiInt * a )
+{
+unsigned int top ;
+int          bits ;
+
+if (a->size == 0)
+    return 0 ;
+
+for (top = a->limb[ a->size - 1 ], bits = 32 * (a->size - 1) ;  top != 0 ;  top >>= 1)
+    ++bits ;
+
+return bits ;
+
+} /* ==================== end of function multi_num_bits ===================== */
+
+
+int multi_bit( const MultiInt * a, int k )
+{
+if (k < 0 || k / 32 >= a->size)
+    return 0 ;
+
+return (int) ((a->limb[ k / 32 ] >> (k % 32)) & 1) ;
+
+} /* ======================= end of function multi_bit ======================= */
+
+
+
+/*==============================================================================
+|                                multi_is_prime                                |
+================================================================================
+
+DESCRIPTION
+
+     Test whether a MultiInt is prime.
+
+RETURNS
+
+     YES if a is prime, or for large a, almost surely prime;  NO if it
+     isn't.
+
+METHOD
+
+     If it fits in a bigint, leave it to is_bigint_prime.  Otherwise try
+     small divisors, then the Miller-Rabin test to MULTIPRIMETRIALS prime
+     bases, as in is_bigint_prime.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int multi_is_prime( const MultiInt * a )
+{
+static const unsigned int base[ NUM_PRIME_TEST_TRIALS ] =
+{
+     2,  3,  5,  7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
+    43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97
+} ;
+
+MultiInt q, y, b, one, minus_one, t ;
+bigint   x ;
+int      i, j, k ;
+
+if (multi_to_bigint( a, &x ))
+    return is_bigint_prime( x ) ;
+
+for (i = 0 ;  i < NUM_PRIME_TEST_TRIALS ;  ++i)
+{
+    multi_copy( &t, a ) ;
+    if (multi_divide_small( &t, base[ i ] ) == 0)
+        return NO ;
+}
+
+/* Factor out powers of 2 to get a = 1 + 2^k q, q odd. */
+multi_copy( &minus_one, a ) ;
+multi_subtract_small( &minus_one, 1 ) ;
+
+for (k = 0 ;  !multi_bit( &minus_one, k ) ;  ++k)
+    ;
+
+multi_copy( &q, &minus_one ) ;
+for (j = 0 ;  j < k ;  ++j)
+    multi_divide_small( &q, 2 ) ;
+
+multi_set( &one, 1 ) ;
+
+for (i = 0 ;  i < MULTIPRIMETRIALS ;  ++i)
+{
+    multi_set( &b, (bigint) base[ i ] ) ;
+    multi_power_mod( &y, &b, &q, a ) ;
+
+    for (j = 1 ;  j < k && multi_compare( &y, &one ) != 0 &&
+                  multi_compare( &y, &minus_one ) != 0 ;  ++j)
+    {
+        multi_multiply( &y, &y, &y ) ;
+        multi_divide( (MultiInt *) 0, &y, &y, a ) ;
+    }
+
+    /* Neither x^q = 1 nor x^(2^j q) = -1 for some j < k. */
+    if (multi_compare( &y, &minus_one ) != 0 &&
+        !(j == 1 && multi_compare( &y, &one ) == 0))
+        return NO ;
+}
+
+return YES ;
+
+} /* ==================== end of function multi_is_prime ===================== */
+
+
+
+/*==============================================================================
+|                           multi_is_mersenne_prime                            |
+================================================================================
+
+DESCRIPTION
+                        n
+     Test whether M = 2  - 1 is prime.
+
+INPUT
+
+     n (int)    An odd prime.
+
+RETURNS
+
+     YES if M is prime, NO if not.  Unlike multi_is_prime, this is a proof.
+
+METHOD
+
+     The Lucas-Lehmer test:  let s = 4 and repeat s = s^2 - 2 (mod M)
+     n - 2 times.  M is prime exactly when s ends up 0.  Reducing modulo M
+     is a shift and an add, since 2^n = 1 (mod M).
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int multi_is_mersenne_prime( int n )
+{
+MultiInt s, m ;
+int      i ;
+
+multi_power( &m, 2, n ) ;
+multi_subtract_small( &m, 1 ) ;
+
+multi_set( &s, 4 ) ;
+
+for (i = 1 ;  i <= n - 2 ;  ++i)
+{
+    multi_multiply( &s, &s, &s ) ;
+    mersenne_reduce( &s, n ) ;
+
+    if (multi_compare( &s, &m ) == 0)
+        s.size = 0 ;
+
+    if (s.size == 0 || (s.size == 1 && s.limb[ 0 ] < 2))
+    {
+        /*  s = 0 or 1, so s - 2 = M - 2 or M - 1. */
+        unsigned int small = (s.size == 0) ? 0 : s.limb[ 0 ] ;
+
+        multi_copy( &s, &m ) ;
+        multi_subtract_small( &s, 2 - small ) ;
+    }
+    else
+        multi_subtract_small( &s, 2 ) ;
+}
+
+return (s.size == 0) ? YES : NO ;
+
+} /* ================ end of function multi_is_mersenne_prime ================= */
+
+
+
+/*==============================================================================
+|                     multi_to_string, multi_from_string                       |
+================================================================================
+
+DESCRIPTION
+
+     Convert between a MultiInt and its decimal digits.
+
+INPUT/OUTPUT
+
+     s (char *)    Room for MULTIINTDIGITS characters for multi_to_string.
+                   Only digits for multi_from_string.
+
+RETURNS
+
+     multi_from_string returns YES if s was a number which fits, NO if not.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_to_string( const MultiInt * a, char * s )
+{
+unsigned int chunk[ 2 * MULTIINTLIMBS ] ;
+MultiInt     t ;
+int          num_chunks = 0, i ;
+
+multi_copy( &t, a ) ;
+
+do {
+    chunk[ num_chunks++ ] = multi_divide_small( &t, 1000000000U ) ;
+} while (t.size != 0) ;
+
+s += sprintf( s, "%u", chunk[ num_chunks - 1 ] ) ;
+
+for (i = num_chunks - 2 ;  i >= 0 ;  --i)
+    s += sprintf( s, "%09u", chunk[ i ] ) ;
+
+} /* =================== end of function multi_to_string ===================== */
+
+
+int multi_from_string( MultiInt * a, const char * s )
+{
+if (*s == '\0')
+    return NO ;
+
+for (a->size = 0 ;  *s != '\0' ;  ++s)
+{
+    if (*s < '0' || *s > '9' || a->size >= MULTIINTLIMBS - 1)
+        return NO ;
+
+    multi_multiply_small( a, 10 ) ;
+    multi_add_small( a, (unsigned int) (*s - '0') ) ;
+}
+
+return YES ;
+
+} /* ================== end of function multi_from_string ==================== */
+
+
+
+/*==============================================================================
+|                     multi_add_factor, multi_free_factors                     |
+================================================================================
+
+DESCRIPTION
+
+     Add a prime to a list of factors, keeping the primes in increasing
+     order, and free the list when done with it.
+
+INPUT
+
+     F (MultiFactors *)       The list so far.  Set it to all zeros to
+                              start.
+     q (const MultiInt *)     A prime ...
+     k (int)                  ... which divides the number k times.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void multi_add_factor( MultiFactors * F, const MultiInt * q, int k )
+{
+int i, j ;
+
+for (i = 0 ;  i < F->num_primes && multi_compare( &F->prime[ i ], q ) < 0 ;  ++i)
+    ;
+
+if (i < F->num_primes && multi_compare( &F->prime[ i ], q ) == 0)
+{
+    F->count[ i ] += k ;
+    return ;
+}
+
+if (F->num_primes == F->max_primes)
+{
+    F->max_primes = 2 * F->max_primes + 8 ;
+    F->prime = (MultiInt *) realloc( F->prime, (size_t) F->max_primes * sizeof( MultiInt ) ) ;
+    F->count = (int *)      realloc( F->count, (size_t) F->max_primes * sizeof( int ) ) ;
+
+    if (F->prime == (MultiInt *) 0 || F->count == (int *) 0)
+    {
+        printf( "ERROR:  Not enough memory for the factors of r.\n\n" ) ;
+        exit( 1 ) ;
+    }
+}
+
+for (j = F->num_primes ;  j > i ;  --j)
+{
+    multi_copy( &F->prime[ j ], &F->prime[ j - 1 ] ) ;
+    F->count[ j ] = F->count[ j - 1 ] ;
+}
+
+multi_copy( &F->prime[ i ], q ) ;
+F->count[ i ] = k ;
+++F->num_primes ;
+
+} /* =================== end of function multi_add_factor ==================== */
+
+
+void multi_free_factors( MultiFactors * F )
+{
+free( F->prime ) ;
+free( F->count ) ;
+memset( F, 0, sizeof( *F ) ) ;
+
+} /* ================== end of function multi_free_factors =================== */
+
+
+
+/*==============================================================================
+|                                  multi_trim                                  |
+================================================================================
+
+DESCRIPTION
+
+     Drop leading zero limbs.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void multi_trim( MultiInt * a )
+{
+while (a->size > 0 && a->limb[ a->size - 1 ] == 0)
+    --a->size ;
+
+} /* ====================== end of function multi_trim ====================== */
+
+
+
+/*==============================================================================
+|                               multi_power_mod                                |
+================================================================================
+
+DESCRIPTION
+              e
+     y = a  (mod m) by repeated squaring, from the top bit of e.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void multi_power_mod( MultiInt * y, const MultiInt * a, const MultiInt * e,
+                             const MultiInt * m )
+{
+int bit ;
+
+multi_set( y, 1 ) ;
+
+for (bit = multi_num_bits( e ) - 1 ;  bit >= 0 ;  --bit)
+{
+    multi_multiply( y, y, y ) ;
+    multi_divide( (MultiInt *) 0, y, y, m ) ;
+
+    if (multi_bit( e, bit ))
+    {
+        multi_multiply( y, y, a ) ;
+        multi_divide( (MultiInt *) 0, y, y, m ) ;
+    }
+}
+
+} /* =================== end of function multi_power_mod ===================== */
+
+
+
+/*==============================================================================
+|                               mersenne_reduce                                |
+================================================================================
+
+DESCRIPTION
+                       n                                 n
+     Reduce s modulo 2  - 1 by adding its bits above 2  to the bits below,
+     until it has n bits or fewer.  The result may still be 2^n - 1 itself.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void mersenne_reduce( MultiInt * s, int n )
+{
+MultiInt           high ;
+unsigned long long carry ;
+int                i, words = n / 32, shift = n % 32 ;
+
+while (multi_num_bits( s ) > n)
+{
+    /*  high = s >> n */
+    high.size = s->size - words ;
+    for (i = 0 ;  i < high.size ;  ++i)
+        high.limb[ i ] = (s->limb[ i + words ] >> shift) |
+                         ((shift && i + words + 1 < s->size) ? s->limb[ i + words + 1 ] << (32 - shift) : 0) ;
+    multi_trim( &high ) ;
+
+    /*  s = s mod 2^n */
+    s->size = words + (shift ? 1 : 0) ;
+    if (shift)
+        s->limb[ words ] &= (1U << shift) - 1 ;
+    multi_trim( s ) ;
+
+    /*  s = s + high */
+    for (carry = 0, i = 0 ;  i < high.size || carry != 0 ;  ++i)
+    {
+        if (i >= s->size)
+            s->limb[ s->size++ ] = 0 ;
+        carry       += (unsigned long long) s->limb[ i ] + (i < high.size ? high.limb[ i ] : 0) ;
+        s->limb[ i ] = (unsigned int) carry ;
+        carry      >>= 32 ;
+    }
+}
+
+} /* =================== end of function mersenne_reduce ===================== */
@@ -90,7 +90,8 @@ EXAMPLE
 
 METHOD
 
-    Exponentiate x with x_to_power and test the result with is_integer.
+    Exponentiate x with x_to_power, which also tells us if the result is
+    an integer.
     Return right away if the result is not an integer.
 
 BUGS
@@ -112,6 +113,7 @@ int
 
 int
     i,                  /*  Loop counter.  */
+    is_int,             /*  YES if g(x) is an integer.  */
     g[ MAXDEGPOLY ] ;   /* g(x) = x ^ m (mod f(x), p) */
 
 bigint
@@ -127,15 +129,15 @@ for (i = 0 ;  i <= prime_count ;  ++i)
     {
         m = r / primes[ i ] ;
 
-        x_to_power( m, g, power_table, n, p ) ;
+        is_int = x_to_power( m, g, power_table, n, p ) ;
 
         #ifdef DEBUG_PP_PRIMPOLY
-        printf( "    order m test for prime = %lld, x^ m = x ^ %lld = ", primes[i], m ) ;
+        printf( "    order m test for prime = %s, x^ m = x ^ %s = ", bigint_string( primes[i] ), bigint_string( m ) ) ;
         write_poly( g, n-1 ) ;
         printf( "\n\n" );
         #endif
 
-        if (is_integer( g, n-1 ))
+        if (is_int)
 
             return( NO ) ;
     }
@@ -195,16 +197,17 @@ int
 ------------------------------------------------------------------------------*/
 
 int
+    is_int,             /*  YES if g(x) is an integer.  */
     g[ MAXDEGPOLY ] ;   /* g(x) = x ^ m (mod f(x), p) */
 
 /*------------------------------------------------------------------------------
 |                                Function Body                                 |
 ------------------------------------------------------------------------------*/
 
-x_to_power( r, g, power_table, n, p ) ;
+is_int = x_to_power( r, g, power_table, n, p ) ;
  
 #ifdef DEBUG_PP_PRIMPOLY
-printf( "    order r test for x^r = x ^ %lld = ", r ) ;
+printf( "    order r test for x^r = x ^ %s = ", bigint_string( r ) ) ;
 write_poly( g, n-1 ) ;
 printf( "\n\n" );
 #endif
@@ -212,7 +215,7 @@ printf( "\n\n" );
 /*  Return the value a = constant term of g(x) */
 *a = g[ 0 ] ;
 
-return( is_integer( g, n-1 ) ? YES : NO  ) ;
+return( is_int ? YES : NO  ) ;
 
 } /* ====================== end of function order_r ========================= */
 
@@ -284,9 +287,7 @@ int maximal_order( int * f, int n, int p )
 
     for (k = 1 ;  k <= maxOrder ;  ++k)
     {
-        x_to_power( k, g, power_table, n, p ) ;
-
-        if (is_integer( g, n-1 ) &&
+        if (x_to_power( k, g, power_table, n, p ) &&
             g[0] == 1 &&
             k < maxOrder)
         {
@@ -0,0 +1,309 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppOutput.c
+|
+|  Description:
+|
+|     Buffered writing to standard output, for long listings.
+|
+|  Functions:
+|
+|     put_char
+|     put_string
+|     put_unsigned
+|     bigint_string
+|     put_poly
+|     flush_output
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Primpoly.h"
+
+
+/*  Output waiting to be written.  Anything printed to standard output
+    directly must call flush_output() first, so it comes out in order.
+    Only one thread may write at a time. */
+static char   output_buffer[ OUTPUTBUFFERSIZE ] ;
+static size_t output_used = 0 ;
+
+
+/*==============================================================================
+|                                  put_char                                    |
+================================================================================
+
+DESCRIPTION
+
+     Add one character to the output buffer, writing the buffer out when
+     it is full.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void put_char( char c )
+{
+if (output_used == OUTPUTBUFFERSIZE)
+    flush_output() ;
+
+output_buffer[ output_used++ ] = c ;
+
+} /* ===================== end of function put_char ========================= */
+
+
+
+/*==============================================================================
+|                                 put_string                                   |
+================================================================================
+
+DESCRIPTION
+
+     Add a string to the output buffer.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void put_string( const char * s )
+{
+size_t len = strlen( s ) ;
+
+if (output_used + len > OUTPUTBUFFERSIZE)
+{
+    flush_output() ;
+
+    /* Too big to buffer at all. */
+    if (len > OUTPUTBUFFERSIZE)
+    {
+        fwrite( s, 1, len, stdout ) ;
+        return ;
+    }
+}
+
+memcpy( output_buffer + output_used, s, len ) ;
+output_used += len ;
+
+} /* ==================== end of function put_string ======================== */
+
+
+
+/*==============================================================================
+|                                put_unsigned                                  |
+================================================================================
+
+DESCRIPTION
+
+     Add a number to the output buffer in decimal.
+
+INPUT
+
+     x (bigint)     The number.
+
+EXAMPLE
+
+     put_unsigned( 1234 ) adds the characters 1234, just like printf( "%llu" ).
+
+METHOD
+
+     Peel off digits from the right into a scratch array, then copy them
+     out in the right order.  Much faster than printf, which has to parse
+     its format string every time.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void put_unsigned( bigint x )
+{
+char digits[ 3 * sizeof( bigint ) + 1 ] ;
+int  num_digits = 0 ;
+
+do {
+    digits[ num_digits++ ] = (char) ('0' + x % 10) ;
+    x /= 10 ;
+} while (x != 0) ;
+
+while (num_digits > 0)
+    put_char( digits[ --num_digits ] ) ;
+
+} /* =================== end of function put_unsigned ======================= */
+
+
+
+/*==============================================================================
+|                                bigint_string                                 |
+================================================================================
+
+DESCRIPTION
+
+     A number in decimal, for printf( "%s" ).  Unlike bigintOutputFormat,
+     it works for every width of bigint, including the 128-bit one.
+
+INPUT
+
+     x (bigint)     The number.
+
+RETURNS
+
+     The digits.  They are in one of NUMBIGINTSTRINGS buffers of this
+     thread's, used in turn, so that many calls may go into one printf.
+
+EXAMPLE
+
+     printf( "r = %s\n", bigint_string( r ) ) ;
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+const char * bigint_string( bigint x )
+{
+static _Thread_local char buffer[ NUMBIGINTSTRINGS ][ 3 * sizeof( bigint ) + 1 ] ;
+static _Thread_local int  next = 0 ;
+
+char * s = buffer[ next ] + sizeof( buffer[ 0 ] ) - 1 ;
+
+next = (next + 1) % NUMBIGINTSTRINGS ;
+
+*s = '\0' ;
+do {
+    *--s = (char) ('0' + x % 10) ;
+    x /= 10 ;
+} while (x != 0) ;
+
+return s ;
+
+} /* =================== end of function bigint_string ====================== */
+
+
+
+/*==============================================================================
+|                                  put_poly                                    |
+================================================================================
+
+DESCRIPTION
+
+     Add a polynomial to the output buffer in the format of write_poly.
+
+INPUT
+
+     a[]  (int *)  Coefficients of the nth degree polynomial.
+     n    (int)    The polynomial's degree.
+
+EXAMPLE
+
+     For a(x) = x^3 + 2x + 1, adds
+
+     x ^ 3  +  2 x  + 1
+
+METHOD
+
+     Omit terms with coefficients of zero.  Suppress coefficients of 1, but
+     not the constant term.  Put every NUMTERMSPERLINE terms in the
+     polynomial on a new line.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void put_poly( int * a, int n )
+{
+int
+    k,                         /*  Loop conter. */
+    coeff,                     /*  Coefficient a sub k.  */
+    first_time_through = YES,  /* = NO after printing the first coefficient. */
+    num_terms = 0 ;            /*  Number of terms printed so far.  */
+
+for (k = n ;  k >= 0 ;  --k)
+{
+    if ( (coeff = a[ k ]) != 0)
+    {
+        /* Separate the terms with plus signs. */
+        if (!first_time_through)
+            put_string( " + " ) ;
+
+        first_time_through = NO ;
+
+        /* Always print the constant term, but other coefficients only
+           if they are not 1. */
+        if ( (coeff != 1) || (k == 0) )
+            put_unsigned( (bigint) coeff ) ;
+
+        /*  Print x, not x ^ 1, and omit x ^ 0. */
+        if (k > 1)
+        {
+            put_string( " x ^ " ) ;
+            put_unsigned( (bigint) k ) ;
+        }
+        else if (k == 1)
+            put_string( " x" ) ;
+
+        /*  Start a new line. */
+        if (++num_terms % NUMTERMSPERLINE == 0)
+            put_char( '\n' ) ;
+    }
+}
+
+put_char( '\n' ) ;
+
+} /* ===================== end of function put_poly ========================= */
+
+
+
+/*==============================================================================
+|                                flush_output                                  |
+================================================================================
+
+DESCRIPTION
+
+     Write out everything in the output buffer.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void flush_output( void )
+{
+if (output_used > 0)
+    fwrite( output_buffer, 1, output_used, stdout ) ;
+
+output_used = 0 ;
+
+} /* =================== end of function flush_output ======================= */
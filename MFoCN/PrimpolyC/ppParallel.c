@@ -0,0 +1,537 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppParallel.c
+|
+|  Description:
+|
+|     Search for primitive polynomials using several threads.
+|
+|  Functions:
+|
+|     search_parallel
+|     search_worker
+|     test_chunk
+|     retire_chunks
+|     cancel_chunks_above
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+/*  A run of NUMPOLYPERCHUNK consecutive trial polynomials and what we
+    learned from testing them.
+*/
+typedef struct
+{
+    int              done ;      /* YES once a thread has tested the chunk.   */
+    SearchStatistics stats ;     /* Counts for this chunk alone.              */
+    int *            hits ;      /* Primitive polynomials found, n+1
+                                    coefficients apiece.                      */
+    int              num_hits ;  /* How many are stored in hits.              */
+    int              max_hits ;  /* How many hits has room for.               */
+    atomic_int       cancelled ; /* Set to YES to make the thread testing
+                                    the chunk give up on it.                  */
+} Chunk ;
+
+
+/*  Everything the threads share.  Fields below the lock are only touched
+    while holding it.
+*/
+typedef struct
+{
+    int      n ;                 /* Degree of the polynomials.                */
+    int      p ;                 /* Modulus of the coefficient arithmetic.    */
+    bigint   r ;                 /* (p^n - 1) / (p - 1)                       */
+    bigint * primes ;            /* Distinct prime factors of r.              */
+    int      prime_count ;       /* ... stored in locations 0 to prime_count. */
+    bigint   num_candidates ;    /* Number of trial polynomials in all.       */
+    bigint   num_chunks ;        /* Number of chunks they are split into.     */
+    bigint   num_prim_poly ;     /* Total number of primitive polynomials.    */
+    int      list_all ;          /* YES to list all primitive polynomials,
+                                    NO to stop at the first one.              */
+    int *    first_found ;       /* The first primitive polynomial.           */
+    int      window ;            /* Size of the chunks[] ring.                */
+    Chunk *  chunks ;            /* Chunk c lives in chunks[ c % window ].    */
+
+    pthread_mutex_t    lock ;
+    pthread_cond_t     chunk_retired ;
+    bigint             next_chunk ;      /* Next chunk to hand out.           */
+    bigint             oldest_chunk ;    /* Oldest chunk not yet retired.     */
+    bigint             prim_poly_count ; /* Primitive polynomials printed.    */
+    bigint             first_hit_chunk ; /* Lowest chunk with a primitive
+                                            polynomial seen so far.           */
+    int                finished ;        /* YES when no more chunks are needed.*/
+    SearchStatistics * stats ;           /* Totals over retired chunks.       */
+} ParallelSearch ;
+
+
+static void * search_worker( void * arg ) ;
+static void   test_chunk   ( ParallelSearch * search, bigint c, Chunk * chunk ) ;
+static void   retire_chunks( ParallelSearch * search ) ;
+static void   cancel_chunks_above( ParallelSearch * search, bigint c ) ;
+
+
+/*==============================================================================
+|                               search_parallel                                |
+================================================================================
+
+DESCRIPTION
+
+     Search for primitive polynomials of degree n modulo p using several
+     threads.  Either list all of them, or find the first one.  The output,
+     the polynomial found and the statistics are the same as for the serial
+     search loop in main.
+
+INPUT
+
+     n           (int, n >= 2)     Degree of the polynomials.
+     p           (int, p >= 2)     Modulo p coefficient arithmetic.
+     r           (bigint)          (p^n - 1) / (p - 1)
+     primes      (bigint *)        Distinct prime factors of r.
+     prime_count (int)             Primes are in locations 0 to prime_count.
+     num_prim_poly (bigint)        Total number of primitive polynomials.
+     num_threads (int, >= 1)       How many threads to use.
+     list_all    (int)             YES to list all primitive polynomials,
+                                   NO to stop at the first one.
+
+OUTPUT
+
+     f     (int *)                 When list_all is NO, the first primitive
+                                   polynomial in the order of
+                                   next_trial_poly.  Untouched otherwise.
+
+     stats (SearchStatistics *)    Counts for each test, summed over the
+                                   trial polynomials the serial search
+                                   would have tested.
+
+     Standard output               When list_all is YES, each primitive
+                                   polynomial in the same order as the
+                                   serial search.
+
+RETURNS
+
+     The number of primitive polynomials found:  0 or 1 when list_all is NO.
+
+EXAMPLE
+
+     search_parallel( 4, 2, 15, primes, 1, 2, 4, YES, f, &stats ) lists the
+                                        4              4   3
+     two primitive polynomials of degree 4 modulo 2, x  + x + 1 and x  + x  + 1,
+     using 4 threads.
+
+METHOD
+
+     The trial polynomials are numbered 0, 1, ..., p^n in the order
+     next_trial_poly generates them and are cut into chunks of
+     NUMPOLYPERCHUNK.  Threads take the lowest numbered chunk nobody has
+     started yet, jump straight to its first polynomial with
+     unrank_trial_poly, and test every polynomial in it.  Handing out chunks
+     in order from a shared counter balances the load: a thread which
+     finishes early simply takes the next chunk.
+
+     Finished chunks can complete out of order.  They wait in a ring of
+     num_threads * NUMCHUNKSPERTHREAD slots until every older chunk is
+     done, then are retired in order:  their primitive polynomials are
+     printed and their counts are added to the totals.  A thread may not
+     start a chunk which would overrun the ring, which keeps memory bounded
+     no matter how long the search runs.
+
+     When looking for the first primitive polynomial, a chunk stops at its
+     first hit.  Every chunk above the lowest hit so far is cancelled and no
+     new ones are started, but chunks below it run to completion since one
+     of them may hold an earlier primitive polynomial.  The first chunk
+     retired with a hit has the answer, and the counts summed up to that
+     point are exactly the serial ones.
+
+     We test up to p^n + 1 polynomials, one more than there are, to match
+     the serial loop's count.  The extra one has a zero constant term and is
+     rejected right away.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint search_parallel( int n, int p, bigint r, bigint * primes, int prime_count,
+                        bigint num_prim_poly, int num_threads, int list_all,
+                        int * f, SearchStatistics * stats )
+{
+
+/*------------------------------------------------------------------------------
+|                               Local Variables                                |
+------------------------------------------------------------------------------*/
+
+ParallelSearch search ;
+
+pthread_t * threads ;
+
+int i ;
+
+/*------------------------------------------------------------------------------
+|                                Function Body                                 |
+------------------------------------------------------------------------------*/
+
+search.n              = n ;
+search.p              = p ;
+search.r              = r ;
+search.primes         = primes ;
+search.prime_count    = prime_count ;
+search.num_candidates = power( p, n ) + 1 ;
+search.num_chunks     = (search.num_candidates + NUMPOLYPERCHUNK - 1) / NUMPOLYPERCHUNK ;
+search.num_prim_poly  = num_prim_poly ;
+search.list_all       = list_all ;
+search.first_found    = f ;
+search.window         = num_threads * NUMCHUNKSPERTHREAD ;
+
+search.next_chunk      = 0 ;
+search.oldest_chunk    = 0 ;
+search.prim_poly_count = 0 ;
+search.first_hit_chunk = search.num_chunks ;
+search.finished        = NO ;
+search.stats           = stats ;
+
+search.chunks = (Chunk *) calloc( search.window, sizeof( Chunk ) ) ;
+threads       = (pthread_t *) calloc( num_threads, sizeof( pthread_t ) ) ;
+
+if (search.chunks == (Chunk *) 0 || threads == (pthread_t *) 0)
+{
+    printf( "ERROR:  Out of memory for %d threads.\n\n", num_threads ) ;
+    exit( 1 ) ;
+}
+
+pthread_mutex_init( &search.lock, NULL ) ;
+pthread_cond_init(  &search.chunk_retired, NULL ) ;
+
+for (i = 0 ;  i < num_threads ;  ++i)
+{
+    if (pthread_create( &threads[ i ], NULL, search_worker, &search ) != 0)
+    {
+        printf( "ERROR:  Cannot start thread %d.\n\n", i ) ;
+        exit( 1 ) ;
+    }
+}
+
+for (i = 0 ;  i < num_threads ;  ++i)
+    pthread_join( threads[ i ], NULL ) ;
+
+pthread_cond_destroy(  &search.chunk_retired ) ;
+pthread_mutex_destroy( &search.lock ) ;
+
+for (i = 0 ;  i < search.window ;  ++i)
+    free( search.chunks[ i ].hits ) ;
+
+free( search.chunks ) ;
+free( threads ) ;
+
+return search.prim_poly_count ;
+
+} /* =================== end of function search_parallel ==================== */
+
+
+
+/*==============================================================================
+|                                search_worker                                 |
+================================================================================
+
+DESCRIPTION
+
+     Thread body.  Keep taking the next chunk and testing it until there
+     are no more.
+
+INPUT
+
+     arg (void *)    The ParallelSearch shared by all threads.
+
+RETURNS
+
+     NULL
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void * search_worker( void * arg )
+{
+ParallelSearch * search = (ParallelSearch *) arg ;
+Chunk *          chunk ;
+bigint           c ;
+
+pthread_mutex_lock( &search->lock ) ;
+
+for (;;)
+{
+    /* Wait until the chunk we would take has a free slot in the ring. */
+    while (!search->finished &&
+           search->next_chunk <  search->num_chunks &&
+           search->next_chunk >= search->oldest_chunk + (bigint) search->window)
+        pthread_cond_wait( &search->chunk_retired, &search->lock ) ;
+
+    /* Quit when there is nothing left, or all that's left lies above a
+       primitive polynomial we've already found. */
+    if (search->finished ||
+        search->next_chunk >= search->num_chunks ||
+        search->next_chunk >  search->first_hit_chunk)
+        break ;
+
+    c     = search->next_chunk++ ;
+    chunk = &search->chunks[ c % (bigint) search->window ] ;
+    atomic_store( &chunk->cancelled, NO ) ;
+
+    pthread_mutex_unlock( &search->lock ) ;
+
+    test_chunk( search, c, chunk ) ;
+
+    pthread_mutex_lock( &search->lock ) ;
+
+    chunk->done = YES ;
+
+    if (!search->list_all && chunk->num_hits > 0 && c < search->first_hit_chunk)
+    {
+        search->first_hit_chunk = c ;
+        cancel_chunks_above( search, c ) ;
+    }
+
+    retire_chunks( search ) ;
+}
+
+pthread_mutex_unlock( &search->lock ) ;
+
+return NULL ;
+
+} /* =================== end of function search_worker ====================== */
+
+
+
+/*==============================================================================
+|                                  test_chunk                                  |
+================================================================================
+
+DESCRIPTION
+
+     Test every trial polynomial in chunk c, saving the primitive ones.
+     When we only want the first primitive polynomial, stop at the first
+     one, or as soon as the chunk is cancelled.
+
+INPUT
+
+     search (ParallelSearch *)  Search parameters.
+     c      (bigint)            Chunk number.
+
+OUTPUT
+
+     chunk  (Chunk *)           Statistics and primitive polynomials for
+                                chunk c.  The slot is ours alone until we
+                                mark it done.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void test_chunk( ParallelSearch * search, bigint c, Chunk * chunk )
+{
+int    n = search->n ;
+int    f[ MAXDEGPOLY + 1 ] ;
+bigint k, last ;
+
+memset( &chunk->stats, 0, sizeof( SearchStatistics ) ) ;
+chunk->num_hits = 0 ;
+
+k    = c * NUMPOLYPERCHUNK ;
+last = k + NUMPOLYPERCHUNK ;
+if (last > search->num_candidates)
+    last = search->num_candidates ;
+
+unrank_trial_poly( f, n, search->p, k ) ;
+
+for ( ;  k < last ;  ++k)
+{
+    if (atomic_load_explicit( &chunk->cancelled, memory_order_relaxed ))
+        break ;
+
+    ++chunk->stats.num_poly ;
+
+    if (passes_primitivity_tests( f, n, search->p, search->r, search->primes,
+                                  search->prime_count, &chunk->stats ))
+    {
+        if (chunk->num_hits == chunk->max_hits)
+        {
+            chunk->max_hits = (chunk->max_hits == 0) ? 16 : 2 * chunk->max_hits ;
+            chunk->hits = (int *) realloc( chunk->hits,
+                                  chunk->max_hits * (n + 1) * sizeof( int ) ) ;
+            if (chunk->hits == (int *) 0)
+            {
+                printf( "ERROR:  Out of memory for primitive polynomials.\n\n" ) ;
+                exit( 1 ) ;
+            }
+        }
+
+        memcpy( chunk->hits + chunk->num_hits++ * (n + 1), f,
+                (n + 1) * sizeof( int ) ) ;
+
+        if (!search->list_all)
+            break ;
+    }
+
+    next_trial_poly( f, n, search->p ) ;
+}
+
+} /* ===================== end of function test_chunk ======================= */
+
+
+
+/*==============================================================================
+|                                retire_chunks                                 |
+================================================================================
+
+DESCRIPTION
+
+     Print and tally the oldest finished chunks, in order, stopping at the
+     first chunk which is still being tested.  When we only want the first
+     primitive polynomial, the first retired chunk which has one ends the
+     search.  Called with the lock held.
+
+INPUT
+
+     search (ParallelSearch *)  Shared search state.
+
+OUTPUT
+
+     Standard output            Primitive polynomials from retired chunks.
+     Standard error             A progress report, if one is due.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void retire_chunks( ParallelSearch * search )
+{
+Chunk * chunk ;
+int     i ;
+int     retired_any = NO ;
+
+while (!search->finished && search->oldest_chunk < search->next_chunk)
+{
+    chunk = &search->chunks[ search->oldest_chunk % (bigint) search->window ] ;
+
+    if (!chunk->done)
+        break ;
+
+    add_statistics( search->stats, &chunk->stats ) ;
+
+    if (search->list_all)
+    {
+        for (i = 0 ;  i < chunk->num_hits ;  ++i)
+            write_listing_entry( chunk->hits + i * (search->n + 1), search->n,
+                                 search->p, ++search->prim_poly_count,
+                                 search->num_prim_poly ) ;
+    }
+    else if (chunk->num_hits > 0)
+    {
+        memcpy( search->first_found, chunk->hits,
+                (search->n + 1) * sizeof( int ) ) ;
+        search->prim_poly_count = 1 ;
+        search->finished = YES ;
+    }
+
+    chunk->done = NO ;
+    ++search->oldest_chunk ;
+    retired_any = YES ;
+}
+
+if (retired_any)
+{
+    pthread_cond_broadcast( &search->chunk_retired ) ;
+
+    if (progress_due())
+        report_progress( search->stats, search->stats->num_poly,
+                         search->prim_poly_count ) ;
+}
+
+} /* ==================== end of function retire_chunks ===================== */
+
+
+
+/*==============================================================================
+|                             cancel_chunks_above                              |
+================================================================================
+
+DESCRIPTION
+
+     Tell every thread testing a chunk numbered above c to give up on it.
+     Called with the lock held.
+
+INPUT
+
+     search (ParallelSearch *)  Shared search state.
+     c      (bigint)            Chunk holding the lowest primitive polynomial
+                                found so far.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void cancel_chunks_above( ParallelSearch * search, bigint c )
+{
+bigint k ;
+
+for (k = c + 1 ;  k < search->next_chunk ;  ++k)
+    atomic_store( &search->chunks[ k % (bigint) search->window ].cancelled, YES ) ;
+
+} /* ================= end of function cancel_chunks_above ================== */
@@ -20,6 +20,8 @@
 |     coeff_of_product
 |     square
 |     product
+|     multiply_poly
+|     karatsuba
 |     times_x
 |     x_to_power
 |
@@ -54,6 +56,10 @@
 #include "Primpoly.h"
 
 
+static void multiply_poly( int * c, int * a, int * b, int m, int p ) ;
+static void karatsuba    ( int * c, int * a, int * b, int m, int p ) ;
+
+
 /*==============================================================================
 |                                   eval_poly                                  |
 ================================================================================
@@ -938,8 +944,9 @@ METHOD
     Let t (x) = t    x     +  ... + t  x  +  t   x   +  ... + t .
                  2n-2                n        n-1              0
 
-    Compute the coefficients t  using the function coeff_of_square.
+    Compute the coefficients t  using multiply_poly, which calls
                               k
+    coeff_of_square for small n.
 
                                 2
     The next step is to reduce t (x) modulo f(x).  To do so, replace
@@ -969,22 +976,32 @@ void
 int 
     i, j,                     /* Loop counters. */
     coeff,                    /* Coefficient of x ^ k term of t(x) ^2 */
+    wide[ 2 * MAXDEGPOLY ],   /* t(x) ^ 2 before reduction. */
     temp[ MAXDEGPOLY + 1 ] ;  /* Temporary storage for the new t(x). */
 
 /*------------------------------------------------------------------------------
 |                                Function Body                                 |
 ------------------------------------------------------------------------------*/
 
+/*  Small fields do it a whole polynomial at a time. */
+if (swar_fits( n, p ))
+{
+    swar_square_poly( t, power_table, n, p ) ;
+    return ;
+}
+
+multiply_poly( wide, t, t, n, p ) ;
+
 /*
                                  0        n-1
-    Compute the coefficients of x , ..., x.   These terms do not require
+    Copy the coefficients of x , ..., x.   These terms do not require
 
     reduction mod f(x) because their degree is less than n.
 */
 
-for (i = 0 ;  i <= n ;  ++i)
+for (i = 0 ;  i <= n - 1 ;  ++i)
 
-    temp[ i ] = coeff_of_square( t, i, n, p ) ;
+    temp[ i ] = wide[ i ] ;
 
 /*
                                  n        2n-2             k
@@ -998,7 +1015,7 @@ for (i = 0 ;  i <= n ;  ++i)
 
 for (i = n ;  i <= 2 * n - 2 ;  ++i)
 
-    if ( (coeff = coeff_of_square( t, i, n, p )) != 0 )
+    if ( (coeff = wide[ i ]) != 0 )
 
         for (j = 0 ;  j <= n - 1 ;  ++j)
 
@@ -1059,7 +1076,8 @@ EXAMPLE
 
 METHOD
 
-    Compute the coefficients using the function coeff_of_product.
+    Compute the coefficients using multiply_poly, which calls
+    coeff_of_product for small n.
                                  
     The next step is to reduce s(x) t(x) modulo f(x) and p.  To do so, replace
 
@@ -1087,23 +1105,32 @@ product( int  * s, int * t, int power_table[][ MAXDEGPOLY ], int n, int p )
 
 int 
     i, j,                     /* Loop counters. */
-    coeff,                    /* Coefficient of x ^ k term of t(x) ^2 */
+    coeff,                    /* Coefficient of x ^ k term of s(x) t(x) */
+    wide[ 2 * MAXDEGPOLY ],   /* s(x) t(x) before reduction. */
     temp[ MAXDEGPOLY + 1 ] ;  /* Temporary storage for the new t(x). */
 
 /*------------------------------------------------------------------------------
 |                                Function Body                                 |
 ------------------------------------------------------------------------------*/
 
+if (swar_fits( n, p ))
+{
+    swar_product_poly( s, t, power_table, n, p ) ;
+    return ;
+}
+
+multiply_poly( wide, s, t, n, p ) ;
+
 /*
                                  0        n-1
-    Compute the coefficients of x , ..., x.   These terms do not require
+    Copy the coefficients of x , ..., x.   These terms do not require
 
     reduction mod f(x) because their degree is less than n.
 */
 
-for (i = 0 ;  i <= n ;  ++i)
+for (i = 0 ;  i <= n - 1 ;  ++i)
 
-    temp[ i ] = coeff_of_product( s, t, i, n, p ) ;
+    temp[ i ] = wide[ i ] ;
 
 /*
                                  n        2n-2             k
@@ -1117,7 +1144,7 @@ for (i = 0 ;  i <= n ;  ++i)
 
 for (i = n ;  i <= 2 * n - 2 ;  ++i)
 
-    if ( (coeff = coeff_of_product( s, t, i, n, p )) != 0 )
+    if ( (coeff = wide[ i ]) != 0 )
 
         for (j = 0 ;  j <= n - 1 ;  ++j)
 
@@ -1132,6 +1159,144 @@ for (i = 0 ;  i <= n - 1 ;  ++i)
 } /* ======================== end of function product ======================= */
 
 
+/*==============================================================================
+|                                multiply_poly                                 |
+================================================================================
+
+DESCRIPTION
+
+     Compute a( x ) b( x ) modulo p, without reducing modulo f( x ).
+
+INPUT
+
+    a, b (int *)           Coefficients of a(x) and b(x), of degree <= m-1.
+                           b == a for a square.
+
+    m (int, 1 <= m <= MAXDEGPOLY)
+
+    p (int, p > 0)         Mod p coefficient arithmetic.
+
+OUTPUT
+
+    c (int *)              The 2m-1 coefficients of a(x) b(x).  Not the
+                           same array as a or b.
+
+METHOD
+
+    Pick the method by the size of the polynomials:  Karatsuba from
+    KARATSUBACUTOFF coefficients up, and below that the coefficients one
+    at a time with coeff_of_product, or coeff_of_square for a square.
+    Karatsuba calls back here for its smaller products.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void 
+    multiply_poly( int * c, int * a, int * b, int m, int p )
+{
+int 
+    k ;            /* Power of x. */
+
+if (m >= KARATSUBACUTOFF)
+
+    karatsuba( c, a, b, m, p ) ;
+
+else if (a == b)
+
+    for (k = 0 ;  k <= 2 * m - 2 ;  ++k)
+        c[ k ] = coeff_of_square( a, k, m, p ) ;
+
+else
+
+    for (k = 0 ;  k <= 2 * m - 2 ;  ++k)
+        c[ k ] = coeff_of_product( a, b, k, m, p ) ;
+
+} /* ==================== end of function multiply_poly ===================== */
+
+
+/*==============================================================================
+|                                  karatsuba                                   |
+================================================================================
+
+DESCRIPTION
+
+     a( x ) b( x ) modulo p by Karatsuba's method.  Arguments as for
+     multiply_poly.
+
+METHOD
+                                  h                         h
+    Split a(x) = a (x) + a (x) x   and  b(x) = b (x) + b (x) x,  with h
+                  0       1                     0       1
+
+    the larger half of m.  Then
+                                                          h            2h
+    a(x) b(x) = z  + [ (a  + a )(b  + b ) - z  - z  ] x   +  z  x
+                 0       0    1   0    1     0    2           2
+
+    with z  = a  b  and z  = a  b , so three half size products in place
+          0    0  0      2    1  1
+
+    of four.  For a square, a  + a  and b  + b  are the same polynomial,
+                             0    1      0    1
+    so the three products are squares too.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void 
+    karatsuba( int * c, int * a, int * b, int m, int p )
+{
+int 
+    h = (m + 1) / 2,                  /* Size of the halves.            */
+    i,                                /* Loop counter.                  */
+    a1[ MAXDEGPOLY ],                 /* High half of a(x), padded ...  */
+    b1[ MAXDEGPOLY ],                 /* ... and of b(x).               */
+    a01[ MAXDEGPOLY ],                /* a0(x) + a1(x) ...              */
+    b01[ MAXDEGPOLY ],                /* ... and b0(x) + b1(x).         */
+    z0[ 2 * MAXDEGPOLY ],             /* a0 b0, ...                     */
+    z1[ 2 * MAXDEGPOLY ],             /* (a0 + a1)(b0 + b1), ...        */
+    z2[ 2 * MAXDEGPOLY ] ;            /* ... and a1 b1.                 */
+
+for (i = 0 ;  i <= h - 1 ;  ++i)
+{
+    a1[ i ]  = (h + i <= m - 1) ? a[ h + i ] : 0 ;
+    b1[ i ]  = (h + i <= m - 1) ? b[ h + i ] : 0 ;
+    a01[ i ] = mod( a[ i ] + a1[ i ], p ) ;
+    b01[ i ] = mod( b[ i ] + b1[ i ], p ) ;
+}
+
+if (a == b)
+{
+    multiply_poly( z0, a,   a,   h, p ) ;
+    multiply_poly( z1, a01, a01, h, p ) ;
+    multiply_poly( z2, a1,  a1,  h, p ) ;
+}
+else
+{
+    multiply_poly( z0, a,   b,   h, p ) ;
+    multiply_poly( z1, a01, b01, h, p ) ;
+    multiply_poly( z2, a1,  b1,  h, p ) ;
+}
+
+for (i = 0 ;  i <= 2 * m - 2 ;  ++i)
+    c[ i ] = 0 ;
+
+for (i = 0 ;  i <= 2 * h - 2 ;  ++i)
+{
+    c[ i ] = mod( c[ i ] + z0[ i ], p ) ;
+
+    c[ h + i ] = mod( c[ h + i ] + z1[ i ] - z0[ i ] - z2[ i ], p ) ;
+
+    /*  The padding makes the top of z2 zero past the end of c. */
+    if (2 * h + i <= 2 * m - 2)
+        c[ 2 * h + i ] = mod( c[ 2 * h + i ] + z2[ i ], p ) ;
+}
+
+} /* ====================== end of function karatsuba ======================= */
+
+
 /*==============================================================================
 |                                  times_x                                     |
 ================================================================================
@@ -1201,6 +1366,12 @@ int
 |                                Function Body                                 |
 ------------------------------------------------------------------------------*/
 
+if (swar_fits( n, p ))
+{
+    swar_times_x_poly( t, power_table, n, p ) ;
+    return ;
+}
+
 /*
     Multiply t(x) by x.  Do it by shifting the coefficients left in the array.
 */
@@ -1255,6 +1426,11 @@ OUTPUT
 
     g (int *)     Polynomial of degree <= n-1.
 
+RETURNS
+
+    YES if g(x) is an integer, as is_integer( g, n-1 ) would say.  For
+    small fields this comes from the packed word, without looking at g.
+
 EXAMPLE 
                               4   2 
     Let n = 4, p = 5, f(x) = x + x + 2 x + 3, and m = 156.
@@ -1366,7 +1542,7 @@ BUGS
 |                                Function Call                                 |
 ------------------------------------------------------------------------------*/
 
-void 
+int
     x_to_power( bigint m, int * g, int power_table[][ MAXDEGPOLY ], int n, int p )
 {
 
@@ -1386,17 +1562,32 @@ bigint
 
 int 
     bit_count = 0,  /* Number of bits in m to the right of the leading bit. */
+    is_int,         /* YES if the answer is an integer. */
     i ;             /* Loop counter. */
 
+TRACE_DECLARE( trace_start ) ;
+
 
 /*------------------------------------------------------------------------------
 |                                Function Body                                 |
 ------------------------------------------------------------------------------*/
 
 #ifdef DEBUG_PP_PRIMPOLY
-printf( "x to power = x ^ %lld\n", m ) ;
+printf( "x to power = x ^ %s\n", bigint_string( m ) ) ;
 #endif
 
+TRACE_BEGIN( trace_start ) ;
+
+/*
+    Small fields have their own arithmetic, a whole polynomial at a time.
+*/
+if (swar_fits( n, p ))
+{
+    is_int = swar_x_to_power( m, g, power_table, n, p ) ;
+    TRACE_END( "x_to_power", trace_start ) ;
+    return is_int ;
+}
+
 /*
     Initialize g(x) to x.  Exit right away if m = 1.
 */
@@ -1408,8 +1599,10 @@ for (i = 0 ;  i <= n-1 ;  ++i)
 g[ 1 ] = 1 ;
 
 if (m == 1)
-
-    return ;
+{
+    TRACE_END( "x_to_power", trace_start ) ;
+    return is_integer( g, n-1 ) ;
+}
 
 /*
     Advance the leading bit of m up to the word's left hand boundary.
@@ -1457,4 +1650,8 @@ while ( --bit_count > 0 )
     }
 }
 
+TRACE_END( "x_to_power", trace_start ) ;
+
+return is_integer( g, n-1 ) ;
+
 } /* ===================== end of function x_to_power ======================= */
@@ -0,0 +1,333 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppProgress.c
+|
+|  Description:
+|
+|     Report how far along a long search is, every so often or when asked
+|     with a signal.
+|
+|  Functions:
+|
+|     start_progress
+|     stop_progress
+|     progress_due
+|     report_progress
+|     progress_signal
+|     print_duration
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  USE
+|
+|     With --progress, a line goes to standard error every PROGRESSSECONDS.
+|     At any time during a search,
+|
+|         kill -USR1 <pid>
+|
+|     prints the same line and the counts so far for each stage.  Standard
+|     output is left alone for the listing.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+/*  Set by the signal handler, cleared by report_progress. */
+static volatile sig_atomic_t progress_timer_rang = 0 ;
+static volatile sig_atomic_t progress_dump_asked = 0 ;
+
+/*  Set by start_progress before the search, then only read. */
+static int    progress_on       = NO ;   /* Timer running?                   */
+static int    progress_list_all = NO ;   /* Will the search test them all?   */
+static bigint progress_total    = 0 ;    /* Trial polynomials in all.        */
+static bigint progress_done_at_start = 0 ;  /* Tested before this run.       */
+static bigint progress_start    = 0 ;    /* stage_clock() at the start.      */
+
+static void progress_signal( int sig ) ;
+static void print_duration ( bigint seconds ) ;
+
+
+/*==============================================================================
+|                                start_progress                                |
+================================================================================
+
+DESCRIPTION
+
+     Get ready to report on a search:  catch SIGUSR1, and with --progress
+     start a timer which goes off every PROGRESSSECONDS.
+
+INPUT
+
+     show_progress (int)     YES to report on a timer, NO for only on SIGUSR1.
+     list_all      (int)     YES if the search goes through all the trial
+                             polynomials, so we can tell how long it has left.
+     total         (bigint)  How many trial polynomials there are.
+     done          (bigint)  How many were tested already, when resuming
+                             from a checkpoint.
+
+METHOD
+
+     The handler only sets a flag.  The search loop looks at it with
+     progress_due() and does the printing itself, so the handler needn't
+     be safe against whatever the loop was doing.  SA_RESTART keeps the
+     signals from breaking off a write of the listing.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void start_progress( int show_progress, int list_all, bigint total, bigint done )
+{
+struct sigaction action ;
+struct itimerval timer ;
+
+progress_list_all      = list_all ;
+progress_total         = total ;
+progress_done_at_start = done ;
+progress_start         = stage_clock() ;
+
+memset( &action, 0, sizeof( action ) ) ;
+action.sa_handler = progress_signal ;
+action.sa_flags   = SA_RESTART ;
+sigemptyset( &action.sa_mask ) ;
+
+sigaction( SIGUSR1, &action, (struct sigaction *) 0 ) ;
+
+if (show_progress)
+{
+    sigaction( SIGALRM, &action, (struct sigaction *) 0 ) ;
+
+    timer.it_interval.tv_sec  = PROGRESSSECONDS ;
+    timer.it_interval.tv_usec = 0 ;
+    timer.it_value            = timer.it_interval ;
+
+    progress_on = (setitimer( ITIMER_REAL, &timer, (struct itimerval *) 0 ) == 0) ;
+}
+
+} /* =================== end of function start_progress ===================== */
+
+
+
+/*==============================================================================
+|                                stop_progress                                 |
+================================================================================
+
+DESCRIPTION
+
+     Stop the timer at the end of the search.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void stop_progress( void )
+{
+struct itimerval timer ;
+
+if (progress_on)
+{
+    memset( &timer, 0, sizeof( timer ) ) ;
+    setitimer( ITIMER_REAL, &timer, (struct itimerval *) 0 ) ;
+    progress_on = NO ;
+}
+
+} /* ==================== end of function stop_progress ===================== */
+
+
+
+/*==============================================================================
+|                                progress_due                                  |
+================================================================================
+
+DESCRIPTION
+
+     Has the timer gone off, or did someone send SIGUSR1, since the last
+     report?
+
+RETURNS
+
+     YES or NO.
+
+EXAMPLE
+
+     if (stats.num_poly % NUMPOLYPERCLOCKCHECK == 0 && progress_due())
+         report_progress( &stats, stats.num_poly, prim_poly_count ) ;
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int progress_due( void )
+{
+return progress_timer_rang || progress_dump_asked ;
+
+} /* ==================== end of function progress_due ====================== */
+
+
+
+/*==============================================================================
+|                               report_progress                                |
+================================================================================
+
+DESCRIPTION
+
+     Print how far the search has got to standard error.  After SIGUSR1,
+     also print the counts for each stage so far.
+
+INPUT
+
+     stats (SearchStatistics *)  Counts so far.
+     done  (bigint)              Trial polynomials tested so far.
+     hits  (bigint)              Primitive polynomials found so far.
+
+EXAMPLE
+
+     Progress:  12.50% of 1048577, 523412 per second, 6241 primitive, 0:00:20 elapsed, about 0:02:20 left
+
+METHOD
+
+     The rate is over the whole of this run, which evens out the slow
+     stretches and the fast ones.  Without -a the search stops at the first
+     primitive polynomial, usually long before the end, so we don't guess
+     how long it has left.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void report_progress( SearchStatistics * stats, bigint done, bigint hits )
+{
+bigint elapsed = stage_clock() - progress_start ;
+double rate    = 0.0 ;
+int    stage ;
+
+if (elapsed > 0)
+    rate = (double) (done - progress_done_at_start) * 1.0e9 / (double) elapsed ;
+
+fprintf( stderr, "Progress:  %.2f%% of %s, %.0f per second, %s primitive, ",
+         (progress_total > 0) ? 100.0 * (double) done / (double) progress_total : 0.0,
+         bigint_string( progress_total ), rate, bigint_string( hits ) ) ;
+
+print_duration( elapsed / 1000000000ULL ) ;
+fprintf( stderr, " elapsed" ) ;
+
+if (progress_list_all && rate > 0.0 && done < progress_total)
+{
+    fprintf( stderr, ", about " ) ;
+    print_duration( (bigint) ((double) (progress_total - done) / rate) ) ;
+    fprintf( stderr, " left" ) ;
+}
+
+fprintf( stderr, "\n" ) ;
+
+if (progress_dump_asked)
+{
+    fprintf( stderr, "| Actually tested :                       %10s\n", bigint_string( stats->num_poly ) ) ;
+    fprintf( stderr, "| Const. coeff. was primitive root :      %10s\n", bigint_string( stats->num_const_coeff_prim_root ) ) ;
+    fprintf( stderr, "| Free of linear factors :                %10s\n", bigint_string( stats->num_free_of_linear_factors ) ) ;
+    fprintf( stderr, "| Irreducible or irred. to power :        %10s\n", bigint_string( stats->num_irred_to_power ) ) ;
+    fprintf( stderr, "| Had order r (x^r = integer) :           %10s\n", bigint_string( stats->num_order_r ) ) ;
+    fprintf( stderr, "| Passed const. coeff. test :             %10s\n", bigint_string( stats->num_passing_const_coeff_test ) ) ;
+    fprintf( stderr, "| Had order m (x^m != integer) :          %10s\n", bigint_string( stats->num_order_m ) ) ;
+
+    if (stage_timing_enabled())
+    {
+        for (stage = 0 ;  stage < NUMSTAGES ;  ++stage)
+            fprintf( stderr, "| %-13s %12s calls %14.6f s\n",
+                     stage_timing_name( stage ), bigint_string( stats->stage_calls[ stage ] ),
+                     (double) stats->stage_nanosec[ stage ] / 1.0e9 ) ;
+    }
+
+    fflush( stderr ) ;
+}
+
+progress_timer_rang = 0 ;
+progress_dump_asked = 0 ;
+
+} /* =================== end of function report_progress ==================== */
+
+
+
+/*==============================================================================
+|                               progress_signal                                |
+================================================================================
+
+DESCRIPTION
+
+     Signal handler for SIGALRM and SIGUSR1.
+
+INPUT
+
+     sig (int)    Which signal.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void progress_signal( int sig )
+{
+if (sig == SIGUSR1)
+    progress_dump_asked = 1 ;
+else
+    progress_timer_rang = 1 ;
+
+} /* =================== end of function progress_signal ==================== */
+
+
+
+/*==============================================================================
+|                                print_duration                                |
+================================================================================
+
+DESCRIPTION
+
+     Print a number of seconds to standard error as h:mm:ss.
+
+INPUT
+
+     seconds (bigint)
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void print_duration( bigint seconds )
+{
+fprintf( stderr, "%s:%02d:%02d", bigint_string( seconds / 3600 ), (int) ((seconds / 60) % 60), (int) (seconds % 60) ) ;
+
+} /* ==================== end of function print_duration ===================== */
@@ -0,0 +1,360 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppReciprocal.c
+|
+|  Description:
+|
+|     List all primitive polynomials, testing only one polynomial of each
+|     reciprocal pair.
+|
+|  Functions:
+|
+|     list_all_by_reciprocal_pairs
+|     reciprocal_rank
+|     push_rank
+|     pop_rank
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+/*  Min-heap of the ranks of primitive polynomials we know about, but whose
+    turn in the listing hasn't come yet. */
+typedef struct
+{
+    bigint * rank ;
+    bigint   size ;
+    bigint   capacity ;
+} RankHeap ;
+
+
+static bigint reciprocal_rank( int * f, int n, int p ) ;
+static void   push_rank      ( RankHeap * heap, bigint rank ) ;
+static bigint pop_rank       ( RankHeap * heap ) ;
+
+
+/*==============================================================================
+|                        list_all_by_reciprocal_pairs                          |
+================================================================================
+
+DESCRIPTION
+
+     List all primitive polynomials of degree n modulo p in the same order,
+     and with the same statistics, as the search loop in main, but test only
+     about half of them.
+
+INPUT
+
+     f             (int *)       Initial trial polynomial from initial_trial_poly.
+     n             (int, n >= 2) Degree.
+     p             (int, p >= 2) Modulo p coefficient arithmetic.
+     r, primes, prime_count      As for passes_primitivity_tests.
+     num_prim_poly (bigint)      Total number of primitive polynomials.
+
+OUTPUT
+
+     Standard output             Every primitive polynomial.
+     stats (SearchStatistics *)  Counts as if every polynomial had been tested.
+
+RETURNS
+
+     The number of primitive polynomials listed.
+
+EXAMPLE
+                   4                                           4    3
+     Let f(x) = x  + x + 1 modulo 2.  Its reciprocal is g(x) = x  + x  + 1,
+     which comes later in the search order.  When we find f(x) is primitive,
+     we remember that g(x) is too and list it when we reach it, without
+     testing it.
+
+METHOD
+                                                 *    n
+     The reciprocal of f(x) with f( 0 ) != 0 is f (x) = x  f( 1/x ) / f( 0 ),
+                                                                     n
+     whose roots are the inverses of the roots of f(x) in GF( p ).  An
+     element and its inverse have the same order, so one is primitive
+     exactly when the other is.
+
+     Each stage of the primitivity tests also gives the same answer for
+     both:  the constant coefficient of the reciprocal is the inverse of
+     that of f(x), a has root 1/a, the factors of the reciprocal are the
+     reciprocals of the factors of f(x), and x^m = c (mod f(x)) exactly when
+                           *
+     x^m = 1/c (mod f (x)).  So we count the stage statistics twice for the
+     one we test.
+
+     Go through the trial polynomials in order.  Test one only when its
+     reciprocal is itself or comes later, pushing the rank of the reciprocal
+     on a heap if it is primitive.  When we reach a polynomial whose
+     reciprocal came earlier, it's primitive only if it's at the top of the
+     heap.  Polynomials with f( 0 ) = 0 have no reciprocal and are tested as
+     usual;  they fail on the first test.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint list_all_by_reciprocal_pairs( int * f, int n, int p, bigint r,
+                                     bigint * primes, int prime_count,
+                                     bigint num_prim_poly,
+                                     SearchStatistics * stats )
+{
+
+/*------------------------------------------------------------------------------
+|                               Local Variables                                |
+------------------------------------------------------------------------------*/
+
+bigint
+    rank,                          /* Position of f(x) in the search order. */
+    rank_of_reciprocal,
+    max_num_poly,                  /* Last rank the search loop tests.      */
+    prim_poly_count = 0 ;          /* Primitive polynomials listed so far.  */
+
+int
+    is_primitive_poly ;
+
+RankHeap
+    pending ;                      /* Primitive reciprocals still to come.  */
+
+SearchStatistics
+    one ;                          /* Statistics for the one polynomial.    */
+
+/*------------------------------------------------------------------------------
+|                                Function Body                                 |
+------------------------------------------------------------------------------*/
+
+pending.size     = 0 ;
+pending.capacity = 1024 ;
+pending.rank     = (bigint *) malloc( (size_t) pending.capacity * sizeof( bigint ) ) ;
+
+if (pending.rank == (bigint *) 0)
+{
+    printf( "ERROR:  Not enough memory for the reciprocal polynomials.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+max_num_poly = power( p, n ) ;
+
+for (rank = 0 ;  rank <= max_num_poly ;  ++rank)
+{
+    next_trial_poly( f, n, p ) ;
+    ++stats->num_poly ;
+
+    rank_of_reciprocal = (f[ 0 ] == 0 || rank == max_num_poly)
+                         ? rank : reciprocal_rank( f, n, p ) ;
+
+    if (rank_of_reciprocal < rank)
+    {
+        /* Already tested as the reciprocal of an earlier polynomial. */
+        is_primitive_poly = (pending.size > 0 && pending.rank[ 0 ] == rank) ;
+
+        if (is_primitive_poly)
+            pop_rank( &pending ) ;
+    }
+    else
+    {
+        memset( &one, 0, sizeof( one ) ) ;
+
+        is_primitive_poly = passes_primitivity_tests( f, n, p, r, primes,
+                                                      prime_count, &one ) ;
+        add_statistics( stats, &one ) ;
+
+        /* Stand in for testing the reciprocal later on. */
+        if (rank_of_reciprocal > rank)
+        {
+            add_statistics( stats, &one ) ;
+
+            if (is_primitive_poly)
+                push_rank( &pending, rank_of_reciprocal ) ;
+        }
+    }
+
+    if (is_primitive_poly)
+        write_listing_entry( f, n, p, ++prim_poly_count, num_prim_poly ) ;
+
+    if (stats->num_poly % NUMPOLYPERCLOCKCHECK == 0 && progress_due())
+        report_progress( stats, stats->num_poly, prim_poly_count ) ;
+}
+
+free( pending.rank ) ;
+
+return prim_poly_count ;
+
+} /* =========== end of function list_all_by_reciprocal_pairs =============== */
+
+
+
+/*==============================================================================
+|                               reciprocal_rank                                |
+================================================================================
+
+DESCRIPTION
+
+     Position of the reciprocal of f(x) in the search order.
+
+INPUT
+
+     f (int *)     Monic polynomial with f( 0 ) != 0.
+     n (int)       Its degree.
+     p (int)       Modulo p coefficient arithmetic.
+
+RETURNS
+                                              n-1
+     The rank g  + g  p + ... + g     p    of the monic reciprocal g(x).
+               0    1            n-1
+
+EXAMPLE
+                   3                                     3          2
+     Let f(x) = x  + 2 x + 3 modulo 5.  Then 3 g(x) = 3 x  + 2 x + 1,
+                     3         2
+     so g(x) = x  + 4 x  + 2, of rank 2 + 0 5 + 4 25 = 102.
+
+METHOD
+                             -1
+     g  = f      f( 0 )    for 0 <= i <= n.
+      i    n-i
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static bigint reciprocal_rank( int * f, int n, int p )
+{
+bigint rank = 0 ;
+int    inverse = inverse_mod_p( f[ 0 ], p ) ;
+int    i ;
+
+for (i = n - 1 ;  i >= 0 ;  --i)
+    rank = rank * p + (bigint) mod( f[ n - i ] * inverse, p ) ;
+
+return rank ;
+
+} /* ================== end of function reciprocal_rank ===================== */
+
+
+
+/*==============================================================================
+|                                  push_rank                                   |
+================================================================================
+
+DESCRIPTION
+
+     Add a rank to the heap, growing it if necessary.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void push_rank( RankHeap * heap, bigint rank )
+{
+bigint child, parent ;
+
+if (heap->size == heap->capacity)
+{
+    heap->capacity *= 2 ;
+    heap->rank = (bigint *) realloc( heap->rank,
+                                     (size_t) heap->capacity * sizeof( bigint ) ) ;
+
+    if (heap->rank == (bigint *) 0)
+    {
+        printf( "ERROR:  Not enough memory for the reciprocal polynomials.\n\n" ) ;
+        exit( 1 ) ;
+    }
+}
+
+/* Sift up. */
+for (child = heap->size++ ;  child > 0 ;  child = parent)
+{
+    parent = (child - 1) / 2 ;
+
+    if (heap->rank[ parent ] <= rank)
+        break ;
+
+    heap->rank[ child ] = heap->rank[ parent ] ;
+}
+
+heap->rank[ child ] = rank ;
+
+} /* ===================== end of function push_rank ======================== */
+
+
+
+/*==============================================================================
+|                                   pop_rank                                   |
+================================================================================
+
+DESCRIPTION
+
+     Remove and return the smallest rank in the heap, which must not be empty.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static bigint pop_rank( RankHeap * heap )
+{
+bigint smallest = heap->rank[ 0 ] ;
+bigint last     = heap->rank[ --heap->size ] ;
+bigint parent, child ;
+
+/* Sift the last one down from the top. */
+for (parent = 0 ;  (child = 2 * parent + 1) < heap->size ;  parent = child)
+{
+    if (child + 1 < heap->size && heap->rank[ child + 1 ] < heap->rank[ child ])
+        ++child ;
+
+    if (last <= heap->rank[ child ])
+        break ;
+
+    heap->rank[ parent ] = heap->rank[ child ] ;
+}
+
+heap->rank[ parent ] = last ;
+
+return smallest ;
+
+} /* ====================== end of function pop_rank ======================== */
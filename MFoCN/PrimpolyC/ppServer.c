@@ -0,0 +1,582 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppServer.c
+|
+|  Description:
+|
+|     Serve queries from other processes over a Unix domain socket, keeping
+|     what we learn in memory between them, and a small client to send them.
+|
+|  Functions:
+|
+|     run_server
+|     server_worker
+|     serve_connection
+|     stop_server
+|     run_client
+|     read_message
+|     write_message
+|     read_fully
+|     write_fully
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  PROTOCOL
+|
+|     Every message, either way, is a 4 byte length, most significant byte
+|     first, followed by that many bytes of text with no terminating null.
+|     The client sends a query in the form of ppBatch.c, such as
+|
+|         find 2 4
+|
+|     and the server sends back the answer, such as
+|
+|         1,0,0,1,1
+|
+|     A connection may carry any number of queries, one after the other.
+|     Queries longer than MAXQUERYLENGTH close the connection.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+/*  Connections accepted but not yet taken by a worker. */
+typedef struct
+{
+    QueryCache    * cache ;
+    int           * waiting ;       /* Circular queue of sockets ...    */
+    int             capacity ;
+    int             first ;         /* ... oldest one here ...          */
+    int             num_waiting ;   /* ... and how many.                */
+    pthread_mutex_t lock ;
+    pthread_cond_t  arrived ;
+} Server ;
+
+
+static volatile sig_atomic_t server_stopping = 0 ;
+
+static void * server_worker   ( void * arg ) ;
+static void   serve_connection( QueryCache * cache, int fd ) ;
+static void   stop_server     ( int signal_number ) ;
+static char * read_message    ( int fd, size_t max_length ) ;
+static int    write_message   ( int fd, const char * text ) ;
+static int    read_fully      ( int fd, void * buffer, size_t length ) ;
+static int    write_fully     ( int fd, const void * buffer, size_t length ) ;
+
+
+/*==============================================================================
+|                                 run_server                                   |
+================================================================================
+
+DESCRIPTION
+
+     Answer queries sent to a Unix domain socket until we get an interrupt
+     or terminate signal.
+
+INPUT
+
+     socket_path (char *)    Where to make the socket.  An old one left
+                             behind is removed first.
+     num_threads (int)       How many connections to serve at once.
+
+RETURNS
+
+     0 after a clean shutdown, 1 if we couldn't make the socket.
+
+EXAMPLE
+
+     pp -j 4 --serve /tmp/pp.sock &
+     echo "find 2 4" | pp --client /tmp/pp.sock
+
+METHOD
+
+     One query cache (see ppBatch.c) lives as long as the server, so the
+     factorization, first primitive polynomial and recent list and test
+     answers for each p and n are only found once, and two clients asking
+     the same thing at the same time share one search.  The main thread accepts connections and queues
+     them;  num_threads workers take them off the queue and answer queries
+     until the client hangs up.  The workers block SIGINT and SIGTERM, so
+     they always go to the main thread and interrupt its accept().
+
+BUGS
+
+     A client who connects and never hangs up keeps a worker to itself.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int run_server( char * socket_path, int num_threads )
+{
+struct sockaddr_un address ;
+struct sigaction   action ;
+sigset_t           stop_signals ;
+Server             server ;
+pthread_t        * threads ;
+int                listen_fd, fd, i ;
+
+if (strlen( socket_path ) >= sizeof( address.sun_path ))
+{
+    printf( "ERROR:  The socket name %s is too long.\n\n", socket_path ) ;
+    return 1 ;
+}
+
+memset( &address, 0, sizeof( address ) ) ;
+address.sun_family = AF_UNIX ;
+strcpy( address.sun_path, socket_path ) ;
+
+unlink( socket_path ) ;
+
+if ((listen_fd = socket( AF_UNIX, SOCK_STREAM, 0 )) < 0 ||
+    bind( listen_fd, (struct sockaddr *) &address, sizeof( address ) ) < 0 ||
+    listen( listen_fd, SOMAXCONN ) < 0)
+{
+    printf( "ERROR:  Can't listen on the socket %s:  %s\n\n", socket_path, strerror( errno ) ) ;
+    return 1 ;
+}
+
+/*  Interrupt accept() on a signal instead of restarting it, so we can
+    clean up.  A client hanging up while we write shouldn't kill us. */
+memset( &action, 0, sizeof( action ) ) ;
+action.sa_handler = stop_server ;
+sigemptyset( &action.sa_mask ) ;
+sigaction( SIGINT,  &action, (struct sigaction *) 0 ) ;
+sigaction( SIGTERM, &action, (struct sigaction *) 0 ) ;
+signal( SIGPIPE, SIG_IGN ) ;
+
+memset( &server, 0, sizeof( server ) ) ;
+server.cache    = create_query_cache() ;
+server.capacity = 64 ;
+server.waiting  = (int *) calloc( (size_t) server.capacity, sizeof( int ) ) ;
+threads         = (pthread_t *) calloc( (size_t) num_threads, sizeof( pthread_t ) ) ;
+
+if (server.waiting == (int *) 0 || threads == (pthread_t *) 0)
+{
+    printf( "ERROR:  Not enough memory for the server.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+pthread_mutex_init( &server.lock, (pthread_mutexattr_t *) 0 ) ;
+pthread_cond_init( &server.arrived, (pthread_condattr_t *) 0 ) ;
+
+/*  The workers start with the signals blocked, and keep them that way. */
+sigemptyset( &stop_signals ) ;
+sigaddset( &stop_signals, SIGINT ) ;
+sigaddset( &stop_signals, SIGTERM ) ;
+pthread_sigmask( SIG_BLOCK, &stop_signals, (sigset_t *) 0 ) ;
+
+for (i = 0 ;  i < num_threads ;  ++i)
+    pthread_create( &threads[ i ], (pthread_attr_t *) 0, server_worker, &server ) ;
+
+pthread_sigmask( SIG_UNBLOCK, &stop_signals, (sigset_t *) 0 ) ;
+
+printf( "Serving queries on %s with %d thread%s.\n", socket_path, num_threads,
+        (num_threads == 1) ? "" : "s" ) ;
+fflush( stdout ) ;
+
+while (!server_stopping)
+{
+    if ((fd = accept( listen_fd, (struct sockaddr *) 0, (socklen_t *) 0 )) < 0)
+    {
+        if (errno == EINTR || errno == ECONNABORTED)
+            continue ;
+
+        printf( "ERROR:  Can't accept a connection:  %s\n\n", strerror( errno ) ) ;
+        break ;
+    }
+
+    pthread_mutex_lock( &server.lock ) ;
+
+    if (server.num_waiting == server.capacity)
+    {
+        /* Unwrap the queue into a bigger one. */
+        int * bigger = (int *) calloc( 2 * (size_t) server.capacity, sizeof( int ) ) ;
+
+        if (bigger == (int *) 0)
+        {
+            printf( "ERROR:  Not enough memory for the server.\n\n" ) ;
+            exit( 1 ) ;
+        }
+
+        for (i = 0 ;  i < server.num_waiting ;  ++i)
+            bigger[ i ] = server.waiting[ (server.first + i) % server.capacity ] ;
+
+        free( server.waiting ) ;
+        server.waiting  = bigger ;
+        server.first    = 0 ;
+        server.capacity = 2 * server.capacity ;
+    }
+
+    server.waiting[ (server.first + server.num_waiting++) % server.capacity ] = fd ;
+    pthread_cond_signal( &server.arrived ) ;
+    pthread_mutex_unlock( &server.lock ) ;
+}
+
+/*  Workers still serving a client are cut off when we return. */
+close( listen_fd ) ;
+unlink( socket_path ) ;
+
+printf( "Server stopped.\n" ) ;
+
+return 0 ;
+
+} /* ==================== end of function run_server ======================== */
+
+
+
+/*==============================================================================
+|                               server_worker                                  |
+================================================================================
+
+DESCRIPTION
+
+     Thread which serves connections from the queue, one at a time.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void * server_worker( void * arg )
+{
+Server * server = (Server *) arg ;
+int      fd ;
+
+for (;;)
+{
+    pthread_mutex_lock( &server->lock ) ;
+
+    while (server->num_waiting == 0)
+        pthread_cond_wait( &server->arrived, &server->lock ) ;
+
+    fd = server->waiting[ server->first ] ;
+    server->first = (server->first + 1) % server->capacity ;
+    --server->num_waiting ;
+
+    pthread_mutex_unlock( &server->lock ) ;
+
+    serve_connection( server->cache, fd ) ;
+    close( fd ) ;
+}
+
+return (void *) 0 ;
+
+} /* =================== end of function server_worker ====================== */
+
+
+
+/*==============================================================================
+|                              serve_connection                                |
+================================================================================
+
+DESCRIPTION
+
+     Answer queries from one client until it hangs up or sends something
+     we can't read.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void serve_connection( QueryCache * cache, int fd )
+{
+char * query ;
+char * answer ;
+int    ok ;
+
+while ((query = read_message( fd, MAXQUERYLENGTH )) != (char *) 0)
+{
+    answer = answer_query( cache, query ) ;
+    ok     = write_message( fd, answer ) ;
+
+    free( query ) ;
+    free( answer ) ;
+
+    if (!ok)
+        break ;
+}
+
+} /* ================= end of function serve_connection ===================== */
+
+
+
+/*==============================================================================
+|                                stop_server                                   |
+================================================================================
+
+DESCRIPTION
+
+     Signal handler for SIGINT and SIGTERM:  ask the server to stop.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void stop_server( int signal_number )
+{
+(void) signal_number ;
+
+server_stopping = 1 ;
+
+} /* ==================== end of function stop_server ======================= */
+
+
+
+/*==============================================================================
+|                                 run_client                                   |
+================================================================================
+
+DESCRIPTION
+
+     Send queries from standard input to a server and print its answers,
+     for testing a server or using one from a shell script.
+
+INPUT
+
+     socket_path (char *)    The server's socket.
+     Standard input          Queries, one per line, as for --batch.
+
+OUTPUT
+
+     Standard output         The answers, numbered, as from --batch.
+
+RETURNS
+
+     0 if all went well, 1 if we couldn't talk to the server.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int run_client( char * socket_path )
+{
+struct sockaddr_un address ;
+char               line[ MAXQUERYLENGTH + 2 ] ;
+char             * start ;
+char             * answer ;
+int                fd, length, query_num = 0 ;
+
+if (strlen( socket_path ) >= sizeof( address.sun_path ))
+{
+    printf( "ERROR:  The socket name %s is too long.\n\n", socket_path ) ;
+    return 1 ;
+}
+
+memset( &address, 0, sizeof( address ) ) ;
+address.sun_family = AF_UNIX ;
+strcpy( address.sun_path, socket_path ) ;
+
+if ((fd = socket( AF_UNIX, SOCK_STREAM, 0 )) < 0 ||
+    connect( fd, (struct sockaddr *) &address, sizeof( address ) ) < 0)
+{
+    printf( "ERROR:  Can't connect to the server at %s:  %s\n\n", socket_path, strerror( errno ) ) ;
+    return 1 ;
+}
+
+signal( SIGPIPE, SIG_IGN ) ;
+
+while (fgets( line, sizeof( line ), stdin ) != (char *) 0)
+{
+    for (start = line ;  *start == ' ' || *start == '\t' ;  ++start)
+        ;
+
+    length = (int) strcspn( start, "\r\n" ) ;
+    start[ length ] = '\0' ;
+
+    if (length == 0 || start[ 0 ] == '#')
+        continue ;
+
+    if (!write_message( fd, start ) ||
+        (answer = read_message( fd, (size_t) -1 )) == (char *) 0)
+    {
+        printf( "ERROR:  Lost the connection to the server.\n\n" ) ;
+        close( fd ) ;
+        return 1 ;
+    }
+
+    printf( "%d %s : %s\n", ++query_num, start, answer ) ;
+    free( answer ) ;
+}
+
+close( fd ) ;
+
+return 0 ;
+
+} /* ==================== end of function run_client ======================== */
+
+
+
+/*==============================================================================
+|                        read_message, write_message                           |
+================================================================================
+
+DESCRIPTION
+
+     Read or write one length-prefixed message.
+
+INPUT
+
+     fd (int)                The socket.
+     max_length (size_t)     Longest message we'll accept.
+     text (const char *)     Message to write.
+
+RETURNS
+
+     read_message:   the message with a null at the end, for the caller to
+                     free, or null if the other end hung up, the message
+                     was too long, or we ran out of memory.
+     write_message:  YES if it was all written, NO if not.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static char * read_message( int fd, size_t max_length )
+{
+unsigned char header[ 4 ] ;
+size_t        length ;
+char        * text ;
+
+if (!read_fully( fd, header, sizeof( header ) ))
+    return (char *) 0 ;
+
+length = ((size_t) header[ 0 ] << 24) | ((size_t) header[ 1 ] << 16) |
+         ((size_t) header[ 2 ] <<  8) |  (size_t) header[ 3 ] ;
+
+if (length > max_length || (text = (char *) malloc( length + 1 )) == (char *) 0)
+    return (char *) 0 ;
+
+if (!read_fully( fd, text, length ))
+{
+    free( text ) ;
+    return (char *) 0 ;
+}
+
+text[ length ] = '\0' ;
+
+return text ;
+
+} /* =================== end of function read_message ======================= */
+
+
+static int write_message( int fd, const char * text )
+{
+unsigned char header[ 4 ] ;
+size_t        length = strlen( text ) ;
+
+if (length > 0xFFFFFFFFUL)
+    return NO ;
+
+header[ 0 ] = (unsigned char) (length >> 24) ;
+header[ 1 ] = (unsigned char) (length >> 16) ;
+header[ 2 ] = (unsigned char) (length >>  8) ;
+header[ 3 ] = (unsigned char)  length ;
+
+return write_fully( fd, header, sizeof( header ) ) && write_fully( fd, text, length ) ;
+
+} /* =================== end of function write_message ====================== */
+
+
+
+/*==============================================================================
+|                          read_fully, write_fully                             |
+================================================================================
+
+DESCRIPTION
+
+     Read or write exactly length bytes, since a socket may hand over less
+     than we asked for.
+
+RETURNS
+
+     YES if all the bytes went through, NO on an error or end of file.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int read_fully( int fd, void * buffer, size_t length )
+{
+char  * next = (char *) buffer ;
+ssize_t num_read ;
+
+while (length > 0)
+{
+    num_read = read( fd, next, length ) ;
+
+    if (num_read < 0 && errno == EINTR)
+        continue ;
+
+    if (num_read <= 0)
+        return NO ;
+
+    next   += num_read ;
+    length -= (size_t) num_read ;
+}
+
+return YES ;
+
+} /* ==================== end of function read_fully ======================== */
+
+
+static int write_fully( int fd, const void * buffer, size_t length )
+{
+const char * next = (const char *) buffer ;
+ssize_t      num_written ;
+
+while (length > 0)
+{
+    num_written = write( fd, next, length ) ;
+
+    if (num_written < 0 && errno == EINTR)
+        continue ;
+
+    if (num_written <= 0)
+        return NO ;
+
+    next   += num_written ;
+    length -= (size_t) num_written ;
+}
+
+return YES ;
+
+} /* ==================== end of function write_fully ======================= */
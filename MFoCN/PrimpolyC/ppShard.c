@@ -0,0 +1,556 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppShard.c
+|
+|  Description:
+|
+|     Split the search into shards to run as separate processes, possibly
+|     on different machines, and merge their results back together.
+|
+|  Functions:
+|
+|     shard_range
+|     search_shard
+|     merge_shards
+|     read_shard_header
+|     read_shard_record
+|     read_bigint
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Primpoly.h"
+
+#define SHARDVERSION 1  /*  Change when the shard file layout changes. */
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+/*  The header of one shard file, and where its results begin. */
+typedef struct
+{
+    char * file_name ;
+    FILE * fp ;
+    int    p ;
+    int    n ;
+    int    list_all ;
+    int    shard ;             /* This is shard number shard of num_shards. */
+    int    num_shards ;
+    bigint first_rank ;        /* Trial polynomials first_rank to last_rank. */
+    bigint last_rank ;
+} ShardHeader ;
+
+
+static void read_shard_header( char * file_name, ShardHeader * header ) ;
+static int  read_shard_record( ShardHeader * header, bigint * rank,
+                               SearchStatistics * stats ) ;
+static int  read_bigint      ( FILE * fp, const char * name, bigint * x ) ;
+
+
+/*==============================================================================
+|                                 shard_range                                  |
+================================================================================
+
+DESCRIPTION
+
+     Find which trial polynomials belong to a shard.
+
+INPUT
+
+     p, n (int)              Modulus and degree.
+     shard (int)             1 <= shard <= num_shards.
+     num_shards (int)        How many shards the search is split into.
+
+OUTPUT
+
+     first_rank (bigint *)   The shard tests trial polynomials first_rank
+     last_rank  (bigint *)   through last_rank, in the order of next_trial_poly.
+
+RETURNS
+
+     YES if the shard has any trial polynomials, NO if there are more shards
+     than trial polynomials.
+
+EXAMPLE
+                                 4
+     For p = 2, n = 4 there are 2  + 1 = 17 trial polynomials, counting the
+     one past the end which the search loop in main tests.  Split 3 ways,
+     the shards get ranks 0-5, 6-11 and 12-16.
+
+METHOD
+
+     Give each shard T / N trial polynomials, and one more to each of the
+     first T mod N shards.  This avoids computing (k-1) T, which can overflow.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int shard_range( int p, int n, int shard, int num_shards,
+                 bigint * first_rank, bigint * last_rank )
+{
+bigint total   = power( p, n ) + 1 ;
+bigint size    = total / num_shards ;
+bigint extra   = total % num_shards ;
+bigint k       = (bigint) (shard - 1) ;
+
+*first_rank = k * size + (k < extra ? k : extra) ;
+*last_rank  = *first_rank + size + (k < extra ? 1 : 0) ;
+
+if (*last_rank == *first_rank)
+    return NO ;
+
+--*last_rank ;
+
+return YES ;
+
+} /* ==================== end of function shard_range ======================== */
+
+
+
+/*==============================================================================
+|                                search_shard                                  |
+================================================================================
+
+DESCRIPTION
+
+     Test the trial polynomials of one shard and write what we found to
+     standard output, for merge_shards to put together later.
+
+INPUT
+
+     n, p, r, primes, prime_count   As for passes_primitivity_tests.
+     shard, num_shards (int)        Which shard to search.
+     list_all (int)                 YES to find all in the shard, NO to stop
+                                    at the first.
+
+OUTPUT
+
+     Standard output                The shard record:
+
+                                        Primpoly shard 1
+                                        p 2
+                                        n 4
+                                        list_all 1
+                                        shard 1 3
+                                        first_rank 0
+                                        last_rank 5
+                                        hit 3
+                                        num_poly 6
+                                        num_const_coeff_prim_root 3
+                                        ...
+                                        end
+
+                                    with a hit line for the rank of each
+                                    primitive polynomial, in order.
+
+METHOD
+
+     Jump to the first trial polynomial with unrank_trial_poly, then go on
+     with next_trial_poly as usual.  Hits are written as they are found, so a
+     shard needs no memory for them.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void search_shard( int n, int p, bigint r, bigint * primes, int prime_count,
+                   int shard, int num_shards, int list_all )
+{
+int              f[ MAXDEGPOLY + 1 ] ;
+bigint           first_rank, last_rank, rank ;
+SearchStatistics stats ;
+
+memset( &stats, 0, sizeof( stats ) ) ;
+
+printf( "Primpoly shard %d\n", SHARDVERSION ) ;
+printf( "p %d\nn %d\nlist_all %d\nshard %d %d\n", p, n, list_all, shard, num_shards ) ;
+
+if (shard_range( p, n, shard, num_shards, &first_rank, &last_rank ))
+{
+    printf( "first_rank %s\nlast_rank %s\n", bigint_string( first_rank ), bigint_string( last_rank ) ) ;
+
+    unrank_trial_poly( f, n, p, first_rank ) ;
+
+    for (rank = first_rank ;  rank <= last_rank ;  ++rank)
+    {
+        if (rank > first_rank)
+            next_trial_poly( f, n, p ) ;
+
+        ++stats.num_poly ;
+
+        if (passes_primitivity_tests( f, n, p, r, primes, prime_count, &stats ))
+        {
+            printf( "hit %s\n", bigint_string( rank ) ) ;
+
+            if (!list_all)
+                break ;
+        }
+    }
+}
+else
+    /* An empty shard.  last_rank = first_rank - 1 says so. */
+    printf( "first_rank %s\nlast_rank %s\n", bigint_string( first_rank ), bigint_string( first_rank - 1 ) ) ;
+
+printf( "num_poly %s\n",                      bigint_string( stats.num_poly ) ) ;
+printf( "num_const_coeff_prim_root %s\n",       bigint_string( stats.num_const_coeff_prim_root ) ) ;
+printf( "num_free_of_linear_factors %s\n",      bigint_string( stats.num_free_of_linear_factors ) ) ;
+printf( "num_irred_to_power %s\n",              bigint_string( stats.num_irred_to_power ) ) ;
+printf( "num_order_r %s\n",                     bigint_string( stats.num_order_r ) ) ;
+printf( "num_passing_const_coeff_test %s\n",    bigint_string( stats.num_passing_const_coeff_test ) ) ;
+printf( "num_order_m %s\n",                     bigint_string( stats.num_order_m ) ) ;
+printf( "end\n" ) ;
+
+} /* =================== end of function search_shard ======================== */
+
+
+
+/*==============================================================================
+|                                merge_shards                                  |
+================================================================================
+
+DESCRIPTION
+
+     Put the shard records back together into the results of one search.
+
+INPUT
+
+     file_names (char **)    Files holding the output of search_shard for
+     num_files (int)         each shard, in any order.
+     n, p (int)              Degree and modulus, which the shards must match.
+     list_all (int)          YES if listing all, which the shards must match.
+     num_prim_poly (bigint)  Total number of primitive polynomials.
+
+OUTPUT
+
+     Standard output         The listing, exactly as the search loop in main
+                             prints it, when list_all is YES.
+     f (int *)               The first primitive polynomial.
+     stats (SearchStatistics *)  The same counts as the search loop in main.
+
+RETURNS
+
+     The number of primitive polynomials found.
+
+EXAMPLE
+
+     pp -a -s --shard 1/3 2 20 > s1
+     pp -a -s --shard 2/3 2 20 > s2
+     pp -a -s --shard 3/3 2 20 > s3
+     pp -a -s --merge s1 --merge s2 --merge s3 2 20
+
+     prints the same as pp -a -s 2 20.
+
+METHOD
+
+     Read the headers and go through the shards in order, checking they
+     cover the trial polynomials without gaps or overlaps.  Number the hits
+     as they come, and add up the statistics.  When we only want the first
+     primitive polynomial, the shards after the first one with a hit don't
+     count, since the search loop would have stopped before them;  they
+     needn't even be there.
+
+     Anything in the file before the "Primpoly shard" line is skipped, so
+     the legal notice and factorization the shard run prints do no harm.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint merge_shards( char ** file_names, int num_files, int n, int p,
+                     int list_all, bigint num_prim_poly, int * f,
+                     SearchStatistics * stats )
+{
+ShardHeader      * headers ;
+ShardHeader      * order ;
+SearchStatistics   part ;
+bigint             rank, next_rank = 0, prim_poly_count = 0 ;
+int                i, num_shards ;
+
+headers = (ShardHeader *) calloc( (size_t) num_files, sizeof( ShardHeader ) ) ;
+
+if (headers == (ShardHeader *) 0)
+{
+    printf( "ERROR:  Not enough memory to merge the shards.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+for (i = 0 ;  i < num_files ;  ++i)
+{
+    read_shard_header( file_names[ i ], &headers[ i ] ) ;
+
+    if (headers[ i ].p != p || headers[ i ].n != n || headers[ i ].list_all != list_all ||
+        headers[ i ].num_shards != headers[ 0 ].num_shards)
+    {
+        printf( "ERROR:  Shard file %s is from a different search.\n\n", file_names[ i ] ) ;
+        exit( 1 ) ;
+    }
+}
+
+/* Put the shards in order, making sure there's only one of each. */
+num_shards = headers[ 0 ].num_shards ;
+
+order = (ShardHeader *) calloc( (size_t) (num_shards > 0 ? num_shards : 1), sizeof( ShardHeader ) ) ;
+
+if (order == (ShardHeader *) 0)
+{
+    printf( "ERROR:  Not enough memory to merge the shards.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+for (i = 0 ;  i < num_files ;  ++i)
+{
+    if (headers[ i ].shard < 1 || headers[ i ].shard > num_shards ||
+        order[ headers[ i ].shard - 1 ].fp != (FILE *) 0)
+    {
+        printf( "ERROR:  Shard file %s is shard %d of %d, which we already have or can't be.\n\n",
+                file_names[ i ], headers[ i ].shard, num_shards ) ;
+        exit( 1 ) ;
+    }
+
+    order[ headers[ i ].shard - 1 ] = headers[ i ] ;
+}
+
+for (i = 0 ;  i < num_shards ;  ++i)
+{
+    /* The search loop stops at the first one, so the rest don't count. */
+    if (!list_all && prim_poly_count > 0)
+    {
+        if (order[ i ].fp != (FILE *) 0)
+            fclose( order[ i ].fp ) ;
+        continue ;
+    }
+
+    if (order[ i ].fp == (FILE *) 0)
+    {
+        printf( "ERROR:  Shard %d of %d is missing.\n\n", i + 1, num_shards ) ;
+        exit( 1 ) ;
+    }
+
+    if (order[ i ].first_rank != next_rank)
+    {
+        printf( "ERROR:  Shard file %s doesn't start where the shard before ended.\n\n",
+                order[ i ].file_name ) ;
+        exit( 1 ) ;
+    }
+
+    next_rank = order[ i ].last_rank + 1 ;
+
+    /* Without -a, f(x) is left as the one and only hit. */
+    while (read_shard_record( &order[ i ], &rank, &part ))
+    {
+        unrank_trial_poly( f, n, p, rank ) ;
+        ++prim_poly_count ;
+
+        if (list_all)
+            write_listing_entry( f, n, p, prim_poly_count, num_prim_poly ) ;
+    }
+
+    add_statistics( stats, &part ) ;
+
+    fclose( order[ i ].fp ) ;
+}
+
+if ((list_all || prim_poly_count == 0) && next_rank != power( p, n ) + 1)
+{
+    printf( "ERROR:  The shards don't cover all the trial polynomials.\n\n" ) ;
+    exit( 1 ) ;
+}
+
+free( headers ) ;
+free( order ) ;
+
+return prim_poly_count ;
+
+} /* =================== end of function merge_shards ======================== */
+
+
+
+/*==============================================================================
+|                              read_shard_header                               |
+================================================================================
+
+DESCRIPTION
+
+     Open a shard file and read its header.  Exit with an error message if
+     it isn't a shard file.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void read_shard_header( char * file_name, ShardHeader * header )
+{
+char line[ _MAX_PATH ] ;
+int  version = 0 ;
+int  found   = NO ;
+
+header->file_name = file_name ;
+
+if ((header->fp = fopen( file_name, "r" )) == (FILE *) 0)
+{
+    printf( "ERROR:  Can't open shard file %s\n\n", file_name ) ;
+    exit( 1 ) ;
+}
+
+/* Skip whatever came before the shard record. */
+while (fgets( line, sizeof( line ), header->fp ) != (char *) 0)
+{
+    if (sscanf( line, "Primpoly shard %d", &version ) == 1)
+    {
+        found = YES ;
+        break ;
+    }
+}
+
+if (!found || version != SHARDVERSION ||
+    fscanf( header->fp, " p %d n %d list_all %d shard %d %d",
+            &header->p, &header->n, &header->list_all, &header->shard,
+            &header->num_shards ) != 5 ||
+    !read_bigint( header->fp, "first_rank", &header->first_rank ) ||
+    !read_bigint( header->fp, "last_rank",  &header->last_rank ))
+{
+    printf( "ERROR:  %s isn't a shard file.\n\n", file_name ) ;
+    exit( 1 ) ;
+}
+
+} /* ================ end of function read_shard_header ===================== */
+
+
+
+/*==============================================================================
+|                              read_shard_record                               |
+================================================================================
+
+DESCRIPTION
+
+     Read the next hit from a shard file.
+
+OUTPUT
+
+     rank (bigint *)             Rank of the next primitive polynomial.
+     stats (SearchStatistics *)  The statistics for the shard, once there are
+                                 no more hits.
+
+RETURNS
+
+     YES if there was another hit, NO at the end of the shard.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int read_shard_record( ShardHeader * header, bigint * rank,
+                              SearchStatistics * stats )
+{
+char name[ 64 ] ;
+int  ok ;
+
+if (fscanf( header->fp, "%63s", name ) != 1)
+    ok = NO ;
+else if (strcmp( name, "hit" ) == 0)
+{
+    if (read_bigint( header->fp, "", rank ) &&
+        *rank >= header->first_rank && *rank <= header->last_rank)
+        return YES ;
+
+    ok = NO ;
+}
+else
+{
+    memset( stats, 0, sizeof( *stats ) ) ;
+
+    ok = strcmp( name, "num_poly" ) == 0 &&
+         read_bigint( header->fp, "",                             &stats->num_poly ) &&
+         read_bigint( header->fp, "num_const_coeff_prim_root",    &stats->num_const_coeff_prim_root ) &&
+         read_bigint( header->fp, "num_free_of_linear_factors",   &stats->num_free_of_linear_factors ) &&
+         read_bigint( header->fp, "num_irred_to_power",           &stats->num_irred_to_power ) &&
+         read_bigint( header->fp, "num_order_r",                  &stats->num_order_r ) &&
+         read_bigint( header->fp, "num_passing_const_coeff_test", &stats->num_passing_const_coeff_test ) &&
+         read_bigint( header->fp, "num_order_m",                  &stats->num_order_m ) &&
+         fscanf( header->fp, "%63s", name ) == 1 &&
+         strcmp( name, "end" ) == 0 ;
+
+    if (ok)
+        return NO ;
+}
+
+printf( "ERROR:  Shard file %s is damaged or incomplete.\n\n", header->file_name ) ;
+exit( 1 ) ;
+
+} /* ================ end of function read_shard_record ===================== */
+
+
+
+/*==============================================================================
+|                                 read_bigint                                  |
+================================================================================
+
+DESCRIPTION
+
+     Read a name, unless it is "", and then a bigint, from a shard file.
+     fscanf can't read the 128-bit bigint, so we read the digits and
+     convert them ourselves.
+
+RETURNS
+
+     YES if both were there.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int read_bigint( FILE * fp, const char * name, bigint * x )
+{
+char word[ 64 ] ;
+
+if (*name != '\0' && (fscanf( fp, "%63s", word ) != 1 || strcmp( word, name ) != 0))
+    return NO ;
+
+return fscanf( fp, "%63s", word ) == 1 && string_to_bigint( word, x ) ;
+
+} /* ==================== end of function read_bigint ======================= */
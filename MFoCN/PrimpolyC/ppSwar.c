@@ -0,0 +1,770 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppSwar.c
+|
+|  Description:
+|
+|     Polynomial arithmetic modulo f(x) and p for small fields, with the
+|     whole polynomial packed into one 64 bit word.
+|
+|  Functions:
+|
+|     swar_fits
+|     swar_x_to_power
+|     swar_times_x_poly
+|     swar_square_poly
+|     swar_product_poly
+|     swar_field
+|     swar_setup
+|     swar_pack
+|     swar_unpack
+|     swar_add
+|     swar_times_x
+|     swar_product
+|     swar_square
+|     swar_reduce
+|     swar_wide_mod
+|     swar_spread
+|     swar_compress
+|     swar_is_integer
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  PACKING
+|
+|     For n <= SWARMAXDEG and p <= SWARMAXP, a polynomial of degree n-1 or
+|     less has its coefficient of x ^ k in bits 4k to 4k+3 of a word.  The
+|     sum of two coefficients is at most 12, so adding two words adds all
+|     the coefficients at once without one spilling into the next, and
+|     then we subtract p from the ones which are p or more.  Multiplying by
+|     x is a shift.  So one word operation does the work of a loop over
+|     the coefficients.
+|
+|     Products have degree up to 2n-2, and their coefficients are sums of
+|     up to n products of two coefficients, which don't fit in 4 bits.  So
+|     we spread the 4 bit coefficients out to 8 bits, four words for the
+|     whole product, and add up c a(x) x^k a word at a time, reducing all
+|     the coefficients modulo p only every so often, before they can pass
+|     255.  Then the terms of degree n and up are replaced by their rows of
+|     the power table, the same way.
+|
+|     square, product, times_x and x_to_power in ppPolyArith.c come here
+|     when swar_fits( n, p ), and x_to_power tells order_r and order_m
+|     whether its answer is an integer from the packed word.
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+typedef unsigned long long swar_poly ;  /*  4 bits per coefficient.  */
+typedef unsigned long long swar_wide ;  /*  8 bits per coefficient.  */
+
+#define SWARONES  0x1111111111111111ULL /*  1 in every coefficient.  */
+#define SWARBYTES 0x0101010101010101ULL /*  1 in every wide one.     */
+
+/*  What we need to know about f(x) and p for the arithmetic. */
+typedef struct
+{
+    int       n ;
+    int       p ;
+    swar_poly key ;             /* x ^ n (mod f(x), p), which gives f(x).   */
+    swar_poly mask ;            /* Coefficients of x ^ 0 ... x ^ n-1.       */
+    swar_poly bias ;            /* 8 - p in every coefficient.              */
+    swar_poly x_to_n[ SWARMAXP ] ;  /* c x ^ n (mod f(x), p) for c < p.     */
+    swar_wide low_mask[ 2 ] ;   /* Wide coefficients of x ^ 0 ... x ^ n-1.  */
+    swar_wide row[ SWARMAXDEG - 1 ][ 2 ] ; /* x ^ n+k (mod f(x), p), wide.  */
+    int       fold_every ;      /* c a(x) we can add to wide coefficients
+                                   below p before they might pass 255.     */
+    int       digit_bits ;      /* e with 2 ^ e = 1 (mod p), 0 for p = 2.   */
+    int       num_digit_sums ;  /* Times swar_wide_mod adds digits, ...     */
+    int       top_shift ;       /* ... then subtracts p 2 ^ j, j <= this.   */
+} SwarField ;
+
+
+static SwarField * swar_field    ( int power_table[][ MAXDEGPOLY ], int n, int p ) ;
+static void      swar_setup     ( SwarField * F, swar_poly key,
+                                  int power_table[][ MAXDEGPOLY ], int n, int p ) ;
+static swar_poly swar_pack      ( const int * t, int n ) ;
+static void      swar_unpack    ( swar_poly a, int * t, int n ) ;
+static swar_poly swar_add       ( SwarField * F, swar_poly a, swar_poly b ) ;
+static swar_poly swar_times_x   ( SwarField * F, swar_poly a ) ;
+static swar_poly swar_product   ( SwarField * F, swar_poly a, swar_poly b ) ;
+static swar_poly swar_square    ( SwarField * F, swar_poly a ) ;
+static swar_poly swar_reduce    ( SwarField * F, swar_wide * w ) ;
+static void      swar_wide_mod  ( SwarField * F, swar_wide * w, int num_words ) ;
+static swar_wide swar_spread    ( unsigned long long a ) ;
+static unsigned long long swar_compress( swar_wide w ) ;
+static int       swar_is_integer( swar_poly a ) ;
+
+
+/*  The field of the last call in this thread.  One trial polynomial gets
+    several calls in a row, order_r and then order_m for each prime, so
+    we set up once for all of them. */
+static _Thread_local SwarField last_field ;
+static _Thread_local int       last_field_ready = NO ;
+
+
+/*==============================================================================
+|                                  swar_fits                                   |
+================================================================================
+
+DESCRIPTION
+
+     Can a polynomial of degree n modulo p be packed into a word?
+
+RETURNS
+
+     YES if n <= SWARMAXDEG and p <= SWARMAXP.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int swar_fits( int n, int p )
+{
+return n <= SWARMAXDEG && p <= SWARMAXP ;
+
+} /* ====================== end of function swar_fits ======================== */
+
+
+
+/*==============================================================================
+|                               swar_x_to_power                                |
+================================================================================
+
+DESCRIPTION
+                     m
+     Compute g(x) = x   (mod f(x), p) in packed words.  Called by
+     x_to_power when swar_fits( n, p ).
+
+INPUT
+
+     m           (bigint)      Exponent, m >= 1.
+     power_table (int [][])    From construct_power_table;  only the first
+                               row, x ^ n (mod f(x), p), is used.
+     n, p        (int)         Degree of f(x) and the modulus.
+
+OUTPUT
+
+     g (int *)                 Coefficients of g(x), g[ 0 ] ... g[ n-1 ].
+
+RETURNS
+
+     YES if g(x) is an integer, as for is_integer.
+
+METHOD
+
+     As x_to_power:  square for each bit of m after the leading 1, and
+     multiply by x for each 1 bit.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int swar_x_to_power( bigint m, int * g, int power_table[][ MAXDEGPOLY ], int n, int p )
+{
+SwarField * F = swar_field( power_table, n, p ) ;
+swar_poly   t = (swar_poly) 1 << 4 ;      /*  t(x) = x  */
+int         bit ;
+
+for (bit = NUMBITS - 1 ;  bit > 0 && !((m >> bit) & 1) ;  --bit)
+    ;
+
+while (--bit >= 0)
+{
+    t = swar_square( F, t ) ;
+
+    if ((m >> bit) & 1)
+        t = swar_times_x( F, t ) ;
+}
+
+swar_unpack( t, g, n ) ;
+
+return swar_is_integer( t ) ;
+
+} /* ================== end of function swar_x_to_power ===================== */
+
+
+
+/*==============================================================================
+|              swar_times_x_poly, swar_square_poly, swar_product_poly          |
+================================================================================
+
+DESCRIPTION
+
+     times_x, square and product in packed words.  Called by those
+     functions when swar_fits( n, p ).
+
+INPUT
+
+     s, t        (int *)       Coefficients of s(x) and t(x), degree <= n-1.
+     power_table (int [][])    From construct_power_table.
+     n, p        (int)         Degree of f(x) and the modulus.
+
+OUTPUT
+
+     t (int *)                 x t(x) or t(x) ^ 2 (mod f(x), p), or
+     s (int *)                 s(x) t(x) (mod f(x), p).
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void swar_times_x_poly( int * t, int power_table[][ MAXDEGPOLY ], int n, int p )
+{
+SwarField * F = swar_field( power_table, n, p ) ;
+
+swar_unpack( swar_times_x( F, swar_pack( t, n ) ), t, n ) ;
+
+} /* ================= end of function swar_times_x_poly ==================== */
+
+
+void swar_square_poly( int * t, int power_table[][ MAXDEGPOLY ], int n, int p )
+{
+SwarField * F = swar_field( power_table, n, p ) ;
+
+swar_unpack( swar_square( F, swar_pack( t, n ) ), t, n ) ;
+
+} /* ================== end of function swar_square_poly ==================== */
+
+
+void swar_product_poly( int * s, int * t, int power_table[][ MAXDEGPOLY ], int n, int p )
+{
+SwarField * F = swar_field( power_table, n, p ) ;
+
+swar_unpack( swar_product( F, swar_pack( s, n ), swar_pack( t, n ) ), s, n ) ;
+
+} /* ================= end of function swar_product_poly ==================== */
+
+
+
+/*==============================================================================
+|                                 swar_field                                   |
+================================================================================
+
+DESCRIPTION
+
+     The field for f(x) and p, set up only if it isn't the one this thread
+     used last.
+
+INPUT
+
+     power_table (int [][])    From construct_power_table.  Its first row,
+                               x ^ n (mod f(x), p), is -f(x) without the
+                               x ^ n, so it tells us if f(x) changed.
+     n, p        (int)
+
+RETURNS
+
+     The field, good until the next call in this thread.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static SwarField * swar_field( int power_table[][ MAXDEGPOLY ], int n, int p )
+{
+swar_poly key = swar_pack( power_table[ 0 ], n ) ;
+
+if (!last_field_ready || last_field.key != key ||
+    last_field.n != n || last_field.p != p)
+{
+    swar_setup( &last_field, key, power_table, n, p ) ;
+    last_field_ready = YES ;
+}
+
+return &last_field ;
+
+} /* ===================== end of function swar_field ======================= */
+
+
+
+/*==============================================================================
+|                                 swar_setup                                   |
+================================================================================
+
+DESCRIPTION
+
+     Get ready to do arithmetic modulo f(x) and p.
+
+INPUT
+
+     key         (swar_poly)   x ^ n (mod f(x), p), packed.
+     power_table (int [][])    Row k is x ^ n+k (mod f(x), p).
+     n, p        (int)
+
+OUTPUT
+
+     F (SwarField *)           The masks, the multiples of x ^ n, and the
+                               wide rows of the power table.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void swar_setup( SwarField * F, swar_poly key,
+                        int power_table[][ MAXDEGPOLY ], int n, int p )
+{
+swar_poly row ;
+int       k, c, largest ;
+
+F->n    = n ;
+F->p    = p ;
+F->key  = key ;
+F->mask = (n >= 16) ? ~0ULL : ((swar_poly) 1 << (4 * n)) - 1 ;
+F->bias = (swar_poly) (8 - p) * SWARONES ;
+
+F->x_to_n[ 0 ] = 0 ;
+for (c = 1 ;  c < p ;  ++c)
+    F->x_to_n[ c ] = swar_add( F, F->x_to_n[ c - 1 ], key ) ;
+
+F->low_mask[ 0 ] = (n >= 8)  ? ~0ULL : ((swar_wide) 1 << (8 * n)) - 1 ;
+F->low_mask[ 1 ] = (n >= 16) ? ~0ULL :
+                   (n <= 8)  ? 0     : ((swar_wide) 1 << (8 * (n - 8))) - 1 ;
+
+for (k = 0 ;  k <= n - 2 ;  ++k)
+{
+    row = swar_pack( power_table[ k ], n ) ;
+    F->row[ k ][ 0 ] = swar_spread( row ) ;
+    F->row[ k ][ 1 ] = swar_spread( row >> 32 ) ;
+}
+
+/*  Adding c a(x) adds at most (p-1)^2 to a coefficient. */
+F->fold_every = (255 - (p - 1)) / ((p - 1) * (p - 1)) ;
+
+/*  Plan swar_wide_mod:  how far adding digits gets a coefficient from 255
+    down, then the subtractions to finish. */
+for (F->digit_bits = 1 ;  p > 2 && (1 << F->digit_bits) % p != 1 ;  ++F->digit_bits)
+    ;
+
+if (p == 2)
+    F->digit_bits = 0 ;
+
+largest = 255 ;
+F->num_digit_sums = 0 ;
+
+while (F->digit_bits != 0 && largest >= 2 * p &&
+       (largest >> F->digit_bits) + (1 << F->digit_bits) - 1 < largest)
+{
+    largest = (largest >> F->digit_bits) + (1 << F->digit_bits) - 1 ;
+    ++F->num_digit_sums ;
+}
+
+for (F->top_shift = 0 ;  (p << (F->top_shift + 1)) <= largest ;  ++F->top_shift)
+    ;
+
+} /* ===================== end of function swar_setup ======================= */
+
+
+
+/*==============================================================================
+|                           swar_pack, swar_unpack                             |
+================================================================================
+
+DESCRIPTION
+
+     Pack the coefficients t[ 0 ] ... t[ n-1 ] into a word, and back.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static swar_poly swar_pack( const int * t, int n )
+{
+swar_poly a = 0 ;
+int       k ;
+
+for (k = n - 1 ;  k >= 0 ;  --k)
+    a = (a << 4) | (swar_poly) t[ k ] ;
+
+return a ;
+
+} /* ===================== end of function swar_pack ======================== */
+
+
+static void swar_unpack( swar_poly a, int * t, int n )
+{
+int k ;
+
+for (k = 0 ;  k <= n - 1 ;  ++k, a >>= 4)
+    t[ k ] = (int) (a & 15) ;
+
+} /* ==================== end of function swar_unpack ======================= */
+
+
+
+/*==============================================================================
+|                                  swar_add                                    |
+================================================================================
+
+DESCRIPTION
+
+     a(x) + b(x) modulo p, every coefficient at once.
+
+METHOD
+
+     Each coefficient s of the sum is at most 2p - 2.  Adding 8 - p to it
+     gives at most p + 6 < 16, so it stays in its 4 bits, and its top bit
+     is set exactly when s >= p.  Subtract p from those.  The masks are
+     only read in the coefficients we use, so the high bits of a word for
+     n < 16 stay 0.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static swar_poly swar_add( SwarField * F, swar_poly a, swar_poly b )
+{
+swar_poly s   = a + b ;
+swar_poly big = ((s + F->bias) >> 3) & SWARONES & F->mask ;
+
+return s - big * (swar_poly) F->p ;
+
+} /* ====================== end of function swar_add ======================== */
+
+
+
+/*==============================================================================
+|                                swar_times_x                                  |
+================================================================================
+
+DESCRIPTION
+
+     x a(x) (mod f(x), p).
+
+METHOD
+                                                     n
+     Shift everything up one coefficient, and replace x  by its remainder.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static swar_poly swar_times_x( SwarField * F, swar_poly a )
+{
+int top = (int) ((a >> (4 * (F->n - 1))) & 15) ;
+
+return swar_add( F, (a << 4) & F->mask, F->x_to_n[ top ] ) ;
+
+} /* ==================== end of function swar_times_x ====================== */
+
+
+
+/*==============================================================================
+|                           swar_product, swar_square                          |
+================================================================================
+
+DESCRIPTION
+
+     a(x) b(x) (mod f(x), p), and a(x) squared.
+
+METHOD
+
+     Spread a(x) out to 8 bits a coefficient, then add b  a(x) x ^ k for
+                                                        k
+     each k into the four wide words of the product.  The shift by k moves
+     the two words of a(x) across three of the product's, and the multiply
+     by b  is one multiply of each word, since no coefficient of b  a(x)
+         k                                                        k
+     needs more than 8 bits.  That's 3 n word multiplies and adds, and a
+     reduction of all the coefficients modulo p every fold_every of them:
+     just once at the end for p = 2 or 3, and at most 2 and 3 times for
+     p = 5 and 7.
+
+     For p = 2, squaring is linear:  the square of the sum of a  x ^ i is
+                                                               i
+     the sum of a  x ^ 2i.  So spreading the coefficients out twice, to 16
+                 i
+     bits, is the square, without any multiplies.  Odd p use the product.
+
+     Either way, swar_reduce finishes.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static swar_poly swar_product( SwarField * F, swar_poly a, swar_poly b )
+{
+swar_wide A0 = swar_spread( a ), A1 = swar_spread( a >> 32 ) ;
+swar_wide w[ 4 ] = { 0, 0, 0, 0 } ;
+swar_wide c ;
+int       k, q, shift, num_added = 0 ;
+
+for (k = 0 ;  k <= F->n - 1 ;  ++k)
+{
+    if ((c = (b >> (4 * k)) & 15) == 0)
+        continue ;
+
+    q     = k >> 3 ;
+    shift = 8 * (k & 7) ;
+
+    if (shift == 0)
+    {
+        w[ q ]     += c * A0 ;
+        w[ q + 1 ] += c * A1 ;
+    }
+    else
+    {
+        w[ q ]     += c * (A0 << shift) ;
+        w[ q + 1 ] += c * ((A1 << shift) | (A0 >> (64 - shift))) ;
+        w[ q + 2 ] += c * (A1 >> (64 - shift)) ;
+    }
+
+    if (++num_added == F->fold_every)
+    {
+        swar_wide_mod( F, w, 4 ) ;
+        num_added = 0 ;
+    }
+}
+
+swar_wide_mod( F, w, 4 ) ;
+
+return swar_reduce( F, w ) ;
+
+} /* ==================== end of function swar_product ====================== */
+
+
+static swar_poly swar_square( SwarField * F, swar_poly a )
+{
+swar_wide A0, A1 ;
+swar_wide w[ 4 ] ;
+
+if (F->p != 2)
+    return swar_product( F, a, a ) ;
+
+A0 = swar_spread( a ) ;
+A1 = swar_spread( a >> 32 ) ;
+
+w[ 0 ] = swar_spread( A0 ) ;
+w[ 1 ] = swar_spread( A0 >> 32 ) ;
+w[ 2 ] = swar_spread( A1 ) ;
+w[ 3 ] = swar_spread( A1 >> 32 ) ;
+
+return swar_reduce( F, w ) ;
+
+} /* ===================== end of function swar_square ====================== */
+
+
+
+/*==============================================================================
+|                                swar_reduce                                   |
+================================================================================
+
+DESCRIPTION
+
+     Reduce a wide product modulo f(x), and pack it back into a word.
+
+INPUT
+
+     w (swar_wide *)    Four wide words, coefficients of x ^ 0 ... x ^ 2n-2,
+                        each less than p.  Overwritten.
+
+RETURNS
+
+     w(x) (mod f(x), p).
+
+METHOD
+
+     Add each coefficient c of x ^ k, k >= n, times row k-n of the power
+     table to the low n coefficients, reducing modulo p as in
+     swar_product.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static swar_poly swar_reduce( SwarField * F, swar_wide * w )
+{
+swar_wide low[ 2 ] ;
+swar_wide c ;
+int       k, num_added = 0 ;
+
+low[ 0 ] = w[ 0 ] & F->low_mask[ 0 ] ;
+low[ 1 ] = w[ 1 ] & F->low_mask[ 1 ] ;
+
+for (k = F->n ;  k <= 2 * F->n - 2 ;  ++k)
+{
+    if ((c = (w[ k >> 3 ] >> (8 * (k & 7))) & 255) == 0)
+        continue ;
+
+    low[ 0 ] += c * F->row[ k - F->n ][ 0 ] ;
+    low[ 1 ] += c * F->row[ k - F->n ][ 1 ] ;
+
+    if (++num_added == F->fold_every)
+    {
+        swar_wide_mod( F, low, 2 ) ;
+        num_added = 0 ;
+    }
+}
+
+swar_wide_mod( F, low, 2 ) ;
+
+return (swar_poly) swar_compress( low[ 0 ] ) |
+       (swar_poly) swar_compress( low[ 1 ] ) << 32 ;
+
+} /* ==================== end of function swar_reduce ======================= */
+
+
+
+/*==============================================================================
+|                               swar_wide_mod                                  |
+================================================================================
+
+DESCRIPTION
+
+     Reduce every wide coefficient modulo p.
+
+INPUT
+
+     w (swar_wide *)    Words of wide coefficients.
+     num_words (int)
+
+OUTPUT
+
+     w (swar_wide *)    Every coefficient less than p.
+
+METHOD
+
+     For p = 2, keep the low bit.
+
+     For odd p, 2 ^ e = 1 (mod p) for e = 2, 4, 3 when p = 3, 5, 7.  So
+     writing v in base 2 ^ e and adding its digits doesn't change v
+     (mod p), and shrinks it quickly:  for p = 7, 255 becomes at most 38,
+     then 11.  Then for j from top_shift down to 0, let q = p 2 ^ j, and
+     v < 2 q.  Adding 128 - q to v sets its top bit exactly when v >= q,
+     so subtract q from those.  That leaves v < q, and at the end, v < p.
+     For p = 7 that's 2 digit sums and one subtraction for every
+     coefficient at once, where subtracting alone would take 6.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static void swar_wide_mod( SwarField * F, swar_wide * w, int num_words )
+{
+swar_wide q, bias, big, digit, high ;
+int       i, j ;
+
+if (F->digit_bits == 0)
+{
+    for (i = 0 ;  i < num_words ;  ++i)
+        w[ i ] &= SWARBYTES ;
+
+    return ;
+}
+
+digit = (swar_wide) ((1 << F->digit_bits) - 1) * SWARBYTES ;
+high  = (swar_wide) (255 >> F->digit_bits) * SWARBYTES ;
+
+for (j = 0 ;  j < F->num_digit_sums ;  ++j)
+    for (i = 0 ;  i < num_words ;  ++i)
+        w[ i ] = ((w[ i ] >> F->digit_bits) & high) + (w[ i ] & digit) ;
+
+for (j = F->top_shift ;  j >= 0 ;  --j)
+{
+    q    = (swar_wide) (F->p << j) ;
+    bias = (128 - q) * SWARBYTES ;
+
+    for (i = 0 ;  i < num_words ;  ++i)
+    {
+        big     = ((w[ i ] + bias) >> 7) & SWARBYTES ;
+        w[ i ] -= big * q ;
+    }
+}
+
+} /* =================== end of function swar_wide_mod ====================== */
+
+
+
+/*==============================================================================
+|                          swar_spread, swar_compress                          |
+================================================================================
+
+DESCRIPTION
+
+     Spread the low 8 coefficients of a word from 4 bits to 8, and squeeze
+     them back.
+
+EXAMPLE
+
+     swar_spread( 0x4321 ) = 0x04030201.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static swar_wide swar_spread( unsigned long long a )
+{
+swar_wide w = a & 0xFFFFFFFFULL ;
+
+w = (w | (w << 16)) & 0x0000FFFF0000FFFFULL ;
+w = (w | (w << 8))  & 0x00FF00FF00FF00FFULL ;
+w = (w | (w << 4))  & 0x0F0F0F0F0F0F0F0FULL ;
+
+return w ;
+
+} /* ==================== end of function swar_spread ======================= */
+
+
+static unsigned long long swar_compress( swar_wide w )
+{
+w &= 0x0F0F0F0F0F0F0F0FULL ;
+w  = (w | (w >> 4))  & 0x00FF00FF00FF00FFULL ;
+w  = (w | (w >> 8))  & 0x0000FFFF0000FFFFULL ;
+w  = (w | (w >> 16)) & 0x00000000FFFFFFFFULL ;
+
+return w ;
+
+} /* =================== end of function swar_compress ====================== */
+
+
+
+/*==============================================================================
+|                               swar_is_integer                                |
+================================================================================
+
+DESCRIPTION
+
+     Is a(x) a constant?
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static int swar_is_integer( swar_poly a )
+{
+return (a >> 4) == 0 ;
+
+} /* =================== end of function swar_is_integer ===================== */
@@ -0,0 +1,480 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppTiming.c
+|
+|  Description:
+|
+|     Time each stage of the primitivity tests, and print where the time
+|     went.
+|
+|  Functions:
+|
+|     set_stage_timing
+|     stage_timing_enabled
+|     stage_timing_name
+|     stage_clock
+|     stage_start
+|     record_stage
+|     print_stage_timing
+|     histogram_percentile
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <time.h>
+
+#include "Primpoly.h"
+
+
+/*  YES to time the stages.  Set once before the search starts, and only
+    read afterwards, so the search threads can share it. */
+static int stage_timing = NO ;
+
+/*  Names of the stages, indexed by POWERTABLESTAGE ... ORDERMSTAGE. */
+static const char * stage_name[ NUMSTAGES ] =
+{
+    "power table",
+    "const coeff",
+    "linear factor",
+    "berlekamp",
+    "order r",
+    "const test",
+    "order m"
+} ;
+
+static bigint histogram_percentile( const bigint * histogram, bigint calls, int percent ) ;
+
+
+/*==============================================================================
+|                   set_stage_timing, stage_timing_enabled                     |
+================================================================================
+
+DESCRIPTION
+
+     Turn timing of the stages on or off, and ask whether it is on.
+     Timing is off unless --timing was given, so the search pays nothing
+     for it but one test per trial polynomial.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void set_stage_timing( int on )
+{
+stage_timing = on ;
+
+} /* ================== end of function set_stage_timing ==================== */
+
+
+int stage_timing_enabled( void )
+{
+return stage_timing ;
+
+} /* ================ end of function stage_timing_enabled ================== */
+
+
+
+/*==============================================================================
+|                              stage_timing_name                               |
+================================================================================
+
+DESCRIPTION
+
+     Name of a stage, as it's printed in the timing report.
+
+INPUT
+
+     stage (int)        POWERTABLESTAGE ... ORDERMSTAGE
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+const char * stage_timing_name( int stage )
+{
+return stage_name[ stage ] ;
+
+} /* ================= end of function stage_timing_name ==================== */
+
+
+
+/*==============================================================================
+|                                 stage_clock                                  |
+================================================================================
+
+DESCRIPTION
+
+     Read the time in nanoseconds from some fixed point.
+
+METHOD
+
+     The monotonic clock is read from user space on Linux in a few tens of
+     nanoseconds, much less than any stage but the cheapest take, and
+     unlike the cycle counter it's the same on every processor and
+     doesn't change with the clock rate.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint stage_clock( void )
+{
+struct timespec now ;
+
+clock_gettime( CLOCK_MONOTONIC, &now ) ;
+
+return (bigint) now.tv_sec * 1000000000ULL + (bigint) now.tv_nsec ;
+
+} /* ===================== end of function stage_clock ====================== */
+
+
+
+/*==============================================================================
+|                                stage_start                                   |
+================================================================================
+
+DESCRIPTION
+
+     Mark the start of the first stage for record_stage.
+
+RETURNS
+
+     stage_clock() now.
+
+METHOD
+
+     With --counters, also read the hardware counters, so the first stage
+     gets only what it counted itself.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint stage_start( void )
+{
+bigint delta[ NUMHWCOUNTERS ] ;
+
+if (hardware_counters_enabled())
+    counter_deltas( delta ) ;
+
+return stage_clock() ;
+
+} /* ==================== end of function stage_start ======================= */
+
+
+
+/*==============================================================================
+|                                record_stage                                  |
+================================================================================
+
+DESCRIPTION
+
+     Add the time since start to a stage's totals and histogram.
+
+INPUT
+
+     stats (SearchStatistics *)  The statistics of the thread doing the
+                                 search.
+     stage (int)                 Which stage, e.g. ORDERRSTAGE.
+     start (bigint)              stage_start() or the last record_stage()
+                                 when the stage began.
+
+OUTPUT
+
+     stats                       stage_calls, stage_nanosec and
+                                 stage_histogram updated, and with
+                                 --counters, stage_counters.
+
+RETURNS
+
+     stage_clock() now, which is when the next stage begins.
+
+EXAMPLE
+
+     start = stage_start() ;
+     construct_power_table( power_table, f, n, p ) ;
+     start = record_stage( stats, POWERTABLESTAGE, start ) ;
+
+METHOD
+
+     Bucket k of the histogram counts times t with 2^k <= t < 2^(k+1)
+     nanoseconds;  bucket 0 also holds t = 0 and the last bucket
+     everything longer.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint record_stage( SearchStatistics * stats, int stage, bigint start )
+{
+bigint delta[ NUMHWCOUNTERS ] ;
+bigint now     = stage_clock() ;
+bigint elapsed = now - start ;
+int    bucket  = 0, k ;
+
+if (hardware_counters_enabled() && counter_deltas( delta ))
+    for (k = 0 ;  k < NUMHWCOUNTERS ;  ++k)
+        stats->stage_counters[ stage ][ k ] += delta[ k ] ;
+
+while (bucket < NUMTIMEBUCKETS - 1 && (elapsed >> (bucket + 1)) != 0)
+    ++bucket ;
+
+++stats->stage_calls[ stage ] ;
+stats->stage_nanosec[ stage ] += elapsed ;
+++stats->stage_histogram[ stage ][ bucket ] ;
+
+return now ;
+
+} /* ==================== end of function record_stage ====================== */
+
+
+
+/*==============================================================================
+|                             print_stage_timing                               |
+================================================================================
+
+DESCRIPTION
+
+     Print the counts and times of each stage.
+
+INPUT
+
+     stats (SearchStatistics *)  Totals over all threads.
+     p (int), n (int)            What we were searching.
+     format (int)                TEXTTIMING or JSONTIMING.
+
+OUTPUT
+
+     Standard output             For TEXTTIMING, a table in the style of
+                                 -s;  for JSONTIMING, one JSON object on
+                                 one line, with the whole histogram of
+                                 each stage.
+
+EXAMPLE
+
+     pp --timing text 2 20 prints something like
+
+     +--------- Timing ---------------------------------------------------------------------
+     |
+     | Stage                Calls    Total ms     Mean ns      p50 ns      p99 ns   Share
+     | power table          15237        8.55         561         512        2048    41.2%
+     ...
+
+     and with --counters, a second table of cycles, instructions,
+     instructions per cycle and misses per call of each stage.
+
+     pp --timing json 2 20
+
+     {"p":2,"n":20,"num_poly":15237,"stages":[{"name":"power table",
+      "passed":15237,"calls":15237,"nanoseconds":8551234,"histogram":[0,...]},...]}
+
+     prints one line, each stage having "counters":{"cycles":...} too
+     with --counters.
+
+METHOD
+
+     The percentiles come from the histograms, so they are only good to a
+     factor of two:  we print the top of the bucket the percentile lies in.
+
+BUGS
+
+     None.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void print_stage_timing( SearchStatistics * stats, int p, int n, int format )
+{
+bigint total_nanosec = 0 ;
+bigint passed[ NUMSTAGES ] ;
+int    stage, bucket, k, first ;
+
+/*  Column widths of the counters in the table. */
+static const int width[ NUMHWCOUNTERS ] = { 12, 12, 15, 15, 14 } ;
+
+/*  How many passed each stage, the counts of -s.  The power table is
+    only built for polynomials which get that far. */
+passed[ POWERTABLESTAGE ] = stats->stage_calls[ POWERTABLESTAGE ] ;
+passed[ CONSTCOEFFSTAGE ] = stats->num_const_coeff_prim_root ;
+passed[ LINEARSTAGE     ] = stats->num_free_of_linear_factors ;
+passed[ BERLEKAMPSTAGE  ] = stats->num_irred_to_power ;
+passed[ ORDERRSTAGE     ] = stats->num_order_r ;
+passed[ CONSTTESTSTAGE  ] = stats->num_passing_const_coeff_test ;
+passed[ ORDERMSTAGE     ] = stats->num_order_m ;
+
+for (stage = 0 ;  stage < NUMSTAGES ;  ++stage)
+    total_nanosec += stats->stage_nanosec[ stage ] ;
+
+if (format == JSONTIMING)
+{
+    printf( "{\"p\":%d,\"n\":%d,\"num_poly\":%s,\"nanoseconds\":%s,\"stages\":[",
+            p, n, bigint_string( stats->num_poly ), bigint_string( total_nanosec ) ) ;
+
+    for (stage = 0 ;  stage < NUMSTAGES ;  ++stage)
+    {
+        printf( "%s{\"name\":\"%s\",\"passed\":%s,\"calls\":%s,\"nanoseconds\":%s,\"histogram\":[",
+                (stage > 0) ? "," : "", stage_name[ stage ], bigint_string( passed[ stage ] ),
+                bigint_string( stats->stage_calls[ stage ] ), bigint_string( stats->stage_nanosec[ stage ] ) ) ;
+
+        for (bucket = 0 ;  bucket < NUMTIMEBUCKETS ;  ++bucket)
+            printf( "%s%s", (bucket > 0) ? "," : "", bigint_string( stats->stage_histogram[ stage ][ bucket ] ) ) ;
+
+        printf( "]" ) ;
+
+        /*  Totals of the counters we have. */
+        if (hardware_counters_enabled())
+        {
+            printf( ",\"counters\":{" ) ;
+
+            for (k = 0, first = YES ;  k < NUMHWCOUNTERS ;  ++k)
+            {
+                if (!hardware_counter_available( k ))
+                    continue ;
+
+                printf( "%s\"%s\":%s", first ? "" : ",", hardware_counter_name( k ),
+                        bigint_string( stats->stage_counters[ stage ][ k ] ) ) ;
+                first = NO ;
+            }
+
+            printf( "}" ) ;
+        }
+
+        printf( "}" ) ;
+    }
+
+    printf( "]}\n" ) ;
+    return ;
+}
+
+printf( "+--------- Timing ---------------------------------------------------------------------\n" ) ;
+printf( "|\n" ) ;
+printf( "| Stage                Calls    Total ms     Mean ns      p50 ns      p99 ns   Share\n" ) ;
+
+for (stage = 0 ;  stage < NUMSTAGES ;  ++stage)
+{
+    bigint calls = stats->stage_calls[ stage ] ;
+
+    printf( "| %-13s %12s %11.2f %11s %11s %11s  %5.1f%%\n",
+            stage_name[ stage ], bigint_string( calls ),
+            (double) stats->stage_nanosec[ stage ] / 1.0e6,
+            bigint_string( (calls == 0) ? 0 : stats->stage_nanosec[ stage ] / calls ),
+            bigint_string( histogram_percentile( stats->stage_histogram[ stage ], calls, 50 ) ),
+            bigint_string( histogram_percentile( stats->stage_histogram[ stage ], calls, 99 ) ),
+            (total_nanosec == 0) ? 0.0 :
+                100.0 * (double) stats->stage_nanosec[ stage ] / (double) total_nanosec ) ;
+}
+
+printf( "|\n" ) ;
+printf( "| Total %20s %11.2f ms\n", "", (double) total_nanosec / 1.0e6 ) ;
+printf( "|\n" ) ;
+
+/*  Hardware counters per call, and instructions per cycle. */
+if (hardware_counters_enabled())
+{
+    printf( "| Stage         Cycles/call  Instr/call    IPC  L1D miss/call  LLC miss/call  Br miss/call\n" ) ;
+
+    for (stage = 0 ;  stage < NUMSTAGES ;  ++stage)
+    {
+        bigint * counts = stats->stage_counters[ stage ] ;
+        double   calls  = (stats->stage_calls[ stage ] == 0) ? 1.0 : (double) stats->stage_calls[ stage ] ;
+
+        printf( "| %-13s", stage_name[ stage ] ) ;
+
+        for (k = 0 ;  k < NUMHWCOUNTERS ;  ++k)
+        {
+            if (!hardware_counter_available( k ))
+                printf( "%*s", width[ k ], "-" ) ;
+            else
+                printf( "%*.1f", width[ k ], (double) counts[ k ] / calls ) ;
+
+            /*  Instructions per cycle after the instructions. */
+            if (k == INSTRUCTIONSCOUNTER)
+            {
+                if (hardware_counter_available( CYCLESCOUNTER ) &&
+                    hardware_counter_available( INSTRUCTIONSCOUNTER ) && counts[ CYCLESCOUNTER ] > 0)
+                    printf( " %6.2f", (double) counts[ INSTRUCTIONSCOUNTER ] / (double) counts[ CYCLESCOUNTER ] ) ;
+                else
+                    printf( " %6s", "-" ) ;
+            }
+        }
+
+        printf( "\n" ) ;
+    }
+
+    printf( "|\n" ) ;
+}
+printf( "+--------------------------------------------------------------------------------------\n" ) ;
+
+} /* ================= end of function print_stage_timing =================== */
+
+
+
+/*==============================================================================
+|                            histogram_percentile                              |
+================================================================================
+
+DESCRIPTION
+
+     Estimate a percentile of the times in a histogram from record_stage.
+
+RETURNS
+
+     The top of the bucket the percentile falls in, in nanoseconds, or 0 if
+     the histogram is empty.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+static bigint histogram_percentile( const bigint * histogram, bigint calls, int percent )
+{
+bigint wanted = (calls * (bigint) percent + 99) / 100 ;
+bigint seen   = 0 ;
+int    bucket ;
+
+if (calls == 0)
+    return 0 ;
+
+for (bucket = 0 ;  bucket < NUMTIMEBUCKETS - 1 ;  ++bucket)
+{
+    seen += histogram[ bucket ] ;
+
+    if (seen >= wanted)
+        break ;
+}
+
+return (bigint) 1 << (bucket + 1) ;
+
+} /* ================ end of function histogram_percentile ================== */
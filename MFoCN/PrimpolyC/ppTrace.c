@@ -0,0 +1,290 @@
+/*==============================================================================
+|
+|  File Name:
+|
+|     ppTrace.c
+|
+|  Description:
+|
+|     Record what the search is doing, and when, into a ring buffer in
+|     memory, and write it out as a Chrome trace to look at in
+|     chrome://tracing or Perfetto.
+|
+|  Functions:
+|
+|     set_trace
+|     trace_sample_poly
+|     trace_begin
+|     trace_end
+|     write_trace
+|
+|  LEGAL
+|
+|     Primpoly Version 16.3 - A Program for Computing Primitive Polynomials.
+|     Copyright (C) 1999-2024 by Sean Erik O'Connor.  All Rights Reserved.
+|
+|     This program is free software: you can redistribute it and/or modify
+|     it under the terms of the GNU General Public License as published by
+|     the Free Software Foundation, either version 3 of the License, or
+|     (at your option) any later version.
+|
+|     This program is distributed in the hope that it will be useful,
+|     but WITHOUT ANY WARRANTY; without even the implied warranty of
+|     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+|     GNU General Public License for more details.
+|
+|     You should have received a copy of the GNU General Public License
+|     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+|
+|     The author's address is seanerikoconnor!AT!gmail!DOT!com
+|     with !DOT! replaced by . and the !AT! replaced by @
+|
+|  USE
+|
+|     The trace points are the TRACE_ macros in Primpoly.h, which are empty
+|     unless we compile with -DPP_TRACE, so a normal build pays nothing.
+|     In a traced build, nothing is recorded until --trace FILE turns it
+|     on, and then only every Nth trial polynomial with --trace-sample N,
+|     so a long search can be traced without changing its timing much.
+|     When the buffer fills, the oldest events are overwritten.
+|
+|         cc -DPP_TRACE -O2 -o pp *.c -lm -pthread
+|         pp --trace pp.json --trace-sample 100 2 40
+|
+==============================================================================*/
+
+/*------------------------------------------------------------------------------
+|                                Include Files                                 |
+------------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#include "Primpoly.h"
+
+
+/*------------------------------------------------------------------------------
+|                                 Data Types                                   |
+------------------------------------------------------------------------------*/
+
+/*  Something which took a while, a "complete" event in a Chrome trace. */
+typedef struct
+{
+    const char * name ;       /* A string constant.                */
+    bigint       start ;      /* stage_clock() when it began ...   */
+    bigint       duration ;   /* ... and how long it took, in ns.  */
+    int          thread ;     /* Which thread, counting from 1.    */
+} TraceEvent ;
+
+
+/*  Set up by set_trace() before the search, then only read. */
+static TraceEvent * trace_buffer = (TraceEvent *) 0 ;
+static bigint       trace_rate   = 1 ;    /* Trace 1 in this many polys.  */
+static bigint       trace_origin = 0 ;    /* Time zero of the trace.      */
+
+/*  Events ever recorded;  event k goes in slot k % TRACEBUFFERSIZE. */
+static atomic_ullong trace_count       = 0 ;
+static atomic_int    trace_num_threads = 0 ;
+
+/*  For each thread:  its number, polynomials seen, and whether we are
+    tracing the current one.  Everything outside the tests of a trial
+    polynomial is always traced. */
+static _Thread_local int    trace_thread  = 0 ;
+static _Thread_local bigint trace_polys   = 0 ;
+static _Thread_local int    trace_sampled = YES ;
+
+
+/*==============================================================================
+|                                  set_trace                                   |
+================================================================================
+
+DESCRIPTION
+
+     Start tracing.
+
+INPUT
+
+     sample_rate (bigint)    Trace every this many trial polynomials, 1 for
+                             all of them.
+
+RETURNS
+
+     YES if we could get the memory for the buffer.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int set_trace( bigint sample_rate )
+{
+trace_buffer = (TraceEvent *) calloc( TRACEBUFFERSIZE, sizeof( TraceEvent ) ) ;
+trace_rate   = (sample_rate < 1) ? 1 : sample_rate ;
+trace_origin = stage_clock() ;
+
+return trace_buffer != (TraceEvent *) 0 ;
+
+} /* ===================== end of function set_trace ======================== */
+
+
+
+/*==============================================================================
+|                              trace_sample_poly                               |
+================================================================================
+
+DESCRIPTION
+
+     Called for each trial polynomial:  decide whether to trace its tests.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+void trace_sample_poly( void )
+{
+trace_sampled = (trace_polys++ % trace_rate == 0) ;
+
+} /* ================= end of function trace_sample_poly ==================== */
+
+
+
+/*==============================================================================
+|                            trace_begin, trace_end                            |
+================================================================================
+
+DESCRIPTION
+
+     Mark the beginning and end of an event, by way of the TRACE_BEGIN and
+     TRACE_END macros.
+
+INPUT
+
+     name (const char *)     What happened.  Must be a string constant,
+                             since we keep only the pointer.
+     start (bigint)          From trace_begin.
+
+RETURNS
+
+     trace_begin:  the time now, or 0 if we aren't tracing this.
+
+EXAMPLE
+
+     TRACE_DECLARE( trace_start ) ;
+
+     TRACE_BEGIN( trace_start ) ;
+     factor( r, primes, count ) ;
+     TRACE_END( "factor r", trace_start ) ;
+
+METHOD
+
+     Threads claim slots of the ring buffer with an atomic counter, so
+     they don't need a lock.
+
+BUGS
+
+     Once the buffer has wrapped around, a thread which is very slow to
+     fill its slot might have it overwritten by another which has gone
+     all the way around, giving a garbled event.  That takes
+     TRACEBUFFERSIZE events in between, which doesn't happen in practice.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+bigint trace_begin( void )
+{
+if (trace_buffer == (TraceEvent *) 0 || !trace_sampled)
+    return 0 ;
+
+return stage_clock() ;
+
+} /* ==================== end of function trace_begin ======================= */
+
+
+void trace_end( const char * name, bigint start )
+{
+TraceEvent * event ;
+bigint       now ;
+
+if (start == 0)
+    return ;
+
+now = stage_clock() ;
+
+if (trace_thread == 0)
+    trace_thread = atomic_fetch_add( &trace_num_threads, 1 ) + 1 ;
+
+event = &trace_buffer[ atomic_fetch_add( &trace_count, 1 ) % TRACEBUFFERSIZE ] ;
+
+event->name     = name ;
+event->start    = start ;
+event->duration = now - start ;
+event->thread   = trace_thread ;
+
+} /* ===================== end of function trace_end ======================== */
+
+
+
+/*==============================================================================
+|                                 write_trace                                  |
+================================================================================
+
+DESCRIPTION
+
+     Write the events in the buffer to a file in the Chrome trace event
+     format.
+
+INPUT
+
+     file_name (char *)      Where to write it.
+
+RETURNS
+
+     YES if it was written, NO if not.
+
+EXAMPLE
+
+     {"displayTimeUnit":"ns","traceEvents":[
+     {"name":"factor r","ph":"X","ts":12.345,"dur":3.210,"pid":1,"tid":1},
+     ...
+     ]}
+
+METHOD
+
+     Times are in microseconds from the call to set_trace.  If the buffer
+     wrapped around, we start from the oldest event left.  Call this after
+     all the search threads have finished.
+
+--------------------------------------------------------------------------------
+|                                Function Call                                 |
+------------------------------------------------------------------------------*/
+
+int write_trace( char * file_name )
+{
+FILE       * fp ;
+TraceEvent * event ;
+bigint       count = atomic_load( &trace_count ), first = 0, k ;
+
+if (trace_buffer == (TraceEvent *) 0 || (fp = fopen( file_name, "w" )) == (FILE *) 0)
+    return NO ;
+
+if (count > TRACEBUFFERSIZE)
+    first = count - TRACEBUFFERSIZE ;
+
+fprintf( fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" ) ;
+
+for (k = first ;  k < count ;  ++k)
+{
+    event = &trace_buffer[ k % TRACEBUFFERSIZE ] ;
+
+    fprintf( fp, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}%s\n",
+             event->name, (double) (event->start - trace_origin) / 1.0e3,
+             (double) event->duration / 1.0e3, event->thread,
+             (k + 1 < count) ? "," : "" ) ;
+}
+
+fprintf( fp, "]}\n" ) ;
+
+return fclose( fp ) == 0 ;
+
+} /* ===================== end of function write_trace ====================== */